@@ -1,6 +1,10 @@
 /** @file
   AES Wrapper Implementation over OpenSSL.
 
+  CBC operations go through the OpenSSL EVP interface rather than the low-level
+  AES_cbc_encrypt() so that OpenSSL can select the AES-NI implementation at runtime
+  when the library is built with OpensslLibAccel.
+
 Copyright (c) 2010 - 2018, Intel Corporation. All rights reserved.<BR>
 SPDX-License-Identifier: BSD-2-Clause-Patent
 
@@ -8,6 +12,96 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 
 #include "InternalCryptLib.h"
 #include <openssl/aes.h>
+#include <openssl/evp.h>
+
+///
+/// AES context. The raw key is kept so that the key schedule can be expanded
+/// by whichever EVP implementation (generic or AES-NI) OpenSSL selects.
+///
+typedef struct {
+  UINT32    KeyLength;
+  UINT8     Key[32];
+} AES_CONTEXT;
+
+/**
+  Performs AES encryption or decryption in CBC mode through the EVP interface.
+
+  @param[in]   AesContext  Pointer to the AES context.
+  @param[in]   Input       Pointer to the buffer containing the data to be processed.
+  @param[in]   InputSize   Size of the Input buffer in bytes.
+  @param[in]   Ivec        Pointer to initialization vector.
+  @param[out]  Output      Pointer to a buffer that receives the output.
+  @param[in]   Encrypt     TRUE to encrypt, FALSE to decrypt.
+
+  @retval TRUE   AES operation succeeded.
+  @retval FALSE  AES operation failed.
+
+**/
+STATIC
+BOOLEAN
+AesCbcCipher (
+  IN   AES_CONTEXT  *AesContext,
+  IN   CONST UINT8  *Input,
+  IN   UINTN        InputSize,
+  IN   CONST UINT8  *Ivec,
+  OUT  UINT8        *Output,
+  IN   BOOLEAN      Encrypt
+  )
+{
+  EVP_CIPHER_CTX    *Ctx;
+  CONST EVP_CIPHER  *Cipher;
+  INT32             OutSize;
+  INT32             FinalSize;
+  BOOLEAN           RetValue;
+
+  switch (AesContext->KeyLength) {
+    case 128:
+      Cipher = EVP_aes_128_cbc ();
+      break;
+    case 192:
+      Cipher = EVP_aes_192_cbc ();
+      break;
+    case 256:
+      Cipher = EVP_aes_256_cbc ();
+      break;
+    default:
+      return FALSE;
+  }
+
+  Ctx = EVP_CIPHER_CTX_new ();
+  if (Ctx == NULL) {
+    return FALSE;
+  }
+
+  RetValue = (BOOLEAN)EVP_CipherInit_ex (Ctx, Cipher, NULL, AesContext->Key, Ivec, Encrypt ? 1 : 0);
+  if (!RetValue) {
+    goto Done;
+  }
+
+  //
+  // The caller is responsible for padding.
+  //
+  RetValue = (BOOLEAN)EVP_CIPHER_CTX_set_padding (Ctx, 0);
+  if (!RetValue) {
+    goto Done;
+  }
+
+  RetValue = (BOOLEAN)EVP_CipherUpdate (Ctx, Output, &OutSize, Input, (INT32)InputSize);
+  if (!RetValue) {
+    goto Done;
+  }
+
+  RetValue = (BOOLEAN)EVP_CipherFinal_ex (Ctx, Output + OutSize, &FinalSize);
+  if (!RetValue) {
+    goto Done;
+  }
+
+  RetValue = (BOOLEAN)((UINTN)(OutSize + FinalSize) == InputSize);
+
+Done:
+  EVP_CIPHER_CTX_free (Ctx);
+  return RetValue;
+}
 
 /**
   Retrieves the size, in bytes, of the context buffer required for AES operations.
@@ -21,11 +115,7 @@ AesGetContextSize (
   VOID
   )
 {
-  //
-  // AES uses different key contexts for encryption and decryption, so here memory
-  // for 2 copies of AES_KEY is allocated.
-  //
-  return (UINTN)(2 * sizeof (AES_KEY));
+  return (UINTN)(sizeof (AES_CONTEXT));
 }
 
 /**
@@ -56,7 +146,7 @@ AesInit (
   IN   UINTN        KeyLength
   )
 {
-  AES_KEY  *AesKey;
+  AES_CONTEXT  *Context;
 
   //
   // Check input parameters.
@@ -66,16 +156,12 @@ AesInit (
   }
 
   //
-  // Initialize AES encryption & decryption key schedule.
+  // Save the key; the key schedule is expanded by the EVP implementation.
   //
-  AesKey = (AES_KEY *)AesContext;
-  if (AES_set_encrypt_key (Key, (UINT32)KeyLength, AesKey) != 0) {
-    return FALSE;
-  }
-
-  if (AES_set_decrypt_key (Key, (UINT32)KeyLength, AesKey + 1) != 0) {
-    return FALSE;
-  }
+  Context = (AES_CONTEXT *)AesContext;
+  ZeroMem (Context, sizeof (AES_CONTEXT));
+  Context->KeyLength = (UINT32)KeyLength;
+  CopyMem (Context->Key, Key, KeyLength / 8);
 
   return TRUE;
 }
@@ -117,9 +203,6 @@ AesCbcEncrypt (
   OUT  UINT8        *Output
   )
 {
-  AES_KEY  *AesKey;
-  UINT8    IvecBuffer[AES_BLOCK_SIZE];
-
   //
   // Check input parameters.
   //
@@ -131,15 +214,10 @@ AesCbcEncrypt (
     return FALSE;
   }
 
-  AesKey = (AES_KEY *)AesContext;
-  CopyMem (IvecBuffer, Ivec, AES_BLOCK_SIZE);
-
   //
   // Perform AES data encryption with CBC mode
   //
-  AES_cbc_encrypt (Input, Output, (UINT32)InputSize, AesKey, IvecBuffer, AES_ENCRYPT);
-
-  return TRUE;
+  return AesCbcCipher ((AES_CONTEXT *)AesContext, Input, InputSize, Ivec, Output, TRUE);
 }
 
 /**
@@ -179,9 +257,6 @@ AesCbcDecrypt (
   OUT  UINT8        *Output
   )
 {
-  AES_KEY  *AesKey;
-  UINT8    IvecBuffer[AES_BLOCK_SIZE];
-
   //
   // Check input parameters.
   //
@@ -193,13 +268,8 @@ AesCbcDecrypt (
     return FALSE;
   }
 
-  AesKey = (AES_KEY *)AesContext;
-  CopyMem (IvecBuffer, Ivec, AES_BLOCK_SIZE);
-
   //
   // Perform AES data decryption with CBC mode
   //
-  AES_cbc_encrypt (Input, Output, (UINT32)InputSize, AesKey + 1, IvecBuffer, AES_DECRYPT);
-
-  return TRUE;
+  return AesCbcCipher ((AES_CONTEXT *)AesContext, Input, InputSize, Ivec, Output, FALSE);
 }
@@ -37,6 +37,93 @@ STATIC CONST TLS_ALGO_TO_NAME  TlsSignatureAlgoToName[] = {
   { TlsSignatureAlgoEcdsa,     "ECDSA" },
 };
 
+//
+// Resumable client sessions, looked up by session ID when a session ID is
+// set on a new connection. The oldest entry is replaced when it is full.
+//
+#define TLS_SESSION_CACHE_SIZE  8
+
+STATIC SSL_SESSION  *mTlsSessionCache[TLS_SESSION_CACHE_SIZE];
+STATIC UINTN        mTlsSessionCacheNext;
+
+/**
+  Find the cached session matching the session ID.
+
+  @param[in]  SessionId       Session ID to look up.
+  @param[in]  SessionIdLen    Length of Session ID in bytes.
+
+  @return  The index of the cached session, or TLS_SESSION_CACHE_SIZE if
+           none matches.
+
+**/
+STATIC
+UINTN
+TlsSessionCacheLookup (
+  IN CONST UINT8  *SessionId,
+  IN UINTN        SessionIdLen
+  )
+{
+  UINTN         Index;
+  CONST UINT8   *CachedId;
+  unsigned int  CachedIdLen;
+
+  for (Index = 0; Index < TLS_SESSION_CACHE_SIZE; Index++) {
+    if (mTlsSessionCache[Index] == NULL) {
+      continue;
+    }
+
+    CachedId = SSL_SESSION_get_id (mTlsSessionCache[Index], &CachedIdLen);
+    if ((CachedIdLen == SessionIdLen) && (CompareMem (CachedId, SessionId, SessionIdLen) == 0)) {
+      break;
+    }
+  }
+
+  return Index;
+}
+
+/**
+  Keep a resumable client session in the session cache.
+
+  @param[in]  Session         The session to keep.
+
+**/
+STATIC
+VOID
+TlsSessionCacheAdd (
+  IN SSL_SESSION  *Session
+  )
+{
+  UINTN         Index;
+  CONST UINT8   *SessionId;
+  unsigned int  SessionIdLen;
+
+  if (!SSL_SESSION_is_resumable (Session)) {
+    return;
+  }
+
+  SessionId = SSL_SESSION_get_id (Session, &SessionIdLen);
+  if (SessionIdLen == 0) {
+    return;
+  }
+
+  Index = TlsSessionCacheLookup (SessionId, SessionIdLen);
+  if (Index == TLS_SESSION_CACHE_SIZE) {
+    Index                = mTlsSessionCacheNext;
+    mTlsSessionCacheNext = (mTlsSessionCacheNext + 1) % TLS_SESSION_CACHE_SIZE;
+  }
+
+  if (mTlsSessionCache[Index] == Session) {
+    return;
+  }
+
+  if (mTlsSessionCache[Index] != NULL) {
+    SSL_SESSION_free (mTlsSessionCache[Index]);
+  }
+
+  SSL_SESSION_up_ref (Session);
+  mTlsSessionCache[Index] = Session;
+}
+
 /**
   Set a new TLS/SSL method for a particular TLS object.
 
@@ -558,6 +645,10 @@ TlsSetVerifyHost (
   This function sets a session ID to be used when the TLS/SSL connection is
   to be established.
 
+  If the TLS object is a client which has not started the handshake, and the
+  session ID was returned by TlsGetSessionId() for a resumable session, that
+  session is offered to the server for resumption.
+
   @param[in]  Tls             Pointer to the TLS object.
   @param[in]  SessionId       Session ID data used for session resumption.
   @param[in]  SessionIdLen    Length of Session ID in bytes.
@@ -565,6 +656,7 @@ TlsSetVerifyHost (
   @retval  EFI_SUCCESS           Session ID was set successfully.
   @retval  EFI_INVALID_PARAMETER The parameter is invalid.
   @retval  EFI_UNSUPPORTED       No available session for ID setting.
+  @retval  EFI_NOT_FOUND         No resumable session matches the ID.
 
 **/
 EFI_STATUS
@@ -577,6 +669,7 @@ TlsSetSessionId (
 {
   TLS_CONNECTION  *TlsConn;
   SSL_SESSION     *Session;
+  UINTN           Index;
 
   TlsConn = (TLS_CONNECTION *)Tls;
   Session = NULL;
@@ -585,6 +678,19 @@ TlsSetSessionId (
     return EFI_INVALID_PARAMETER;
   }
 
+  if (!SSL_is_server (TlsConn->Ssl) && (SSL_get_session (TlsConn->Ssl) == NULL)) {
+    Index = TlsSessionCacheLookup (SessionId, SessionIdLen);
+    if (Index == TLS_SESSION_CACHE_SIZE) {
+      return EFI_NOT_FOUND;
+    }
+
+    if (SSL_set_session (TlsConn->Ssl, mTlsSessionCache[Index]) != 1) {
+      return EFI_UNSUPPORTED;
+    }
+
+    return EFI_SUCCESS;
+  }
+
   Session = SSL_get_session (TlsConn->Ssl);
   if (Session == NULL) {
     return EFI_UNSUPPORTED;
@@ -1267,7 +1373,9 @@ TlsGetVerify (
   Gets the session ID used by the specified TLS connection.
 
   This function returns the TLS/SSL session ID currently used by the
-  specified TLS connection.
+  specified TLS connection. A resumable client session is also kept, so that
+  it can be resumed by setting its ID on a new connection with
+  TlsSetSessionId().
 
   @param[in]      Tls             Pointer to the TLS object.
   @param[in,out]  SessionId       Buffer to contain the returned session ID.
@@ -1289,6 +1397,7 @@ TlsGetSessionId (
   TLS_CONNECTION  *TlsConn;
   SSL_SESSION     *Session;
   CONST UINT8     *SslSessionId;
+  unsigned int    SslSessionIdLen;
 
   TlsConn = (TLS_CONNECTION *)Tls;
   Session = NULL;
@@ -1302,8 +1411,13 @@ TlsGetSessionId (
     return EFI_UNSUPPORTED;
   }
 
-  SslSessionId = SSL_SESSION_get_id (Session, (unsigned int *)SessionIdLen);
-  CopyMem (SessionId, SslSessionId, *SessionIdLen);
+  SslSessionId = SSL_SESSION_get_id (Session, &SslSessionIdLen);
+  CopyMem (SessionId, SslSessionId, SslSessionIdLen);
+  *SessionIdLen = (UINT16)SslSessionIdLen;
+
+  if (!SSL_is_server (TlsConn->Ssl)) {
+    TlsSessionCacheAdd (Session);
+  }
 
   return EFI_SUCCESS;
 }
@@ -591,6 +591,7 @@ DumpSmiHandler (
   UINTN                              Index;
   SMM_CORE_IMAGE_DATABASE_STRUCTURE  *ImageStruct;
   CHAR8                              *NameString;
+  UINTN                              Bucket;
 
   SmiStruct = (VOID *)mSmiHandlerProfileDatabase;
   while ((UINTN)SmiStruct < (UINTN)mSmiHandlerProfileDatabase + mSmiHandlerProfileDatabaseSize) {
@@ -629,6 +630,21 @@ DumpSmiHandler (
         }
 
         Print (L"      </Caller>\n", SmiHandlerStruct->Handler);
+        if ((SmiStruct->Header.Revision >= 0x0002) && (HandlerCategory != SmmCoreSmiHandlerCategoryHardwareHandler)) {
+          Print (L"      <Invocation Count=\"%ld\">\n", SmiHandlerStruct->InvokeCount);
+          for (Bucket = 0; Bucket < SMM_CORE_SMI_HANDLER_CYCLE_HISTOGRAM_SIZE; Bucket++) {
+            if (SmiHandlerStruct->CycleHistogram[Bucket] != 0) {
+              Print (
+                L"         <Cycles Min=\"0x%lx\">%ld</Cycles>\n",
+                (Bucket == 0) ? 0 : LShiftU64 (1, 2 * Bucket),
+                SmiHandlerStruct->CycleHistogram[Bucket]
+                );
+            }
+          }
+
+          Print (L"      </Invocation>\n");
+        }
+
         SmiHandlerStruct = (VOID *)((UINTN)SmiHandlerStruct + SmiHandlerStruct->Length);
         Print (L"    </SmiHandler>\n");
       }
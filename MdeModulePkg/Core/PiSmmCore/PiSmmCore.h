@@ -81,6 +81,7 @@ typedef struct {
 
   EFI_GUID      HandlerType; // Type of interrupt
   LIST_ENTRY    SmiHandlers; // All handlers
+  LIST_ENTRY    HashLink;    // Link on the hash table bucket of HandlerType
 } SMI_ENTRY;
 
 #define SMI_HANDLER_SIGNATURE  SIGNATURE_32('s','m','i','h')
@@ -94,6 +95,9 @@ typedef struct {
   VOID                            *Context;    // for profile
   UINTN                           ContextSize; // for profile
   BOOLEAN                         ToRemove;    // To remove this SMI_HANDLER later
+  UINT64                          InvokeCount;                                               // for profile
+  UINT64                          CycleHistogram[SMM_CORE_SMI_HANDLER_CYCLE_HISTOGRAM_SIZE]; // for profile
+  SMM_CORE_SMI_HANDLER_STRUCTURE  *ProfileRecord;                                            // for profile
 } SMI_HANDLER;
 
 //
@@ -1150,6 +1154,29 @@ SmmCoreInitializeSmiHandlerProfile (
   VOID
   );
 
+/**
+  Record one invocation of an SMI handler in its profile counters.
+
+  @param SmiHandler  The SMI handler that was invoked.
+  @param Cycles      The TSC cycles the invocation took.
+**/
+VOID
+SmmCoreRecordSmiHandlerInvocation (
+  IN SMI_HANDLER  *SmiHandler,
+  IN UINT64       Cycles
+  );
+
+/**
+  Copy the invocation counters of an SMI handler to its record in the SMI handler
+  profile database.
+
+  @param SmiHandler  The SMI handler.
+**/
+VOID
+SmmCoreUpdateSmiHandlerProfileRecord (
+  IN SMI_HANDLER  *SmiHandler
+  );
+
 /**
   This function is called by SmmChildDispatcher module to report
   a new SMI handler is registered, to SmmCore.
@@ -15,6 +15,14 @@ UINTN  mSmiManageCallingDepth = 0;
 
 LIST_ENTRY  mSmiEntryList = INITIALIZE_LIST_HEAD_VARIABLE (mSmiEntryList);
 
+//
+// Non-root SMI entries are also hashed by HandlerType, so that SmiManage() does
+// not walk all entries for every SMI. The size must be a power of 2.
+//
+#define SMI_ENTRY_HASH_TABLE_SIZE  32
+
+LIST_ENTRY  mSmiEntryHashTable[SMI_ENTRY_HASH_TABLE_SIZE];
+
 SMI_ENTRY  mRootSmiEntry = {
   SMI_ENTRY_SIGNATURE,
   INITIALIZE_LIST_HEAD_VARIABLE (mRootSmiEntry.AllEntries),
@@ -22,6 +30,39 @@ SMI_ENTRY  mRootSmiEntry = {
   INITIALIZE_LIST_HEAD_VARIABLE (mRootSmiEntry.SmiHandlers),
 };
 
+/**
+  Return the bucket of mSmiEntryHashTable that holds the SMI entries of a handler type.
+
+  MmCoreGetMmiEntryBucket() in StandaloneMmPkg/Core/Mmi.c is the same function for
+  MMI entries. Keep the two in sync.
+
+  @param  HandlerType            The type of the interrupt
+
+  @return The list head of the bucket.
+
+**/
+STATIC
+LIST_ENTRY *
+SmmCoreGetSmiEntryBucket (
+  IN CONST EFI_GUID  *HandlerType
+  )
+{
+  UINT32      Hash;
+  LIST_ENTRY  *Bucket;
+
+  Hash  = HandlerType->Data1 ^ (((UINT32)HandlerType->Data2 << 16) | HandlerType->Data3);
+  Hash ^= ReadUnaligned32 ((CONST UINT32 *)&HandlerType->Data4[0]) ^ ReadUnaligned32 ((CONST UINT32 *)&HandlerType->Data4[4]);
+  Hash ^= Hash >> 16;
+  Hash ^= Hash >> 8;
+
+  Bucket = &mSmiEntryHashTable[Hash & (SMI_ENTRY_HASH_TABLE_SIZE - 1)];
+  if (Bucket->ForwardLink == NULL) {
+    InitializeListHead (Bucket);
+  }
+
+  return Bucket;
+}
+
 /**
   Finds the SMI entry for the requested handler type.
 
@@ -38,19 +79,21 @@ SmmCoreFindSmiEntry (
   IN BOOLEAN   Create
   )
 {
+  LIST_ENTRY  *Bucket;
   LIST_ENTRY  *Link;
   SMI_ENTRY   *Item;
   SMI_ENTRY   *SmiEntry;
 
   //
-  // Search the SMI entry list for the matching GUID
+  // Search the SMI entry hash table bucket for the matching GUID
   //
   SmiEntry = NULL;
-  for (Link = mSmiEntryList.ForwardLink;
-       Link != &mSmiEntryList;
+  Bucket   = SmmCoreGetSmiEntryBucket (HandlerType);
+  for (Link = Bucket->ForwardLink;
+       Link != Bucket;
        Link = Link->ForwardLink)
   {
-    Item = CR (Link, SMI_ENTRY, AllEntries, SMI_ENTRY_SIGNATURE);
+    Item = CR (Link, SMI_ENTRY, HashLink, SMI_ENTRY_SIGNATURE);
     if (CompareGuid (&Item->HandlerType, HandlerType)) {
       //
       // This is the SMI entry
@@ -78,6 +121,7 @@ SmmCoreFindSmiEntry (
       // Add it to SMI entry list
       //
       InsertTailList (&mSmiEntryList, &SmiEntry->AllEntries);
+      InsertTailList (Bucket, &SmiEntry->HashLink);
     }
   }
 
@@ -101,6 +145,7 @@ RemoveSmiHandler (
   )
 {
   ASSERT (SmiHandler->ToRemove);
+  SmmCoreUpdateSmiHandlerProfileRecord (SmiHandler);
   RemoveEntryList (&SmiHandler->Link);
   FreePool (SmiHandler);
 
@@ -110,6 +155,7 @@ RemoveSmiHandler (
   if (SmiEntry != NULL) {
     if (IsListEmpty (&SmiEntry->SmiHandlers)) {
       RemoveEntryList (&SmiEntry->AllEntries);
+      RemoveEntryList (&SmiEntry->HashLink);
       FreePool (SmiEntry);
       return TRUE;
     }
@@ -149,9 +195,13 @@ SmiManage (
   EFI_STATUS   ReturnStatus;
   BOOLEAN      WillReturn;
   EFI_STATUS   Status;
+  BOOLEAN      ProfileEnabled;
+  UINT64       StartCycle;
 
   PERF_FUNCTION_BEGIN ();
   mSmiManageCallingDepth++;
+  ProfileEnabled = (BOOLEAN)((PcdGet8 (PcdSmiHandlerProfilePropertyMask) & 0x1) != 0);
+  StartCycle     = 0;
   WillReturn   = FALSE;
   Status       = EFI_NOT_FOUND;
   ReturnStatus = Status;
@@ -179,6 +229,10 @@ SmiManage (
   for (Link = Head->ForwardLink; Link != Head; Link = Link->ForwardLink) {
     SmiHandler = CR (Link, SMI_HANDLER, Link, SMI_HANDLER_SIGNATURE);
 
+    if (ProfileEnabled) {
+      StartCycle = AsmReadTsc ();
+    }
+
     Status = SmiHandler->Handler (
                            (EFI_HANDLE)SmiHandler,
                            Context,
@@ -186,6 +240,10 @@ SmiManage (
                            CommBufferSize
                            );
 
+    if (ProfileEnabled) {
+      SmmCoreRecordSmiHandlerInvocation (SmiHandler, AsmReadTsc () - StartCycle);
+    }
+
     switch (Status) {
       case EFI_INTERRUPT_PENDING:
         //
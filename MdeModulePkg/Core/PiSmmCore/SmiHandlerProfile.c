@@ -484,6 +484,79 @@ DumpSmiEntryList (
   return;
 }
 
+/**
+  Record one invocation of an SMI handler in its profile counters.
+
+  @param SmiHandler  The SMI handler that was invoked.
+  @param Cycles      The TSC cycles the invocation took.
+**/
+VOID
+SmmCoreRecordSmiHandlerInvocation (
+  IN SMI_HANDLER  *SmiHandler,
+  IN UINT64       Cycles
+  )
+{
+  UINTN  Bucket;
+
+  Bucket = (UINTN)HighBitSet64 (Cycles | 1) / 2;
+  if (Bucket >= SMM_CORE_SMI_HANDLER_CYCLE_HISTOGRAM_SIZE) {
+    Bucket = SMM_CORE_SMI_HANDLER_CYCLE_HISTOGRAM_SIZE - 1;
+  }
+
+  SmiHandler->InvokeCount++;
+  SmiHandler->CycleHistogram[Bucket]++;
+}
+
+/**
+  Copy the invocation counters of an SMI handler to its record in the SMI handler
+  profile database.
+
+  @param SmiHandler  The SMI handler.
+**/
+VOID
+SmmCoreUpdateSmiHandlerProfileRecord (
+  IN SMI_HANDLER  *SmiHandler
+  )
+{
+  if ((mSmiHandlerProfileDatabase == NULL) || (SmiHandler->ProfileRecord == NULL)) {
+    return;
+  }
+
+  SmiHandler->ProfileRecord->InvokeCount = SmiHandler->InvokeCount;
+  CopyMem (SmiHandler->ProfileRecord->CycleHistogram, SmiHandler->CycleHistogram, sizeof (SmiHandler->CycleHistogram));
+}
+
+/**
+  Copy the invocation counters of all SMI handlers on the list to the SMI handler
+  profile database.
+
+  @param SmiEntryList a list of SMI entry.
+**/
+VOID
+UpdateSmiHandlerProfileRecordList (
+  IN LIST_ENTRY  *SmiEntryList
+  )
+{
+  LIST_ENTRY   *ListEntry;
+  LIST_ENTRY   *HandlerEntry;
+  SMI_ENTRY    *SmiEntry;
+  SMI_HANDLER  *SmiHandler;
+
+  for (ListEntry = SmiEntryList->ForwardLink;
+       ListEntry != SmiEntryList;
+       ListEntry = ListEntry->ForwardLink)
+  {
+    SmiEntry = CR (ListEntry, SMI_ENTRY, AllEntries, SMI_ENTRY_SIGNATURE);
+    for (HandlerEntry = SmiEntry->SmiHandlers.ForwardLink;
+         HandlerEntry != &SmiEntry->SmiHandlers;
+         HandlerEntry = HandlerEntry->ForwardLink)
+    {
+      SmiHandler = CR (HandlerEntry, SMI_HANDLER, Link, SMI_HANDLER_SIGNATURE);
+      SmmCoreUpdateSmiHandlerProfileRecord (SmiHandler);
+    }
+  }
+}
+
 /**
   SMM Ready To Lock event notification handler.
 
@@ -748,6 +821,9 @@ GetSmmSmiHandlerDataOnSmiEntry (
     SmiHandlerStruct->Handler           = (UINTN)SmiHandler->Handler;
     SmiHandlerStruct->ImageRef          = AddressToImageRef ((UINTN)SmiHandler->Handler);
     SmiHandlerStruct->ContextBufferSize = (UINT32)SmiHandler->ContextSize;
+    SmiHandlerStruct->InvokeCount       = SmiHandler->InvokeCount;
+    CopyMem (SmiHandlerStruct->CycleHistogram, SmiHandler->CycleHistogram, sizeof (SmiHandler->CycleHistogram));
+    SmiHandler->ProfileRecord = SmiHandlerStruct;
     if (SmiHandler->ContextSize != 0) {
       SmiHandlerStruct->ContextBufferOffset = sizeof (SMM_CORE_SMI_HANDLER_STRUCTURE);
       CopyMem ((UINT8 *)SmiHandlerStruct + SmiHandlerStruct->ContextBufferOffset, SmiHandler->Context, SmiHandler->ContextSize);
@@ -943,6 +1019,12 @@ SmiHandlerProfileHandlerGetInfo (
   SmiHandlerProfileRecordingStatus  = mSmiHandlerProfileRecordingStatus;
   mSmiHandlerProfileRecordingStatus = FALSE;
 
+  //
+  // Take a snapshot of the invocation counters for the following GetDataByOffset calls.
+  //
+  UpdateSmiHandlerProfileRecordList (mSmmCoreRootSmiEntryList);
+  UpdateSmiHandlerProfileRecordList (mSmmCoreSmiEntryList);
+
   SmiHandlerProfileParameterGetInfo->DataSize            = mSmiHandlerProfileDatabaseSize;
   SmiHandlerProfileParameterGetInfo->Header.ReturnStatus = 0;
 
@@ -0,0 +1,43 @@
+/** @file
+  Definitions of the memory buffer the DEBUG() messages are logged to.
+
+  In PEI the buffer is the data of a GUIDed HOB. In DXE the buffer is published
+  as an EFI configuration table so that it can be dumped after boot.
+
+Copyright (c) 2026, agent. All rights reserved.<BR>
+
+SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#ifndef DEBUG_LOG_BUFFER_H_
+#define DEBUG_LOG_BUFFER_H_
+
+///
+/// The GUID of the debug log buffer HOB and configuration table.
+///
+#define EDKII_DEBUG_LOG_BUFFER_GUID \
+  { 0x016293a6, 0x089a, 0x4722, { 0x93, 0x6d, 0x2b, 0xc4, 0x41, 0x67, 0xee, 0x39 }}
+
+#define EDKII_DEBUG_LOG_BUFFER_SIGNATURE  SIGNATURE_32 ('D', 'L', 'O', 'G')
+
+///
+/// The header of the debug log buffer. BufferSize bytes of text follow the header
+/// at offset HeaderSize, used as a ring.
+///
+typedef struct {
+  UINT32             Signature;
+  UINT32             HeaderSize;
+  UINT32             BufferSize;
+  UINT32             Reserved;
+  ///
+  /// The number of bytes ever written to the buffer. The text starts at
+  /// (WriteOffset % BufferSize) once more than BufferSize bytes were written,
+  /// and at 0 before that.
+  ///
+  volatile UINT64    WriteOffset;
+} EDKII_DEBUG_LOG_BUFFER;
+
+extern EFI_GUID  gEdkiiDebugLogBufferGuid;
+
+#endif
@@ -42,7 +42,7 @@ typedef struct {
 } SMM_CORE_IMAGE_DATABASE_STRUCTURE;
 
 #define SMM_CORE_SMI_DATABASE_SIGNATURE  SIGNATURE_32 ('S','C','S','D')
-#define SMM_CORE_SMI_DATABASE_REVISION   0x0001
+#define SMM_CORE_SMI_DATABASE_REVISION   0x0002
 
 typedef enum {
   SmmCoreSmiHandlerCategoryRootHandler,
@@ -77,6 +77,13 @@ typedef struct {
   UINT64    SwSmiInputValue;
 } SMI_HANDLER_PROFILE_SW_REGISTER_CONTEXT;
 
+//
+// Bucket N of SMM_CORE_SMI_HANDLER_STRUCTURE.CycleHistogram counts the handler
+// invocations that took [4^N, 4^(N+1)) TSC cycles. Bucket 0 starts from 0
+// cycles and the last bucket also counts the longer invocations.
+//
+#define SMM_CORE_SMI_HANDLER_CYCLE_HISTOGRAM_SIZE  16
+
 typedef struct {
   UINT32              Length;
   UINT32              ImageRef;
@@ -85,6 +92,12 @@ typedef struct {
   UINT16              ContextBufferOffset;
   UINT8               Reserved[2];
   UINT32              ContextBufferSize;
+  //
+  // Added in SMM_CORE_SMI_DATABASE_REVISION 0x0002. They are 0 for
+  // SmmCoreSmiHandlerCategoryHardwareHandler.
+  //
+  UINT64              InvokeCount;
+  UINT64              CycleHistogram[SMM_CORE_SMI_HANDLER_CYCLE_HISTOGRAM_SIZE];
   // UINT8                 ContextBuffer[];
 } SMM_CORE_SMI_HANDLER_STRUCTURE;
 
@@ -0,0 +1,83 @@
+/** @file
+  Internal definitions of the Debug Library instances that log to memory.
+
+  Copyright (c) 2026, agent. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#ifndef DEBUG_LIB_MEMORY_LOG_H_
+#define DEBUG_LIB_MEMORY_LOG_H_
+
+#include <PiPei.h>
+#include <Guid/DebugLogBuffer.h>
+
+/**
+  Return the debug log buffer of the current phase.
+
+  @return The debug log buffer, or NULL if there is none.
+
+**/
+EDKII_DEBUG_LOG_BUFFER *
+DebugLibGetLogBuffer (
+  VOID
+  );
+
+/**
+  Initialize the header of a debug log buffer.
+
+  @param  LogBuffer   The debug log buffer.
+  @param  BufferSize  The size in bytes of the text area following the header.
+
+**/
+VOID
+DebugLogBufferInitialize (
+  OUT EDKII_DEBUG_LOG_BUFFER  *LogBuffer,
+  IN  UINT32                  BufferSize
+  );
+
+/**
+  Append text to a debug log buffer.
+
+  Space is reserved by atomically advancing WriteOffset, so concurrent writers
+  never write to the same bytes. Older text is overwritten once the buffer wraps.
+
+  @param  LogBuffer   The debug log buffer. Nothing is written if it is NULL.
+  @param  Buffer      The text to append.
+  @param  Length      The number of bytes in Buffer.
+
+**/
+VOID
+DebugLogBufferWrite (
+  IN EDKII_DEBUG_LOG_BUFFER  *LogBuffer,
+  IN CONST CHAR8             *Buffer,
+  IN UINTN                   Length
+  );
+
+/**
+  Append the text of one debug log buffer to another, oldest text first.
+
+  @param  LogBuffer   The debug log buffer to append to.
+  @param  Source      The debug log buffer to copy the text from.
+
+**/
+VOID
+DebugLogBufferAppend (
+  IN EDKII_DEBUG_LOG_BUFFER  *LogBuffer,
+  IN EDKII_DEBUG_LOG_BUFFER  *Source
+  );
+
+/**
+  Find the debug log buffer in a HOB list.
+
+  @param  HobList     The start of the HOB list.
+
+  @return The debug log buffer, or NULL if the HOB list has none.
+
+**/
+EDKII_DEBUG_LOG_BUFFER *
+DebugLogBufferFindHob (
+  IN VOID  *HobList
+  );
+
+#endif
@@ -0,0 +1,134 @@
+/** @file
+  Debug log buffer support shared by the PEI and DXE instances.
+
+  Copyright (c) 2026, agent. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#include "DebugLibMemoryLog.h"
+
+#include <Library/BaseLib.h>
+#include <Library/BaseMemoryLib.h>
+#include <Library/SynchronizationLib.h>
+
+/**
+  Initialize the header of a debug log buffer.
+
+  @param  LogBuffer   The debug log buffer.
+  @param  BufferSize  The size in bytes of the text area following the header.
+
+**/
+VOID
+DebugLogBufferInitialize (
+  OUT EDKII_DEBUG_LOG_BUFFER  *LogBuffer,
+  IN  UINT32                  BufferSize
+  )
+{
+  LogBuffer->Signature   = EDKII_DEBUG_LOG_BUFFER_SIGNATURE;
+  LogBuffer->HeaderSize  = sizeof (EDKII_DEBUG_LOG_BUFFER);
+  LogBuffer->BufferSize  = BufferSize;
+  LogBuffer->Reserved    = 0;
+  LogBuffer->WriteOffset = 0;
+}
+
+/**
+  Append text to a debug log buffer.
+
+  Space is reserved by atomically advancing WriteOffset, so concurrent writers
+  never write to the same bytes. Older text is overwritten once the buffer wraps.
+
+  @param  LogBuffer   The debug log buffer. Nothing is written if it is NULL.
+  @param  Buffer      The text to append.
+  @param  Length      The number of bytes in Buffer.
+
+**/
+VOID
+DebugLogBufferWrite (
+  IN EDKII_DEBUG_LOG_BUFFER  *LogBuffer,
+  IN CONST CHAR8             *Buffer,
+  IN UINTN                   Length
+  )
+{
+  UINT64  WriteOffset;
+  UINT32  Offset;
+  UINTN   FirstLength;
+  CHAR8   *Text;
+
+  if ((LogBuffer == NULL) || (LogBuffer->BufferSize == 0) || (Length == 0)) {
+    return;
+  }
+
+  //
+  // Only the tail of text longer than the whole buffer would survive.
+  //
+  if (Length > LogBuffer->BufferSize) {
+    Buffer += Length - LogBuffer->BufferSize;
+    Length  = LogBuffer->BufferSize;
+  }
+
+  do {
+    WriteOffset = LogBuffer->WriteOffset;
+  } while (InterlockedCompareExchange64 (&LogBuffer->WriteOffset, WriteOffset, WriteOffset + Length) != WriteOffset);
+
+  Text        = (CHAR8 *)LogBuffer + LogBuffer->HeaderSize;
+  Offset      = ModU64x32 (WriteOffset, LogBuffer->BufferSize);
+  FirstLength = MIN (Length, LogBuffer->BufferSize - Offset);
+  CopyMem (Text + Offset, Buffer, FirstLength);
+  CopyMem (Text, Buffer + FirstLength, Length - FirstLength);
+}
+
+/**
+  Append the text of one debug log buffer to another, oldest text first.
+
+  @param  LogBuffer   The debug log buffer to append to.
+  @param  Source      The debug log buffer to copy the text from.
+
+**/
+VOID
+DebugLogBufferAppend (
+  IN EDKII_DEBUG_LOG_BUFFER  *LogBuffer,
+  IN EDKII_DEBUG_LOG_BUFFER  *Source
+  )
+{
+  CHAR8   *Text;
+  UINT32  Offset;
+
+  Text = (CHAR8 *)Source + Source->HeaderSize;
+  if (Source->WriteOffset <= Source->BufferSize) {
+    DebugLogBufferWrite (LogBuffer, Text, (UINTN)Source->WriteOffset);
+    return;
+  }
+
+  Offset = ModU64x32 (Source->WriteOffset, Source->BufferSize);
+  DebugLogBufferWrite (LogBuffer, Text + Offset, Source->BufferSize - Offset);
+  DebugLogBufferWrite (LogBuffer, Text, Offset);
+}
+
+/**
+  Find the debug log buffer in a HOB list.
+
+  HobLib is not used, as its instances log through DebugLib themselves.
+
+  @param  HobList     The start of the HOB list.
+
+  @return The debug log buffer, or NULL if the HOB list has none.
+
+**/
+EDKII_DEBUG_LOG_BUFFER *
+DebugLogBufferFindHob (
+  IN VOID  *HobList
+  )
+{
+  EFI_PEI_HOB_POINTERS  Hob;
+
+  for (Hob.Raw = HobList; Hob.Header->HobType != EFI_HOB_TYPE_END_OF_HOB_LIST; Hob.Raw += Hob.Header->HobLength) {
+    if ((Hob.Header->HobType == EFI_HOB_TYPE_GUID_EXTENSION) &&
+        CompareGuid (&Hob.Guid->Name, &gEdkiiDebugLogBufferGuid))
+    {
+      return (EDKII_DEBUG_LOG_BUFFER *)(Hob.Guid + 1);
+    }
+  }
+
+  return NULL;
+}
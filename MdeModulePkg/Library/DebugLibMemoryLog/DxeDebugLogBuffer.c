@@ -0,0 +1,104 @@
+/** @file
+  Locate or create the debug log buffer configuration table in DXE.
+
+  Copyright (c) 2026, agent. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#include <PiDxe.h>
+
+#include <Guid/HobList.h>
+#include <Library/BaseMemoryLib.h>
+#include <Library/PcdLib.h>
+
+#include "DebugLibMemoryLog.h"
+
+EDKII_DEBUG_LOG_BUFFER  *mDebugLogBuffer = NULL;
+
+/**
+  Return the debug log buffer of the current phase.
+
+  @return The debug log buffer, or NULL if there is none.
+
+**/
+EDKII_DEBUG_LOG_BUFFER *
+DebugLibGetLogBuffer (
+  VOID
+  )
+{
+  return mDebugLogBuffer;
+}
+
+/**
+  The constructor function locates the debug log buffer.
+
+  The first module that links this library allocates the buffer, copies the
+  messages logged in PEI into it and installs it as a configuration table.
+  Later modules use the buffer from the configuration table. The messages of a
+  module are dropped if no buffer could be allocated.
+
+  @param  ImageHandle   The firmware allocated handle for the EFI image.
+  @param  SystemTable   A pointer to the EFI System Table.
+
+  @retval EFI_SUCCESS   The constructor always returns EFI_SUCCESS.
+
+**/
+EFI_STATUS
+EFIAPI
+DxeDebugLibMemoryLogConstructor (
+  IN EFI_HANDLE        ImageHandle,
+  IN EFI_SYSTEM_TABLE  *SystemTable
+  )
+{
+  EFI_STATUS              Status;
+  UINTN                   Index;
+  UINTN                   Pages;
+  EFI_PHYSICAL_ADDRESS    Address;
+  EDKII_DEBUG_LOG_BUFFER  *LogBuffer;
+  EDKII_DEBUG_LOG_BUFFER  *PeiLogBuffer;
+
+  //
+  // UefiLib and HobLib are not used, as they log through DebugLib themselves.
+  //
+  PeiLogBuffer = NULL;
+  for (Index = 0; Index < SystemTable->NumberOfTableEntries; Index++) {
+    if (CompareGuid (&gEdkiiDebugLogBufferGuid, &SystemTable->ConfigurationTable[Index].VendorGuid)) {
+      mDebugLogBuffer = SystemTable->ConfigurationTable[Index].VendorTable;
+      return EFI_SUCCESS;
+    }
+
+    if (CompareGuid (&gEfiHobListGuid, &SystemTable->ConfigurationTable[Index].VendorGuid)) {
+      PeiLogBuffer = DebugLogBufferFindHob (SystemTable->ConfigurationTable[Index].VendorTable);
+    }
+  }
+
+  //
+  // Use runtime memory so that the OS can still read the buffer after ExitBootServices().
+  //
+  Pages  = EFI_SIZE_TO_PAGES (sizeof (EDKII_DEBUG_LOG_BUFFER) + PcdGet32 (PcdDebugLogBufferDxeSize));
+  Status = SystemTable->BootServices->AllocatePages (
+                                        AllocateAnyPages,
+                                        EfiRuntimeServicesData,
+                                        Pages,
+                                        &Address
+                                        );
+  if (EFI_ERROR (Status)) {
+    return EFI_SUCCESS;
+  }
+
+  LogBuffer = (EDKII_DEBUG_LOG_BUFFER *)(UINTN)Address;
+  DebugLogBufferInitialize (LogBuffer, (UINT32)(EFI_PAGES_TO_SIZE (Pages) - sizeof (EDKII_DEBUG_LOG_BUFFER)));
+  if (PeiLogBuffer != NULL) {
+    DebugLogBufferAppend (LogBuffer, PeiLogBuffer);
+  }
+
+  Status = SystemTable->BootServices->InstallConfigurationTable (&gEdkiiDebugLogBufferGuid, LogBuffer);
+  if (EFI_ERROR (Status)) {
+    SystemTable->BootServices->FreePages (Address, Pages);
+    return EFI_SUCCESS;
+  }
+
+  mDebugLogBuffer = LogBuffer;
+  return EFI_SUCCESS;
+}
@@ -0,0 +1,69 @@
+/** @file
+  Locate or create the debug log buffer HOB in PEI.
+
+  Copyright (c) 2026, agent. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#include <PiPei.h>
+
+#include <Library/BaseMemoryLib.h>
+#include <Library/PcdLib.h>
+#include <Library/PeiServicesLib.h>
+
+#include "DebugLibMemoryLog.h"
+
+/**
+  Return the debug log buffer of the current phase.
+
+  The buffer is looked up in the HOB list on every call, as PEIMs may run from
+  flash where global variables can not be written. The HOB is created by the
+  first message logged.
+
+  @return The debug log buffer, or NULL if there is none.
+
+**/
+EDKII_DEBUG_LOG_BUFFER *
+DebugLibGetLogBuffer (
+  VOID
+  )
+{
+  EFI_STATUS              Status;
+  VOID                    *HobList;
+  EFI_HOB_GUID_TYPE       *GuidHob;
+  EDKII_DEBUG_LOG_BUFFER  *LogBuffer;
+  UINT32                  BufferSize;
+
+  Status = PeiServicesGetHobList (&HobList);
+  if (EFI_ERROR (Status) || (HobList == NULL)) {
+    return NULL;
+  }
+
+  LogBuffer = DebugLogBufferFindHob (HobList);
+  if (LogBuffer != NULL) {
+    return LogBuffer;
+  }
+
+  //
+  // The HOB length is 16 bits and a multiple of 8.
+  //
+  BufferSize = (UINT32)MIN (
+                         PcdGet32 (PcdDebugLogBufferPeiSize),
+                         (MAX_UINT16 & ~0x7) - sizeof (EFI_HOB_GUID_TYPE) - sizeof (EDKII_DEBUG_LOG_BUFFER)
+                         );
+  BufferSize = BufferSize & ~0x7;
+  Status     = PeiServicesCreateHob (
+                 EFI_HOB_TYPE_GUID_EXTENSION,
+                 (UINT16)(sizeof (EFI_HOB_GUID_TYPE) + sizeof (EDKII_DEBUG_LOG_BUFFER) + BufferSize),
+                 (VOID **)&GuidHob
+                 );
+  if (EFI_ERROR (Status)) {
+    return NULL;
+  }
+
+  CopyGuid (&GuidHob->Name, &gEdkiiDebugLogBufferGuid);
+  LogBuffer = (EDKII_DEBUG_LOG_BUFFER *)(GuidHob + 1);
+  DebugLogBufferInitialize (LogBuffer, BufferSize);
+  return LogBuffer;
+}
@@ -339,6 +339,127 @@ FrameBufferBltLibVideoFill (
   return RETURN_SUCCESS;
 }
 
+/**
+  Convert a line of pixels from the frame buffer format to
+  EFI_GRAPHICS_OUTPUT_BLT_PIXEL.
+
+  @param[in]  Configure     Pointer to a configuration which was successfully
+                            created by FrameBufferBltConfigure ().
+  @param[out] Destination   Output buffer for pixel color data.
+  @param[in]  Source        Pixels in the frame buffer format.
+  @param[in]  Width         Width (in pixels).
+**/
+STATIC
+VOID
+FrameBufferBltLibConvertLineFromVideo (
+  IN     FRAME_BUFFER_CONFIGURE      *Configure,
+  OUT EFI_GRAPHICS_OUTPUT_BLT_PIXEL  *Destination,
+  IN     UINT8                       *Source,
+  IN     UINTN                       Width
+  )
+{
+  UINTN   IndexX;
+  UINT32  Uint32;
+  UINT32  BytesPerPixel;
+  UINT32  RedMask;
+  UINT32  GreenMask;
+  UINT32  BlueMask;
+  INT8    PixelShl[3];
+  INT8    PixelShr[3];
+
+  if (Configure->PixelFormat == PixelRedGreenBlueReserved8BitPerColor) {
+    //
+    // Only the red and blue bytes need to be swapped.
+    //
+    for (IndexX = 0; IndexX < Width; IndexX++) {
+      Uint32                          = ((UINT32 *)Source)[IndexX];
+      ((UINT32 *)Destination)[IndexX] = ((Uint32 & 0xff) << 16) | (Uint32 & 0xff00) | ((Uint32 >> 16) & 0xff);
+    }
+
+    return;
+  }
+
+  //
+  // Keep the pixel format in locals, the stores to Destination may alias Configure.
+  //
+  BytesPerPixel = Configure->BytesPerPixel;
+  RedMask       = Configure->PixelMasks.RedMask;
+  GreenMask     = Configure->PixelMasks.GreenMask;
+  BlueMask      = Configure->PixelMasks.BlueMask;
+  CopyMem (PixelShl, Configure->PixelShl, sizeof (PixelShl));
+  CopyMem (PixelShr, Configure->PixelShr, sizeof (PixelShr));
+
+  for (IndexX = 0; IndexX < Width; IndexX++) {
+    Uint32                          = *(UINT32 *)(Source + (IndexX * BytesPerPixel));
+    ((UINT32 *)Destination)[IndexX] =
+      (UINT32)(
+               (((Uint32 & RedMask) >> PixelShl[0]) << PixelShr[0]) |
+               (((Uint32 & GreenMask) >> PixelShl[1]) << PixelShr[1]) |
+               (((Uint32 & BlueMask) >> PixelShl[2]) << PixelShr[2])
+               );
+  }
+}
+
+/**
+  Convert a line of EFI_GRAPHICS_OUTPUT_BLT_PIXEL to the frame buffer format.
+
+  @param[in]  Configure     Pointer to a configuration which was successfully
+                            created by FrameBufferBltConfigure ().
+  @param[out] Destination   Output buffer for pixels in the frame buffer format.
+  @param[in]  Source        Pixel color data.
+  @param[in]  Width         Width (in pixels).
+**/
+STATIC
+VOID
+FrameBufferBltLibConvertLineToVideo (
+  IN  FRAME_BUFFER_CONFIGURE         *Configure,
+  OUT UINT8                          *Destination,
+  IN  EFI_GRAPHICS_OUTPUT_BLT_PIXEL  *Source,
+  IN  UINTN                          Width
+  )
+{
+  UINTN   IndexX;
+  UINT32  Uint32;
+  UINT32  BytesPerPixel;
+  UINT32  RedMask;
+  UINT32  GreenMask;
+  UINT32  BlueMask;
+  INT8    PixelShl[3];
+  INT8    PixelShr[3];
+
+  if (Configure->PixelFormat == PixelRedGreenBlueReserved8BitPerColor) {
+    //
+    // Only the red and blue bytes need to be swapped.
+    //
+    for (IndexX = 0; IndexX < Width; IndexX++) {
+      Uint32                          = ((UINT32 *)Source)[IndexX];
+      ((UINT32 *)Destination)[IndexX] = ((Uint32 & 0xff) << 16) | (Uint32 & 0xff00) | ((Uint32 >> 16) & 0xff);
+    }
+
+    return;
+  }
+
+  //
+  // Keep the pixel format in locals, the stores to Destination may alias Configure.
+  //
+  BytesPerPixel = Configure->BytesPerPixel;
+  RedMask       = Configure->PixelMasks.RedMask;
+  GreenMask     = Configure->PixelMasks.GreenMask;
+  BlueMask      = Configure->PixelMasks.BlueMask;
+  CopyMem (PixelShl, Configure->PixelShl, sizeof (PixelShl));
+  CopyMem (PixelShr, Configure->PixelShr, sizeof (PixelShr));
+
+  for (IndexX = 0; IndexX < Width; IndexX++) {
+    Uint32                                              = ((UINT32 *)Source)[IndexX];
+    *(UINT32 *)(Destination + (IndexX * BytesPerPixel)) =
+      (UINT32)(
+               (((Uint32 << PixelShl[0]) >> PixelShr[0]) & RedMask) |
+               (((Uint32 << PixelShl[1]) >> PixelShr[1]) & GreenMask) |
+               (((Uint32 << PixelShl[2]) >> PixelShr[2]) & BlueMask)
+               );
+  }
+}
+
 /**
   Performs a UEFI Graphics Output Protocol Blt Video to Buffer operation
   with extended parameters.
@@ -370,15 +491,12 @@ FrameBufferBltLibVideoToBltBuffer (
   IN     UINTN                       Delta
   )
 {
-  UINTN                          DstY;
-  UINTN                          SrcY;
-  EFI_GRAPHICS_OUTPUT_BLT_PIXEL  *Blt;
-  UINT8                          *Source;
-  UINT8                          *Destination;
-  UINTN                          IndexX;
-  UINT32                         Uint32;
-  UINTN                          Offset;
-  UINTN                          WidthInBytes;
+  UINTN  DstY;
+  UINTN  SrcY;
+  UINT8  *Source;
+  UINT8  *Destination;
+  UINTN  Offset;
+  UINTN  WidthInBytes;
 
   //
   // Video to BltBuffer: Source is Video, destination is BltBuffer
@@ -406,6 +524,20 @@ FrameBufferBltLibVideoToBltBuffer (
 
   WidthInBytes = Width * Configure->BytesPerPixel;
 
+  //
+  // Full width lines with no gap in between are one contiguous span in both
+  // buffers, so a BGRx frame buffer can be copied in one shot.
+  //
+  if ((Configure->PixelFormat == PixelBlueGreenRedReserved8BitPerColor) &&
+      (SourceX == 0) && (DestinationX == 0) &&
+      (Width == Configure->PixelsPerScanLine) && (Delta == WidthInBytes))
+  {
+    Source      = Configure->FrameBuffer + (SourceY * WidthInBytes);
+    Destination = (UINT8 *)BltBuffer + (DestinationY * Delta);
+    CopyMem (Destination, Source, WidthInBytes * Height);
+    return RETURN_SUCCESS;
+  }
+
   //
   // Video to BltBuffer: Source is Video, destination is BltBuffer
   //
@@ -426,21 +558,12 @@ FrameBufferBltLibVideoToBltBuffer (
     CopyMem (Destination, Source, WidthInBytes);
 
     if (Configure->PixelFormat != PixelBlueGreenRedReserved8BitPerColor) {
-      for (IndexX = 0; IndexX < Width; IndexX++) {
-        Blt = (EFI_GRAPHICS_OUTPUT_BLT_PIXEL *)
-              ((UINT8 *)BltBuffer + (DstY * Delta) +
-               (DestinationX + IndexX) * sizeof (EFI_GRAPHICS_OUTPUT_BLT_PIXEL));
-        Uint32         = *(UINT32 *)(Configure->LineBuffer + (IndexX * Configure->BytesPerPixel));
-        *(UINT32 *)Blt =
-          (UINT32)(
-                   (((Uint32 & Configure->PixelMasks.RedMask) >>
-                     Configure->PixelShl[0]) << Configure->PixelShr[0]) |
-                   (((Uint32 & Configure->PixelMasks.GreenMask) >>
-                     Configure->PixelShl[1]) << Configure->PixelShr[1]) |
-                   (((Uint32 & Configure->PixelMasks.BlueMask) >>
-                     Configure->PixelShl[2]) << Configure->PixelShr[2])
-                   );
-      }
+      FrameBufferBltLibConvertLineFromVideo (
+        Configure,
+        (EFI_GRAPHICS_OUTPUT_BLT_PIXEL *)((UINT8 *)BltBuffer + (DstY * Delta) + (DestinationX * sizeof (EFI_GRAPHICS_OUTPUT_BLT_PIXEL))),
+        Configure->LineBuffer,
+        Width
+        );
     }
   }
 
@@ -478,15 +601,12 @@ FrameBufferBltLibBufferToVideo (
   IN  UINTN                          Delta
   )
 {
-  UINTN                          DstY;
-  UINTN                          SrcY;
-  EFI_GRAPHICS_OUTPUT_BLT_PIXEL  *Blt;
-  UINT8                          *Source;
-  UINT8                          *Destination;
-  UINTN                          IndexX;
-  UINT32                         Uint32;
-  UINTN                          Offset;
-  UINTN                          WidthInBytes;
+  UINTN  DstY;
+  UINTN  SrcY;
+  UINT8  *Source;
+  UINT8  *Destination;
+  UINTN  Offset;
+  UINTN  WidthInBytes;
 
   //
   // BltBuffer to Video: Source is BltBuffer, destination is Video
@@ -514,6 +634,20 @@ FrameBufferBltLibBufferToVideo (
 
   WidthInBytes = Width * Configure->BytesPerPixel;
 
+  //
+  // Full width lines with no gap in between are one contiguous span in both
+  // buffers, so a BGRx frame buffer can be written in one shot.
+  //
+  if ((Configure->PixelFormat == PixelBlueGreenRedReserved8BitPerColor) &&
+      (SourceX == 0) && (DestinationX == 0) &&
+      (Width == Configure->PixelsPerScanLine) && (Delta == WidthInBytes))
+  {
+    Source      = (UINT8 *)BltBuffer + (SourceY * Delta);
+    Destination = Configure->FrameBuffer + (DestinationY * WidthInBytes);
+    CopyMem (Destination, Source, WidthInBytes * Height);
+    return RETURN_SUCCESS;
+  }
+
   for (SrcY = SourceY, DstY = DestinationY;
        SrcY < (Height + SourceY);
        SrcY++, DstY++)
@@ -525,25 +659,12 @@ FrameBufferBltLibBufferToVideo (
     if (Configure->PixelFormat == PixelBlueGreenRedReserved8BitPerColor) {
       Source = (UINT8 *)BltBuffer + (SrcY * Delta) + SourceX * sizeof (EFI_GRAPHICS_OUTPUT_BLT_PIXEL);
     } else {
-      for (IndexX = 0; IndexX < Width; IndexX++) {
-        Blt =
-          (EFI_GRAPHICS_OUTPUT_BLT_PIXEL *)(
-                                            (UINT8 *)BltBuffer +
-                                            (SrcY * Delta) +
-                                            ((SourceX + IndexX) * sizeof (EFI_GRAPHICS_OUTPUT_BLT_PIXEL))
-                                            );
-        Uint32                                                                   = *(UINT32 *)Blt;
-        *(UINT32 *)(Configure->LineBuffer + (IndexX * Configure->BytesPerPixel)) =
-          (UINT32)(
-                   (((Uint32 << Configure->PixelShl[0]) >> Configure->PixelShr[0]) &
-                    Configure->PixelMasks.RedMask) |
-                   (((Uint32 << Configure->PixelShl[1]) >> Configure->PixelShr[1]) &
-                    Configure->PixelMasks.GreenMask) |
-                   (((Uint32 << Configure->PixelShl[2]) >> Configure->PixelShr[2]) &
-                    Configure->PixelMasks.BlueMask)
-                   );
-      }
-
+      FrameBufferBltLibConvertLineToVideo (
+        Configure,
+        Configure->LineBuffer,
+        (EFI_GRAPHICS_OUTPUT_BLT_PIXEL *)((UINT8 *)BltBuffer + (SrcY * Delta) + (SourceX * sizeof (EFI_GRAPHICS_OUTPUT_BLT_PIXEL))),
+        Width
+        );
       Source = Configure->LineBuffer;
     }
 
@@ -618,13 +739,21 @@ FrameBufferBltLibVideoToVideo (
   Offset      = Configure->BytesPerPixel * Offset;
   Destination = Configure->FrameBuffer + Offset;
 
+  //
+  // Full width lines are one contiguous span, CopyMem() handles the overlap.
+  //
+  if ((SourceX == 0) && (DestinationX == 0) && (Width == Configure->PixelsPerScanLine)) {
+    CopyMem (Destination, Source, WidthInBytes * Height);
+    return RETURN_SUCCESS;
+  }
+
   LineStride = Configure->BytesPerPixel * Configure->PixelsPerScanLine;
   if (Destination > Source) {
     //
     // Copy from last line to avoid source is corrupted by copying
     //
-    Source      += Height * LineStride;
-    Destination += Height * LineStride;
+    Source      += (Height - 1) * LineStride;
+    Destination += (Height - 1) * LineStride;
     LineStride   = -LineStride;
   }
 
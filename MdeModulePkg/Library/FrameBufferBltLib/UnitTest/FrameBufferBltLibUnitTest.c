@@ -0,0 +1,490 @@
+/** @file
+  Unit tests and benchmark of the FrameBufferBltLib
+
+  Copyright (c) 2026, agent. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#include <stdio.h>
+#include <string.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <time.h>
+#include <cmocka.h>
+
+#include <Uefi.h>
+#include <Library/BaseLib.h>
+#include <Library/BaseMemoryLib.h>
+#include <Library/DebugLib.h>
+#include <Library/MemoryAllocationLib.h>
+
+#include <Library/UnitTestLib.h>
+#include <Library/FrameBufferBltLib.h>
+
+#define UNIT_TEST_APP_NAME     "FrameBufferBltLib Unit Tests"
+#define UNIT_TEST_APP_VERSION  "1.0"
+
+#define TEST_WIDTH                64
+#define TEST_HEIGHT               48
+#define TEST_PADDING              16
+#define BENCHMARK_WIDTH           3840
+#define BENCHMARK_HEIGHT          2160
+#define BENCHMARK_ITERATION_TIME  10
+
+typedef struct {
+  EFI_GRAPHICS_PIXEL_FORMAT    PixelFormat;
+  EFI_PIXEL_BITMASK            PixelInformation;
+  UINT32                       BytesPerPixel;
+  //
+  // Bits of each BLT pixel channel that survive a round trip through the frame buffer.
+  //
+  UINT32                       BltMask;
+} FRAME_BUFFER_TEST_FORMAT;
+
+typedef struct {
+  EFI_GRAPHICS_OUTPUT_MODE_INFORMATION    Info;
+  UINT8                                   *FrameBuffer;
+  UINTN                                   FrameBufferSize;
+  FRAME_BUFFER_CONFIGURE                  *Configure;
+} FRAME_BUFFER_TEST_CONTEXT;
+
+FRAME_BUFFER_TEST_FORMAT  mRgbFormat = {
+  PixelRedGreenBlueReserved8BitPerColor, { 0, 0, 0, 0 }, 4, 0x00ffffff
+};
+
+FRAME_BUFFER_TEST_FORMAT  mBgrFormat = {
+  PixelBlueGreenRedReserved8BitPerColor, { 0, 0, 0, 0 }, 4, 0x00ffffff
+};
+
+FRAME_BUFFER_TEST_FORMAT  mBitMask565Format = {
+  PixelBitMask, { 0xf800, 0x07e0, 0x001f, 0 }, 2, 0x00f8fcf8
+};
+
+FRAME_BUFFER_TEST_FORMAT  mBitMask888Format = {
+  PixelBitMask, { 0x0000ff00, 0x00ff0000, 0x000000ff, 0 }, 4, 0x00ffffff
+};
+
+/**
+  Return a pseudo random pixel value.
+
+  @param[in, out] Seed  The state of the generator.
+
+  @return The pixel value.
+**/
+STATIC
+UINT32
+NextPixel (
+  IN OUT UINT32  *Seed
+  )
+{
+  *Seed = *Seed * 1103515245 + 12345;
+  return (*Seed >> 8) ^ (*Seed << 16);
+}
+
+/**
+  Create a frame buffer and its configuration.
+
+  @param[in]  Format             The pixel format of the frame buffer.
+  @param[in]  Width              Width of the frame buffer in pixels.
+  @param[in]  Height             Height of the frame buffer in pixels.
+  @param[in]  PixelsPerScanLine  Pixels per scan line of the frame buffer.
+  @param[out] Context            Return the frame buffer and its configuration.
+
+  @retval TRUE   The frame buffer was created.
+  @retval FALSE  The frame buffer could not be created.
+**/
+STATIC
+BOOLEAN
+CreateFrameBuffer (
+  IN  FRAME_BUFFER_TEST_FORMAT   *Format,
+  IN  UINT32                     Width,
+  IN  UINT32                     Height,
+  IN  UINT32                     PixelsPerScanLine,
+  OUT FRAME_BUFFER_TEST_CONTEXT  *Context
+  )
+{
+  UINTN          ConfigureSize;
+  RETURN_STATUS  Status;
+
+  ZeroMem (Context, sizeof (*Context));
+  Context->Info.HorizontalResolution = Width;
+  Context->Info.VerticalResolution   = Height;
+  Context->Info.PixelsPerScanLine    = PixelsPerScanLine;
+  Context->Info.PixelFormat          = Format->PixelFormat;
+  CopyMem (&Context->Info.PixelInformation, &Format->PixelInformation, sizeof (EFI_PIXEL_BITMASK));
+
+  Context->FrameBufferSize = PixelsPerScanLine * Height * Format->BytesPerPixel;
+  Context->FrameBuffer     = AllocateZeroPool (Context->FrameBufferSize);
+  if (Context->FrameBuffer == NULL) {
+    return FALSE;
+  }
+
+  ConfigureSize = 0;
+  Status        = FrameBufferBltConfigure (Context->FrameBuffer, &Context->Info, NULL, &ConfigureSize);
+  if (Status != RETURN_BUFFER_TOO_SMALL) {
+    return FALSE;
+  }
+
+  Context->Configure = AllocatePool (ConfigureSize);
+  if (Context->Configure == NULL) {
+    return FALSE;
+  }
+
+  Status = FrameBufferBltConfigure (Context->FrameBuffer, &Context->Info, Context->Configure, &ConfigureSize);
+  return (BOOLEAN)(Status == RETURN_SUCCESS);
+}
+
+/**
+  Free the frame buffer and configuration created by CreateFrameBuffer ().
+
+  @param[in] Context  The frame buffer and its configuration.
+**/
+STATIC
+VOID
+DestroyFrameBuffer (
+  IN FRAME_BUFFER_TEST_CONTEXT  *Context
+  )
+{
+  if (Context->FrameBuffer != NULL) {
+    FreePool (Context->FrameBuffer);
+  }
+
+  if (Context->Configure != NULL) {
+    FreePool (Context->Configure);
+  }
+}
+
+/**
+  Write a BLT buffer to the frame buffer and read it back, both for the full
+  screen and for a sub-rectangle, with and without scan line padding.
+
+  @param[in]  Context    The FRAME_BUFFER_TEST_FORMAT to test.
+
+  @retval  UNIT_TEST_PASSED             The Unit test has completed and the test
+                                        case was successful.
+  @retval  UNIT_TEST_ERROR_TEST_FAILED  A test case assertion has failed.
+**/
+UNIT_TEST_STATUS
+EFIAPI
+BufferToVideoRoundTripShouldMatch (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  FRAME_BUFFER_TEST_FORMAT   *Format;
+  FRAME_BUFFER_TEST_CONTEXT  FrameBuffer;
+  UINT32                     Padding;
+  UINT32                     Seed;
+  UINTN                      Index;
+  UINT32                     *Blt;
+  UINT32                     *ReadBack;
+  UINTN                      BltSize;
+  RETURN_STATUS              Status;
+
+  Format  = (FRAME_BUFFER_TEST_FORMAT *)Context;
+  BltSize = TEST_WIDTH * TEST_HEIGHT * sizeof (EFI_GRAPHICS_OUTPUT_BLT_PIXEL);
+  Seed    = 1;
+
+  for (Padding = 0; Padding <= TEST_PADDING; Padding += TEST_PADDING) {
+    UT_ASSERT_TRUE (CreateFrameBuffer (Format, TEST_WIDTH, TEST_HEIGHT, TEST_WIDTH + Padding, &FrameBuffer));
+    Blt      = AllocatePool (BltSize);
+    ReadBack = AllocateZeroPool (BltSize);
+    UT_ASSERT_NOT_NULL (Blt);
+    UT_ASSERT_NOT_NULL (ReadBack);
+
+    for (Index = 0; Index < TEST_WIDTH * TEST_HEIGHT; Index++) {
+      Blt[Index] = NextPixel (&Seed) & Format->BltMask;
+    }
+
+    //
+    // Full screen.
+    //
+    Status = FrameBufferBlt (FrameBuffer.Configure, (EFI_GRAPHICS_OUTPUT_BLT_PIXEL *)Blt, EfiBltBufferToVideo, 0, 0, 0, 0, TEST_WIDTH, TEST_HEIGHT, 0);
+    UT_ASSERT_NOT_EFI_ERROR (Status);
+    Status = FrameBufferBlt (FrameBuffer.Configure, (EFI_GRAPHICS_OUTPUT_BLT_PIXEL *)ReadBack, EfiBltVideoToBltBuffer, 0, 0, 0, 0, TEST_WIDTH, TEST_HEIGHT, 0);
+    UT_ASSERT_NOT_EFI_ERROR (Status);
+    UT_ASSERT_MEM_EQUAL (Blt, ReadBack, BltSize);
+
+    //
+    // Sub-rectangle using a Delta that differs from the width.
+    //
+    for (Index = 0; Index < TEST_WIDTH * TEST_HEIGHT; Index++) {
+      Blt[Index] = NextPixel (&Seed) & Format->BltMask;
+    }
+
+    ZeroMem (ReadBack, BltSize);
+    Status = FrameBufferBlt (
+               FrameBuffer.Configure,
+               (EFI_GRAPHICS_OUTPUT_BLT_PIXEL *)Blt,
+               EfiBltBufferToVideo,
+               3,
+               2,
+               5,
+               7,
+               TEST_WIDTH / 2,
+               TEST_HEIGHT / 2,
+               TEST_WIDTH * sizeof (EFI_GRAPHICS_OUTPUT_BLT_PIXEL)
+               );
+    UT_ASSERT_NOT_EFI_ERROR (Status);
+    Status = FrameBufferBlt (
+               FrameBuffer.Configure,
+               (EFI_GRAPHICS_OUTPUT_BLT_PIXEL *)ReadBack,
+               EfiBltVideoToBltBuffer,
+               5,
+               7,
+               3,
+               2,
+               TEST_WIDTH / 2,
+               TEST_HEIGHT / 2,
+               TEST_WIDTH * sizeof (EFI_GRAPHICS_OUTPUT_BLT_PIXEL)
+               );
+    UT_ASSERT_NOT_EFI_ERROR (Status);
+    for (Index = 0; Index < TEST_HEIGHT / 2; Index++) {
+      UT_ASSERT_MEM_EQUAL (
+        &Blt[(Index + 2) * TEST_WIDTH + 3],
+        &ReadBack[(Index + 2) * TEST_WIDTH + 3],
+        (TEST_WIDTH / 2) * sizeof (EFI_GRAPHICS_OUTPUT_BLT_PIXEL)
+        );
+    }
+
+    FreePool (Blt);
+    FreePool (ReadBack);
+    DestroyFrameBuffer (&FrameBuffer);
+  }
+
+  return UNIT_TEST_PASSED;
+}
+
+/**
+  Scroll the frame buffer up and down by one line, both for the full width and
+  for a sub-rectangle, and check the result against a line by line reference.
+
+  @param[in]  Context    The FRAME_BUFFER_TEST_FORMAT to test.
+
+  @retval  UNIT_TEST_PASSED             The Unit test has completed and the test
+                                        case was successful.
+  @retval  UNIT_TEST_ERROR_TEST_FAILED  A test case assertion has failed.
+**/
+UNIT_TEST_STATUS
+EFIAPI
+VideoToVideoScrollShouldMatch (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  FRAME_BUFFER_TEST_FORMAT   *Format;
+  FRAME_BUFFER_TEST_CONTEXT  FrameBuffer;
+  UINT8                      *Expected;
+  UINTN                      LineSize;
+  UINTN                      Index;
+  UINTN                      Case;
+  UINTN                      SourceY;
+  UINTN                      DestinationY;
+  UINTN                      X;
+  UINTN                      Width;
+  UINT32                     Seed;
+  RETURN_STATUS              Status;
+
+  Format = (FRAME_BUFFER_TEST_FORMAT *)Context;
+  Seed   = 1;
+
+  UT_ASSERT_TRUE (CreateFrameBuffer (Format, TEST_WIDTH, TEST_HEIGHT, TEST_WIDTH, &FrameBuffer));
+  Expected = AllocatePool (FrameBuffer.FrameBufferSize);
+  UT_ASSERT_NOT_NULL (Expected);
+  LineSize = TEST_WIDTH * Format->BytesPerPixel;
+
+  for (Case = 0; Case < 4; Case++) {
+    SourceY      = ((Case & 1) == 0) ? 1 : 0;
+    DestinationY = 1 - SourceY;
+    X            = ((Case & 2) == 0) ? 0 : 4;
+    Width        = TEST_WIDTH - 2 * X;
+
+    for (Index = 0; Index < FrameBuffer.FrameBufferSize; Index++) {
+      FrameBuffer.FrameBuffer[Index] = (UINT8)NextPixel (&Seed);
+    }
+
+    CopyMem (Expected, FrameBuffer.FrameBuffer, FrameBuffer.FrameBufferSize);
+    for (Index = 0; Index < TEST_HEIGHT - 1; Index++) {
+      //
+      // Walk in the direction that does not overwrite lines not yet copied.
+      //
+      if (DestinationY > SourceY) {
+        CopyMem (
+          Expected + (TEST_HEIGHT - 1 - Index) * LineSize + X * Format->BytesPerPixel,
+          Expected + (TEST_HEIGHT - 2 - Index) * LineSize + X * Format->BytesPerPixel,
+          Width * Format->BytesPerPixel
+          );
+      } else {
+        CopyMem (
+          Expected + Index * LineSize + X * Format->BytesPerPixel,
+          Expected + (Index + 1) * LineSize + X * Format->BytesPerPixel,
+          Width * Format->BytesPerPixel
+          );
+      }
+    }
+
+    Status = FrameBufferBlt (FrameBuffer.Configure, NULL, EfiBltVideoToVideo, X, SourceY, X, DestinationY, Width, TEST_HEIGHT - 1, 0);
+    UT_ASSERT_NOT_EFI_ERROR (Status);
+    UT_ASSERT_MEM_EQUAL (Expected, FrameBuffer.FrameBuffer, FrameBuffer.FrameBufferSize);
+  }
+
+  FreePool (Expected);
+  DestroyFrameBuffer (&FrameBuffer);
+  return UNIT_TEST_PASSED;
+}
+
+/**
+  Measure full screen BufferToVideo and VideoToBltBuffer at 4K resolution.
+
+  The results are only logged, the test passes as long as the operations succeed.
+
+  @param[in]  Context    The FRAME_BUFFER_TEST_FORMAT to test.
+
+  @retval  UNIT_TEST_PASSED             The Unit test has completed and the test
+                                        case was successful.
+  @retval  UNIT_TEST_ERROR_TEST_FAILED  A test case assertion has failed.
+**/
+UNIT_TEST_STATUS
+EFIAPI
+BenchmarkFullScreenBlt (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  FRAME_BUFFER_TEST_FORMAT   *Format;
+  FRAME_BUFFER_TEST_CONTEXT  FrameBuffer;
+  VOID                       *Blt;
+  UINTN                      Index;
+  clock_t                    Start;
+  clock_t                    ToVideo;
+  clock_t                    FromVideo;
+  RETURN_STATUS              Status;
+
+  Format = (FRAME_BUFFER_TEST_FORMAT *)Context;
+
+  UT_ASSERT_TRUE (CreateFrameBuffer (Format, BENCHMARK_WIDTH, BENCHMARK_HEIGHT, BENCHMARK_WIDTH, &FrameBuffer));
+  Blt = AllocateZeroPool (BENCHMARK_WIDTH * BENCHMARK_HEIGHT * sizeof (EFI_GRAPHICS_OUTPUT_BLT_PIXEL));
+  UT_ASSERT_NOT_NULL (Blt);
+
+  Start = clock ();
+  for (Index = 0; Index < BENCHMARK_ITERATION_TIME; Index++) {
+    Status = FrameBufferBlt (FrameBuffer.Configure, Blt, EfiBltBufferToVideo, 0, 0, 0, 0, BENCHMARK_WIDTH, BENCHMARK_HEIGHT, 0);
+    UT_ASSERT_NOT_EFI_ERROR (Status);
+  }
+
+  ToVideo = clock () - Start;
+
+  Start = clock ();
+  for (Index = 0; Index < BENCHMARK_ITERATION_TIME; Index++) {
+    Status = FrameBufferBlt (FrameBuffer.Configure, Blt, EfiBltVideoToBltBuffer, 0, 0, 0, 0, BENCHMARK_WIDTH, BENCHMARK_HEIGHT, 0);
+    UT_ASSERT_NOT_EFI_ERROR (Status);
+  }
+
+  FromVideo = clock () - Start;
+
+  UT_LOG_INFO (
+    "%dx%d BufferToVideo: %d us, VideoToBltBuffer: %d us\n",
+    BENCHMARK_WIDTH,
+    BENCHMARK_HEIGHT,
+    (UINT32)((UINT64)ToVideo * 1000000 / CLOCKS_PER_SEC / BENCHMARK_ITERATION_TIME),
+    (UINT32)((UINT64)FromVideo * 1000000 / CLOCKS_PER_SEC / BENCHMARK_ITERATION_TIME)
+    );
+
+  FreePool (Blt);
+  DestroyFrameBuffer (&FrameBuffer);
+  return UNIT_TEST_PASSED;
+}
+
+/**
+  Initialze the unit test framework, suite, and unit tests for the
+  FrameBufferBltLib and run the FrameBufferBltLib unit test.
+
+  @retval  EFI_SUCCESS           All test cases were dispatched.
+  @retval  EFI_OUT_OF_RESOURCES  There are not enough resources available to
+                                 initialize the unit tests.
+**/
+STATIC
+EFI_STATUS
+EFIAPI
+UnitTestingEntry (
+  VOID
+  )
+{
+  EFI_STATUS                  Status;
+  UNIT_TEST_FRAMEWORK_HANDLE  Framework;
+  UNIT_TEST_SUITE_HANDLE      BltTests;
+  UNIT_TEST_SUITE_HANDLE      BenchmarkTests;
+
+  Framework = NULL;
+
+  DEBUG ((DEBUG_INFO, "%a v%a\n", UNIT_TEST_APP_NAME, UNIT_TEST_APP_VERSION));
+
+  //
+  // Start setting up the test framework for running the tests.
+  //
+  Status = InitUnitTestFramework (&Framework, UNIT_TEST_APP_NAME, gEfiCallerBaseName, UNIT_TEST_APP_VERSION);
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_ERROR, "Failed in InitUnitTestFramework. Status = %r\n", Status));
+    goto EXIT;
+  }
+
+  Status = CreateUnitTestSuite (&BltTests, Framework, "FrameBufferBltLib Blt Tests", "FrameBufferBltLib.Blt", NULL, NULL);
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_ERROR, "Failed in CreateUnitTestSuite for FrameBufferBltLib Blt Tests\n"));
+    Status = EFI_OUT_OF_RESOURCES;
+    goto EXIT;
+  }
+
+  AddTestCase (BltTests, "Round trip RGBx", "RoundTripRgb", BufferToVideoRoundTripShouldMatch, NULL, NULL, &mRgbFormat);
+  AddTestCase (BltTests, "Round trip BGRx", "RoundTripBgr", BufferToVideoRoundTripShouldMatch, NULL, NULL, &mBgrFormat);
+  AddTestCase (BltTests, "Round trip 8:8:8 bit mask", "RoundTrip888", BufferToVideoRoundTripShouldMatch, NULL, NULL, &mBitMask888Format);
+  AddTestCase (BltTests, "Round trip 5:6:5 bit mask", "RoundTrip565", BufferToVideoRoundTripShouldMatch, NULL, NULL, &mBitMask565Format);
+  AddTestCase (BltTests, "Scroll BGRx", "ScrollBgr", VideoToVideoScrollShouldMatch, NULL, NULL, &mBgrFormat);
+  AddTestCase (BltTests, "Scroll 5:6:5 bit mask", "Scroll565", VideoToVideoScrollShouldMatch, NULL, NULL, &mBitMask565Format);
+
+  Status = CreateUnitTestSuite (&BenchmarkTests, Framework, "FrameBufferBltLib Benchmark", "FrameBufferBltLib.Benchmark", NULL, NULL);
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_ERROR, "Failed in CreateUnitTestSuite for FrameBufferBltLib Benchmark\n"));
+    Status = EFI_OUT_OF_RESOURCES;
+    goto EXIT;
+  }
+
+  AddTestCase (BenchmarkTests, "Full screen RGBx", "BenchmarkRgb", BenchmarkFullScreenBlt, NULL, NULL, &mRgbFormat);
+  AddTestCase (BenchmarkTests, "Full screen BGRx", "BenchmarkBgr", BenchmarkFullScreenBlt, NULL, NULL, &mBgrFormat);
+  AddTestCase (BenchmarkTests, "Full screen 8:8:8 bit mask", "Benchmark888", BenchmarkFullScreenBlt, NULL, NULL, &mBitMask888Format);
+
+  //
+  // Execute the tests.
+  //
+  Status = RunAllTestSuites (Framework);
+
+EXIT:
+  if (Framework) {
+    FreeUnitTestFramework (Framework);
+  }
+
+  return Status;
+}
+
+///
+/// Avoid ECC error for function name that starts with lower case letter
+///
+#define FrameBufferBltLibUnitTestMain  main
+
+/**
+  Standard POSIX C entry point for host based unit test execution.
+
+  @param[in] Argc  Number of arguments
+  @param[in] Argv  Array of pointers to arguments
+
+  @retval 0      Success
+  @retval other  Error
+**/
+INT32
+FrameBufferBltLibUnitTestMain (
+  IN INT32  Argc,
+  IN CHAR8  *Argv[]
+  )
+{
+  UnitTestingEntry ();
+  return 0;
+}
@@ -92,6 +92,14 @@ EFI_NARROW_GLYPH  mCursorGlyph = {
 
 CHAR16  SpaceStr[] = { NARROW_CHAR, ' ', 0 };
 
+//
+// Monochrome bitmaps of the glyphs rendered by HII Font protocol, one byte per glyph row.
+//
+UINT8       mGlyphCache[GLYPH_CACHE_SIZE][EFI_GLYPH_HEIGHT];
+UINT8       mGlyphCacheState[GLYPH_CACHE_SIZE];
+BOOLEAN     mGlyphCacheNotifyRegistered = FALSE;
+EFI_HANDLE  mGlyphCacheNotifyHandle[6];
+
 EFI_DRIVER_BINDING_PROTOCOL  gGraphicsConsoleDriverBinding = {
   GraphicsConsoleControllerDriverSupported,
   GraphicsConsoleControllerDriverStart,
@@ -1756,6 +1764,155 @@ GetTextColors (
   return EFI_SUCCESS;
 }
 
+/**
+  HII Database package notification function to invalidate the glyph cache
+  when a font package is added, updated or removed.
+
+  @param  PackageType           Package type of the notification.
+  @param  PackageGuid           If PackageType is EFI_HII_PACKAGE_TYPE_GUID, then this is
+                                the pointer to the GUID from the Guid field of
+                                EFI_HII_PACKAGE_GUID_HEADER. Otherwise, it must be NULL.
+  @param  Package               Points to the package referred to by the notification.
+  @param  Handle                The handle of the package list which contains the specified package.
+  @param  NotifyType            The type of change concerning the database.
+
+  @retval EFI_SUCCESS           The glyph cache is invalidated.
+
+**/
+EFI_STATUS
+EFIAPI
+GlyphCacheFontPackageNotify (
+  IN UINT8                         PackageType,
+  IN CONST EFI_GUID                *PackageGuid,
+  IN CONST EFI_HII_PACKAGE_HEADER  *Package,
+  IN EFI_HII_HANDLE                Handle,
+  IN EFI_HII_DATABASE_NOTIFY_TYPE  NotifyType
+  )
+{
+  ZeroMem (mGlyphCacheState, sizeof (mGlyphCacheState));
+  return EFI_SUCCESS;
+}
+
+/**
+  Get the glyph of a character from the glyph cache.
+
+  The glyph is rendered by HII Font protocol on the first use and cached as a
+  monochrome bitmap. Only narrow glyphs that exactly fill one text cell are cached.
+
+  @param  Char                  The character to look up.
+
+  @retval TRUE                  The glyph of Char is in mGlyphCache.
+  @retval FALSE                 The glyph of Char cannot be cached.
+
+**/
+BOOLEAN
+GetCachedGlyph (
+  IN  CHAR16  Char
+  )
+{
+  EFI_STATUS                     Status;
+  UINT8                          PackageTypes[2];
+  EFI_HII_DATABASE_NOTIFY_TYPE   NotifyTypes[3];
+  UINTN                          Index;
+  CHAR16                         String[2];
+  EFI_FONT_DISPLAY_INFO          FontInfo;
+  EFI_GRAPHICS_OUTPUT_BLT_PIXEL  Bitmap[EFI_GLYPH_HEIGHT][EFI_GLYPH_WIDTH];
+  EFI_IMAGE_OUTPUT               Image;
+  EFI_IMAGE_OUTPUT               *Blt;
+  EFI_HII_ROW_INFO               *RowInfoArray;
+  UINTN                          RowInfoArraySize;
+  UINTN                          PosX;
+  UINTN                          PosY;
+
+  if (Char >= GLYPH_CACHE_SIZE) {
+    return FALSE;
+  }
+
+  if (mGlyphCacheState[Char] != GLYPH_CACHE_STATE_UNKNOWN) {
+    return (BOOLEAN)(mGlyphCacheState[Char] == GLYPH_CACHE_STATE_VALID);
+  }
+
+  if (!mGlyphCacheNotifyRegistered) {
+    //
+    // The cached glyphs become stale when the fonts in HII database change.
+    //
+    PackageTypes[0] = EFI_HII_PACKAGE_FONTS;
+    PackageTypes[1] = EFI_HII_PACKAGE_SIMPLE_FONTS;
+    NotifyTypes[0]  = EFI_HII_DATABASE_NOTIFY_NEW_PACK;
+    NotifyTypes[1]  = EFI_HII_DATABASE_NOTIFY_ADD_PACK;
+    NotifyTypes[2]  = EFI_HII_DATABASE_NOTIFY_REMOVE_PACK;
+    for (Index = 0; Index < ARRAY_SIZE (mGlyphCacheNotifyHandle); Index++) {
+      Status = mHiiDatabase->RegisterPackageNotify (
+                               mHiiDatabase,
+                               PackageTypes[Index / ARRAY_SIZE (NotifyTypes)],
+                               NULL,
+                               GlyphCacheFontPackageNotify,
+                               NotifyTypes[Index % ARRAY_SIZE (NotifyTypes)],
+                               &mGlyphCacheNotifyHandle[Index]
+                               );
+      if (EFI_ERROR (Status)) {
+        while (Index-- > 0) {
+          mHiiDatabase->UnregisterPackageNotify (mHiiDatabase, mGlyphCacheNotifyHandle[Index]);
+        }
+
+        return FALSE;
+      }
+    }
+
+    mGlyphCacheNotifyRegistered = TRUE;
+  }
+
+  mGlyphCacheState[Char] = GLYPH_CACHE_STATE_UNCACHEABLE;
+
+  //
+  // Render the character in white on black to get its monochrome bitmap.
+  //
+  String[0] = Char;
+  String[1] = L'\0';
+  ZeroMem (&FontInfo, sizeof (FontInfo));
+  SetMem (&FontInfo.ForegroundColor, sizeof (FontInfo.ForegroundColor), 0xFF);
+  ZeroMem (Bitmap, sizeof (Bitmap));
+  Image.Width        = EFI_GLYPH_WIDTH;
+  Image.Height       = EFI_GLYPH_HEIGHT;
+  Image.Image.Bitmap = &Bitmap[0][0];
+  Blt                = &Image;
+  RowInfoArray       = NULL;
+  RowInfoArraySize   = 0;
+
+  Status = mHiiFont->StringToImage (
+                       mHiiFont,
+                       EFI_HII_IGNORE_IF_NO_GLYPH | EFI_HII_IGNORE_LINE_BREAK,
+                       String,
+                       &FontInfo,
+                       &Blt,
+                       0,
+                       0,
+                       &RowInfoArray,
+                       &RowInfoArraySize,
+                       NULL
+                       );
+  if ((Status == EFI_SUCCESS) && (RowInfoArraySize == 1) &&
+      (RowInfoArray[0].LineWidth == EFI_GLYPH_WIDTH) && (RowInfoArray[0].LineHeight == EFI_GLYPH_HEIGHT))
+  {
+    for (PosY = 0; PosY < EFI_GLYPH_HEIGHT; PosY++) {
+      mGlyphCache[Char][PosY] = 0;
+      for (PosX = 0; PosX < EFI_GLYPH_WIDTH; PosX++) {
+        if (Bitmap[PosY][PosX].Blue != 0) {
+          mGlyphCache[Char][PosY] |= (UINT8)(BIT7 >> PosX);
+        }
+      }
+    }
+
+    mGlyphCacheState[Char] = GLYPH_CACHE_STATE_VALID;
+  }
+
+  if (RowInfoArray != NULL) {
+    FreePool (RowInfoArray);
+  }
+
+  return (BOOLEAN)(mGlyphCacheState[Char] == GLYPH_CACHE_STATE_VALID);
+}
+
 /**
   Draw Unicode string on the Graphics Console device's screen.
 
@@ -1776,17 +1933,64 @@ DrawUnicodeWeightAtCursorN (
   IN  UINTN                            Count
   )
 {
-  EFI_STATUS             Status;
-  GRAPHICS_CONSOLE_DEV   *Private;
-  EFI_IMAGE_OUTPUT       *Blt;
-  EFI_STRING             String;
-  EFI_FONT_DISPLAY_INFO  *FontInfo;
-  EFI_UGA_DRAW_PROTOCOL  *UgaDraw;
-  EFI_HII_ROW_INFO       *RowInfoArray;
-  UINTN                  RowInfoArraySize;
+  EFI_STATUS                     Status;
+  GRAPHICS_CONSOLE_DEV           *Private;
+  EFI_IMAGE_OUTPUT               *Blt;
+  EFI_STRING                     String;
+  EFI_FONT_DISPLAY_INFO          *FontInfo;
+  EFI_UGA_DRAW_PROTOCOL          *UgaDraw;
+  EFI_HII_ROW_INFO               *RowInfoArray;
+  UINTN                          RowInfoArraySize;
+  EFI_GRAPHICS_OUTPUT_BLT_PIXEL  Foreground;
+  EFI_GRAPHICS_OUTPUT_BLT_PIXEL  Background;
+  EFI_GRAPHICS_OUTPUT_BLT_PIXEL  *Pixel;
+  UINTN                          Index;
+  UINTN                          Width;
+  UINTN                          PosX;
+  UINTN                          PosY;
 
   Private = GRAPHICS_CONSOLE_CON_OUT_DEV_FROM_THIS (This);
-  Blt     = (EFI_IMAGE_OUTPUT *)AllocateZeroPool (sizeof (EFI_IMAGE_OUTPUT));
+
+  if ((Private->GraphicsOutput != NULL) && (Private->LineBuffer != NULL) && (Count != 0)) {
+    //
+    // When all glyphs are cached, compose the string in LineBuffer and draw it with
+    // one Blt, without looking up and rendering each glyph through HII Font protocol.
+    // The string always fits in the line, so it fits in LineBuffer.
+    //
+    for (Index = 0; Index < Count; Index++) {
+      if (!GetCachedGlyph (UnicodeWeight[Index])) {
+        break;
+      }
+    }
+
+    if (Index == Count) {
+      GetTextColors (This, &Foreground, &Background);
+      Width = Count * EFI_GLYPH_WIDTH;
+      for (Index = 0; Index < Count; Index++) {
+        for (PosY = 0; PosY < EFI_GLYPH_HEIGHT; PosY++) {
+          Pixel = &Private->LineBuffer[PosY * Width + Index * EFI_GLYPH_WIDTH];
+          for (PosX = 0; PosX < EFI_GLYPH_WIDTH; PosX++) {
+            Pixel[PosX] = ((mGlyphCache[UnicodeWeight[Index]][PosY] & (BIT7 >> PosX)) != 0) ? Foreground : Background;
+          }
+        }
+      }
+
+      return Private->GraphicsOutput->Blt (
+                                        Private->GraphicsOutput,
+                                        Private->LineBuffer,
+                                        EfiBltBufferToVideo,
+                                        0,
+                                        0,
+                                        This->Mode->CursorColumn * EFI_GLYPH_WIDTH + Private->ModeData[This->Mode->Mode].DeltaX,
+                                        This->Mode->CursorRow * EFI_GLYPH_HEIGHT + Private->ModeData[This->Mode->Mode].DeltaY,
+                                        Width,
+                                        EFI_GLYPH_HEIGHT,
+                                        Width * sizeof (EFI_GRAPHICS_OUTPUT_BLT_PIXEL)
+                                        );
+    }
+  }
+
+  Blt = (EFI_IMAGE_OUTPUT *)AllocateZeroPool (sizeof (EFI_IMAGE_OUTPUT));
   if (Blt == NULL) {
     return EFI_OUT_OF_RESOURCES;
   }
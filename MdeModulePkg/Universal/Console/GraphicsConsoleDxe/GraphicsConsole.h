@@ -41,6 +41,15 @@ typedef union {
   EFI_WIDE_GLYPH      WideGlyph;
 } GLYPH_UNION;
 
+//
+// Glyph cache covers the characters below GLYPH_CACHE_SIZE.
+//
+#define GLYPH_CACHE_SIZE  0x80
+
+#define GLYPH_CACHE_STATE_UNKNOWN      0
+#define GLYPH_CACHE_STATE_VALID        1
+#define GLYPH_CACHE_STATE_UNCACHEABLE  2
+
 //
 // Device Structure
 //
@@ -538,6 +547,48 @@ DrawUnicodeWeightAtCursorN (
   IN  UINTN                            Count
   );
 
+/**
+  HII Database package notification function to invalidate the glyph cache
+  when a font package is added, updated or removed.
+
+  @param  PackageType           Package type of the notification.
+  @param  PackageGuid           If PackageType is EFI_HII_PACKAGE_TYPE_GUID, then this is
+                                the pointer to the GUID from the Guid field of
+                                EFI_HII_PACKAGE_GUID_HEADER. Otherwise, it must be NULL.
+  @param  Package               Points to the package referred to by the notification.
+  @param  Handle                The handle of the package list which contains the specified package.
+  @param  NotifyType            The type of change concerning the database.
+
+  @retval EFI_SUCCESS           The glyph cache is invalidated.
+
+**/
+EFI_STATUS
+EFIAPI
+GlyphCacheFontPackageNotify (
+  IN UINT8                         PackageType,
+  IN CONST EFI_GUID                *PackageGuid,
+  IN CONST EFI_HII_PACKAGE_HEADER  *Package,
+  IN EFI_HII_HANDLE                Handle,
+  IN EFI_HII_DATABASE_NOTIFY_TYPE  NotifyType
+  );
+
+/**
+  Get the glyph of a character from the glyph cache.
+
+  The glyph is rendered by HII Font protocol on the first use and cached as a
+  monochrome bitmap. Only narrow glyphs that exactly fill one text cell are cached.
+
+  @param  Char                  The character to look up.
+
+  @retval TRUE                  The glyph of Char is in mGlyphCache.
+  @retval FALSE                 The glyph of Char cannot be cached.
+
+**/
+BOOLEAN
+GetCachedGlyph (
+  IN  CHAR16  Char
+  );
+
 /**
   Flush the cursor on the screen.
 
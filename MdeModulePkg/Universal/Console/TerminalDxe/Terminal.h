@@ -38,6 +38,12 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 #define RAW_FIFO_MAX_NUMBER  255
 #define FIFO_MAX_NUMBER      128
 
+//
+// Size of the buffer OutputString() collects the translated bytes in before
+// handing them to the serial device.
+//
+#define TERMINAL_OUTPUT_BUFFER_SIZE  128
+
 typedef struct {
   UINT8    Head;
   UINT8    Tail;
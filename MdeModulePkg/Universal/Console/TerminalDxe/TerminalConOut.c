@@ -147,6 +147,37 @@ TerminalConOutReset (
   return Status;
 }
 
+/**
+  Write the bytes collected by TerminalConOutOutputString() to the serial device.
+
+  @param  TerminalDevice    The terminal device to write to.
+  @param  Buffer            The bytes to write.
+  @param  Length            On input, the number of bytes in Buffer.
+                            On output, 0.
+
+  @retval EFI_SUCCESS       The bytes were written, or Length was 0.
+  @retval Others            The serial device failed to write the bytes.
+
+**/
+STATIC
+EFI_STATUS
+TerminalConOutFlushOutput (
+  IN     TERMINAL_DEV  *TerminalDevice,
+  IN     CHAR8         *Buffer,
+  IN OUT UINTN         *Length
+  )
+{
+  EFI_STATUS  Status;
+
+  if (*Length == 0) {
+    return EFI_SUCCESS;
+  }
+
+  Status  = TerminalDevice->SerialIo->Write (TerminalDevice->SerialIo, Length, Buffer);
+  *Length = 0;
+  return Status;
+}
+
 /**
   Implements EFI_SIMPLE_TEXT_OUTPUT_PROTOCOL.OutputString().
 
@@ -181,7 +212,7 @@ TerminalConOutOutputString (
   CHAR8                        AsciiChar;
   EFI_STATUS                   Status;
   UINT8                        ValidBytes;
-  CHAR8                        CrLfStr[2];
+  CHAR8                        OutputBuffer[TERMINAL_OUTPUT_BUFFER_SIZE];
   //
   //  flag used to indicate whether condition happens which will cause
   //  return EFI_WARN_UNKNOWN_GLYPH
@@ -191,6 +222,7 @@ TerminalConOutOutputString (
   ValidBytes = 0;
   Warning    = FALSE;
   AsciiChar  = 0;
+  Length     = 0;
 
   //
   //  get Terminal device data structure pointer.
@@ -251,32 +283,13 @@ TerminalConOutOutputString (
           GraphicChar = AsciiChar;
         }
 
-        Length = 1;
-
-        Status = TerminalDevice->SerialIo->Write (
-                                             TerminalDevice->SerialIo,
-                                             &Length,
-                                             &GraphicChar
-                                             );
-
-        if (EFI_ERROR (Status)) {
-          goto OutputError;
-        }
-
+        OutputBuffer[Length++] = GraphicChar;
         break;
 
       case TerminalTypeVtUtf8:
         UnicodeToUtf8 (*WString, &Utf8Char, &ValidBytes);
-        Length = ValidBytes;
-        Status = TerminalDevice->SerialIo->Write (
-                                             TerminalDevice->SerialIo,
-                                             &Length,
-                                             (UINT8 *)&Utf8Char
-                                             );
-        if (EFI_ERROR (Status)) {
-          goto OutputError;
-        }
-
+        CopyMem (&OutputBuffer[Length], &Utf8Char, ValidBytes);
+        Length += ValidBytes;
         break;
     }
 
@@ -322,25 +335,29 @@ TerminalConOutOutputString (
             // the driver, but only if we're not in the middle of
             // printing an escape sequence.
             //
-            CrLfStr[0] = '\r';
-            CrLfStr[1] = '\n';
-
-            Length = sizeof (CrLfStr);
-
-            Status = TerminalDevice->SerialIo->Write (
-                                                 TerminalDevice->SerialIo,
-                                                 &Length,
-                                                 CrLfStr
-                                                 );
-
-            if (EFI_ERROR (Status)) {
-              goto OutputError;
-            }
+            OutputBuffer[Length++] = '\r';
+            OutputBuffer[Length++] = '\n';
           }
         }
 
         break;
     }
+
+    //
+    // Write the collected bytes out once there may not be room left for the
+    // next character, which takes at most a UTF-8 sequence followed by CR LF.
+    //
+    if (Length > sizeof (OutputBuffer) - sizeof (UTF8_CHAR) - 2) {
+      Status = TerminalConOutFlushOutput (TerminalDevice, OutputBuffer, &Length);
+      if (EFI_ERROR (Status)) {
+        goto OutputError;
+      }
+    }
+  }
+
+  Status = TerminalConOutFlushOutput (TerminalDevice, OutputBuffer, &Length);
+  if (EFI_ERROR (Status)) {
+    goto OutputError;
   }
 
   if (Warning) {
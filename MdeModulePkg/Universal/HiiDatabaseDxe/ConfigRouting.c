@@ -9,6 +9,8 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 #include "HiiDatabase.h"
 extern HII_DATABASE_PRIVATE_DATA  mPrivate;
 
+GLOBAL_REMOVE_IF_UNREFERENCED CONST CHAR16  mHexDigit[] = L"0123456789abcdef";
+
 /**
   Calculate the number of Unicode characters of the incoming Configuration string,
   not including NULL terminator.
@@ -389,6 +391,99 @@ OutputConfigBody (
   return EFI_SUCCESS;
 }
 
+/**
+  Get the buffer size of a multi-string built by AppendToMultiString(). The
+  buffer starts with MAX_STRING_LENGTH bytes and its size is doubled each time
+  it needs to be enlarged.
+
+  This is a internal function.
+
+  @param  StringSize             Size of the multi-string in bytes, including the
+                                 NULL terminator.
+
+  @return The size of the buffer that holds the multi-string, in bytes.
+
+**/
+STATIC
+UINTN
+GetMultiStringBufferSize (
+  IN UINTN  StringSize
+  )
+{
+  UINTN  BufferSize;
+
+  BufferSize = MAX_STRING_LENGTH;
+  while (BufferSize < StringSize) {
+    BufferSize *= 2;
+  }
+
+  return BufferSize;
+}
+
+/**
+  Append a string of known length to a multi-string format of known length.
+
+  This is a internal function.
+
+  @param  MultiString            String in <MultiConfigRequest>,
+                                 <MultiConfigAltResp>, or <MultiConfigResp>. On
+                                 input, the buffer length of this string is
+                                 MAX_STRING_LENGTH or the buffer size returned by
+                                 GetMultiStringBufferSize(). On output, the buffer
+                                 length might be updated.
+  @param  MultiStringLength      On input, the length of MultiString in characters.
+                                 On output, the length of the appended MultiString.
+  @param  AppendString           Unicode string to append. It does not need to
+                                 be NULL terminated.
+  @param  AppendStringLength     The number of characters of AppendString to append.
+
+  @retval EFI_OUT_OF_RESOURCES   The buffer of MultiString cannot be enlarged.
+                                 MultiString is not changed.
+  @retval EFI_SUCCESS            AppendString is append to the end of MultiString
+
+**/
+STATIC
+EFI_STATUS
+AppendToMultiStringWithLength (
+  IN OUT EFI_STRING    *MultiString,
+  IN OUT UINTN         *MultiStringLength,
+  IN     CONST CHAR16  *AppendString,
+  IN     UINTN         AppendStringLength
+  )
+{
+  UINTN       OldBufferSize;
+  UINTN       NewBufferSize;
+  EFI_STRING  NewMultiString;
+
+  //
+  // Enlarge the buffer by doubling its size, so that appending many short
+  // strings does not copy the whole multi-string each time.
+  //
+  OldBufferSize = GetMultiStringBufferSize ((*MultiStringLength + 1) * sizeof (CHAR16));
+  NewBufferSize = GetMultiStringBufferSize ((*MultiStringLength + AppendStringLength + 1) * sizeof (CHAR16));
+  if (NewBufferSize > OldBufferSize) {
+    NewMultiString = (EFI_STRING)ReallocatePool (
+                                   (*MultiStringLength + 1) * sizeof (CHAR16),
+                                   NewBufferSize,
+                                   (VOID *)(*MultiString)
+                                   );
+    if (NewMultiString == NULL) {
+      return EFI_OUT_OF_RESOURCES;
+    }
+
+    *MultiString = NewMultiString;
+  }
+
+  //
+  // Append the incoming string
+  //
+  CopyMem (*MultiString + *MultiStringLength, AppendString, AppendStringLength * sizeof (CHAR16));
+  *MultiStringLength                += AppendStringLength;
+  (*MultiString)[*MultiStringLength] = L'\0';
+
+  return EFI_SUCCESS;
+}
+
 /**
   Append a string to a multi-string format.
 
@@ -402,6 +497,7 @@ OutputConfigBody (
   @param  AppendString           NULL-terminated Unicode string.
 
   @retval EFI_INVALID_PARAMETER  Any incoming parameter is invalid.
+  @retval EFI_OUT_OF_RESOURCES   The buffer of MultiString cannot be enlarged.
   @retval EFI_SUCCESS            AppendString is append to the end of MultiString
 
 **/
@@ -411,39 +507,14 @@ AppendToMultiString (
   IN EFI_STRING      AppendString
   )
 {
-  UINTN  AppendStringSize;
-  UINTN  MultiStringSize;
-  UINTN  MaxLen;
+  UINTN  MultiStringLength;
 
   if ((MultiString == NULL) || (*MultiString == NULL) || (AppendString == NULL)) {
     return EFI_INVALID_PARAMETER;
   }
 
-  AppendStringSize = StrSize (AppendString);
-  MultiStringSize  = StrSize (*MultiString);
-  MaxLen           = MAX_STRING_LENGTH / sizeof (CHAR16);
-
-  //
-  // Enlarge the buffer each time when length exceeds MAX_STRING_LENGTH.
-  //
-  if ((MultiStringSize + AppendStringSize > MAX_STRING_LENGTH) ||
-      (MultiStringSize > MAX_STRING_LENGTH))
-  {
-    *MultiString = (EFI_STRING)ReallocatePool (
-                                 MultiStringSize,
-                                 MultiStringSize + AppendStringSize,
-                                 (VOID *)(*MultiString)
-                                 );
-    MaxLen = (MultiStringSize + AppendStringSize) / sizeof (CHAR16);
-    ASSERT (*MultiString != NULL);
-  }
-
-  //
-  // Append the incoming string
-  //
-  StrCatS (*MultiString, MaxLen, AppendString);
-
-  return EFI_SUCCESS;
+  MultiStringLength = StrLen (*MultiString);
+  return AppendToMultiStringWithLength (MultiString, &MultiStringLength, AppendString, StrLen (AppendString));
 }
 
 /**
@@ -5678,11 +5749,10 @@ HiiBlockToConfig (
   UINT8                      *TmpBuffer;
   UINTN                      Offset;
   UINTN                      Width;
-  UINT8                      *Value;
-  EFI_STRING                 ValueStr;
   EFI_STRING                 ConfigElement;
+  UINTN                      ConfigLength;
   UINTN                      Index;
-  UINT8                      *TemBuffer;
+  CONST UINT8                *TemBuffer;
   CHAR16                     *TemString;
 
   TmpBuffer = NULL;
@@ -5700,9 +5770,8 @@ HiiBlockToConfig (
   ASSERT (Private != NULL);
 
   StringPtr     = ConfigRequest;
-  ValueStr      = NULL;
-  Value         = NULL;
   ConfigElement = NULL;
+  ConfigLength  = 0;
 
   //
   // Allocate a fix length of memory to store Results. Reallocate memory for
@@ -5753,15 +5822,12 @@ HiiBlockToConfig (
   //
   // Copy <ConfigHdr> and an additional '&' to <ConfigResp>
   //
-  TemString = AllocateCopyPool (sizeof (CHAR16) * (StringPtr - ConfigRequest + 1), ConfigRequest);
-  if (TemString == NULL) {
-    return EFI_OUT_OF_RESOURCES;
+  Status = AppendToMultiStringWithLength (Config, &ConfigLength, ConfigRequest, StringPtr - ConfigRequest);
+  if (EFI_ERROR (Status)) {
+    *Progress = ConfigRequest;
+    goto Exit;
   }
 
-  TemString[StringPtr - ConfigRequest] = '\0';
-  AppendToMultiString (Config, TemString);
-  FreePool (TemString);
-
   //
   // Parse each <RequestElement> if exists
   // Only <BlockName> format is supported by this help function.
@@ -5833,64 +5899,45 @@ HiiBlockToConfig (
       goto Exit;
     }
 
-    Value = (UINT8 *)AllocateZeroPool (Width);
-    if (Value == NULL) {
+    //
+    // Build a ConfigElement: <BlockName>&VALUE=<Number>, with the value of the
+    // block converted to hex string starting from its most significant byte.
+    //
+    Length        = StringPtr - TmpPtr + StrLen (L"&VALUE=") + Width * 2;
+    ConfigElement = (EFI_STRING)AllocatePool ((Length + 1) * sizeof (CHAR16));
+    if (ConfigElement == NULL) {
       *Progress = ConfigRequest;
       Status    = EFI_OUT_OF_RESOURCES;
       goto Exit;
     }
 
-    CopyMem (Value, (UINT8 *)Block + Offset, Width);
+    CopyMem (ConfigElement, TmpPtr, (StringPtr - TmpPtr) * sizeof (CHAR16));
+    TemString = ConfigElement + (StringPtr - TmpPtr);
+    CopyMem (TemString, L"&VALUE=", StrLen (L"&VALUE=") * sizeof (CHAR16));
+    TemString += StrLen (L"&VALUE=");
 
-    Length   = Width * 2 + 1;
-    ValueStr = (EFI_STRING)AllocateZeroPool (Length  * sizeof (CHAR16));
-    if (ValueStr == NULL) {
-      *Progress = ConfigRequest;
-      Status    = EFI_OUT_OF_RESOURCES;
-      goto Exit;
+    TemBuffer = Block + Offset + Width;
+    for (Index = 0; Index < Width; Index++) {
+      TemBuffer--;
+      *TemString++ = mHexDigit[*TemBuffer >> 4];
+      *TemString++ = mHexDigit[*TemBuffer & 0xF];
     }
 
-    TemString = ValueStr;
-    TemBuffer = Value + Width - 1;
-    for (Index = 0; Index < Width; Index++, TemBuffer--) {
-      UnicodeValueToStringS (
-        TemString,
-        Length  * sizeof (CHAR16) - ((UINTN)TemString - (UINTN)ValueStr),
-        PREFIX_ZERO | RADIX_HEX,
-        *TemBuffer,
-        2
-        );
-      TemString += StrnLenS (TemString, Length - ((UINTN)TemString - (UINTN)ValueStr) / sizeof (CHAR16));
-    }
-
-    FreePool (Value);
-    Value = NULL;
-
     //
-    // Build a ConfigElement
+    // If not the last <BlockName>, keep the '&' that separates it from the next one.
     //
-    Length       += StringPtr - TmpPtr + 1 + StrLen (L"VALUE=");
-    ConfigElement = (EFI_STRING)AllocateZeroPool (Length * sizeof (CHAR16));
-    if (ConfigElement == NULL) {
-      Status = EFI_OUT_OF_RESOURCES;
-      goto Exit;
+    if (*StringPtr != 0) {
+      *TemString = L'&';
+      Length++;
     }
 
-    CopyMem (ConfigElement, TmpPtr, (StringPtr - TmpPtr + 1) * sizeof (CHAR16));
-    if (*StringPtr == 0) {
-      *(ConfigElement + (StringPtr - TmpPtr)) = L'&';
-    }
-
-    *(ConfigElement + (StringPtr - TmpPtr) + 1) = 0;
-    StrCatS (ConfigElement, Length, L"VALUE=");
-    StrCatS (ConfigElement, Length, ValueStr);
-
-    AppendToMultiString (Config, ConfigElement);
-
+    Status = AppendToMultiStringWithLength (Config, &ConfigLength, ConfigElement, Length);
     FreePool (ConfigElement);
-    FreePool (ValueStr);
     ConfigElement = NULL;
-    ValueStr      = NULL;
+    if (EFI_ERROR (Status)) {
+      *Progress = ConfigRequest;
+      goto Exit;
+    }
 
     //
     // If '\0', parsing is finished. Otherwise skip '&' to continue
@@ -5899,7 +5946,6 @@ HiiBlockToConfig (
       break;
     }
 
-    AppendToMultiString (Config, L"&");
     StringPtr++;
   }
 
@@ -5919,14 +5965,6 @@ Exit:
     *Config = NULL;
   }
 
-  if (ValueStr != NULL) {
-    FreePool (ValueStr);
-  }
-
-  if (Value != NULL) {
-    FreePool (Value);
-  }
-
   if (ConfigElement != NULL) {
     FreePool (ConfigElement);
   }
@@ -1619,6 +1619,7 @@ AdjustStringPackage (
       //
       *BlockPtr = EFI_HII_SIBT_END;
       FreePool (StringPackage->StringBlock);
+      InvalidateStringBlockIndex (StringPackage);
       StringPackage->StringBlock                  = StringBlock;
       StringPackage->StringPkgHdr->Header.Length += Skip2BlockSize;
       PackageList->PackageListHdr.PackageLength  += Skip2BlockSize;
@@ -1758,6 +1759,7 @@ RemoveStringPackages (
 
     RemoveEntryList (&Package->StringEntry);
     PackageList->PackageListHdr.PackageLength -= Package->StringPkgHdr->Header.Length;
+    InvalidateStringBlockIndex (Package);
     FreePool (Package->StringBlock);
     FreePool (Package->StringPkgHdr);
     //
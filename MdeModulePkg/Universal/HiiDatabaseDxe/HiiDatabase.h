@@ -150,6 +150,15 @@ typedef struct {
 // String Package definitions
 //
 #define HII_STRING_PACKAGE_SIGNATURE  SIGNATURE_32 ('h','i','s','p')
+//
+// One entry of the string block index of a string package, recorded for each
+// string block that defines at least one string ID.
+//
+typedef struct {
+  EFI_STRING_ID    StartStringId;                      // first string ID of the block
+  UINT32           BlockOffset;                        // offset of the block in StringBlock
+} HII_STRING_BLOCK_INDEX;
+
 typedef struct _HII_STRING_PACKAGE_INSTANCE {
   UINTN                         Signature;
   EFI_HII_STRING_PACKAGE_HDR    *StringPkgHdr;
@@ -158,6 +167,8 @@ typedef struct _HII_STRING_PACKAGE_INSTANCE {
   LIST_ENTRY                    FontInfoList;          // local font info list
   UINT8                         FontId;
   EFI_STRING_ID                 MaxStringId;           // record StringId
+  HII_STRING_BLOCK_INDEX        *StringBlockIndex;     // built on demand by FindStringBlock
+  UINTN                         StringBlockIndexCount;
 } HII_STRING_PACKAGE_INSTANCE;
 
 //
@@ -535,6 +546,19 @@ FindStringBlock (
   OUT EFI_STRING_ID                *StartStringId OPTIONAL
   );
 
+/**
+  Free the string block index of a string package. This must be called whenever
+  the string blocks of the package are changed, so that the index is rebuilt
+  from the new string blocks by the next FindStringBlock() call.
+
+  @param  StringPackage           Hii string package instance.
+
+**/
+VOID
+InvalidateStringBlockIndex (
+  IN OUT HII_STRING_PACKAGE_INSTANCE  *StringPackage
+  );
+
 /**
   Parse all glyph blocks to find a glyph block specified by CharValue.
   If CharValue = (CHAR16) (-1), collect all default character cell information
@@ -225,6 +225,284 @@ GetStringFontInfo (
   return EFI_NOT_FOUND;
 }
 
+/**
+  Get the size of a string block and the number of string IDs it defines.
+
+  @param  BlockHdr                The string block.
+  @param  BlockSize               Output the size of the string block.
+  @param  StringIdCount           Output the number of string IDs the block defines.
+
+  @retval TRUE                    The size of the block is known.
+  @retval FALSE                   The block type is unknown.
+
+**/
+STATIC
+BOOLEAN
+GetStringBlockSize (
+  IN  UINT8   *BlockHdr,
+  OUT UINTN   *BlockSize,
+  OUT UINT16  *StringIdCount
+  )
+{
+  UINT8                    *StringTextPtr;
+  UINTN                    StringSize;
+  UINTN                    Index;
+  UINT16                   StringCount;
+  UINT8                    Length8;
+  EFI_HII_SIBT_EXT2_BLOCK  Ext2;
+  UINT32                   Length32;
+
+  StringCount = 1;
+  switch (*BlockHdr) {
+    case EFI_HII_SIBT_STRING_SCSU:
+      StringTextPtr = BlockHdr + sizeof (EFI_HII_STRING_BLOCK);
+      *BlockSize    = StringTextPtr - BlockHdr + AsciiStrSize ((CHAR8 *)StringTextPtr);
+      break;
+
+    case EFI_HII_SIBT_STRING_SCSU_FONT:
+      StringTextPtr = BlockHdr + sizeof (EFI_HII_SIBT_STRING_SCSU_FONT_BLOCK) - sizeof (UINT8);
+      *BlockSize    = StringTextPtr - BlockHdr + AsciiStrSize ((CHAR8 *)StringTextPtr);
+      break;
+
+    case EFI_HII_SIBT_STRINGS_SCSU:
+    case EFI_HII_SIBT_STRINGS_SCSU_FONT:
+      if (*BlockHdr == EFI_HII_SIBT_STRINGS_SCSU) {
+        CopyMem (&StringCount, BlockHdr + sizeof (EFI_HII_STRING_BLOCK), sizeof (UINT16));
+        StringTextPtr = BlockHdr + sizeof (EFI_HII_SIBT_STRINGS_SCSU_BLOCK) - sizeof (UINT8);
+      } else {
+        CopyMem (&StringCount, BlockHdr + sizeof (EFI_HII_STRING_BLOCK) + sizeof (UINT8), sizeof (UINT16));
+        StringTextPtr = BlockHdr + sizeof (EFI_HII_SIBT_STRINGS_SCSU_FONT_BLOCK) - sizeof (UINT8);
+      }
+
+      for (Index = 0; Index < StringCount; Index++) {
+        StringTextPtr += AsciiStrSize ((CHAR8 *)StringTextPtr);
+      }
+
+      *BlockSize = StringTextPtr - BlockHdr;
+      break;
+
+    case EFI_HII_SIBT_STRING_UCS2:
+    case EFI_HII_SIBT_STRING_UCS2_FONT:
+      if (*BlockHdr == EFI_HII_SIBT_STRING_UCS2) {
+        StringTextPtr = BlockHdr + sizeof (EFI_HII_STRING_BLOCK);
+      } else {
+        StringTextPtr = BlockHdr + sizeof (EFI_HII_SIBT_STRING_UCS2_FONT_BLOCK) - sizeof (CHAR16);
+      }
+
+      GetUnicodeStringTextOrSize (NULL, StringTextPtr, &StringSize);
+      *BlockSize = StringTextPtr - BlockHdr + StringSize;
+      break;
+
+    case EFI_HII_SIBT_STRINGS_UCS2:
+    case EFI_HII_SIBT_STRINGS_UCS2_FONT:
+      if (*BlockHdr == EFI_HII_SIBT_STRINGS_UCS2) {
+        CopyMem (&StringCount, BlockHdr + sizeof (EFI_HII_STRING_BLOCK), sizeof (UINT16));
+        StringTextPtr = BlockHdr + sizeof (EFI_HII_SIBT_STRINGS_UCS2_BLOCK) - sizeof (CHAR16);
+      } else {
+        CopyMem (&StringCount, BlockHdr + sizeof (EFI_HII_STRING_BLOCK) + sizeof (UINT8), sizeof (UINT16));
+        StringTextPtr = BlockHdr + sizeof (EFI_HII_SIBT_STRINGS_UCS2_FONT_BLOCK) - sizeof (CHAR16);
+      }
+
+      for (Index = 0; Index < StringCount; Index++) {
+        GetUnicodeStringTextOrSize (NULL, StringTextPtr, &StringSize);
+        StringTextPtr += StringSize;
+      }
+
+      *BlockSize = StringTextPtr - BlockHdr;
+      break;
+
+    case EFI_HII_SIBT_DUPLICATE:
+      *BlockSize = sizeof (EFI_HII_SIBT_DUPLICATE_BLOCK);
+      break;
+
+    case EFI_HII_SIBT_SKIP1:
+      StringCount = *(BlockHdr + sizeof (EFI_HII_STRING_BLOCK));
+      *BlockSize  = sizeof (EFI_HII_SIBT_SKIP1_BLOCK);
+      break;
+
+    case EFI_HII_SIBT_SKIP2:
+      CopyMem (&StringCount, BlockHdr + sizeof (EFI_HII_STRING_BLOCK), sizeof (UINT16));
+      *BlockSize = sizeof (EFI_HII_SIBT_SKIP2_BLOCK);
+      break;
+
+    case EFI_HII_SIBT_EXT1:
+      CopyMem (&Length8, BlockHdr + sizeof (EFI_HII_STRING_BLOCK) + sizeof (UINT8), sizeof (UINT8));
+      StringCount = 0;
+      *BlockSize  = Length8;
+      break;
+
+    case EFI_HII_SIBT_EXT2:
+      CopyMem (&Ext2, BlockHdr, sizeof (EFI_HII_SIBT_EXT2_BLOCK));
+      StringCount = 0;
+      *BlockSize  = Ext2.Length;
+      break;
+
+    case EFI_HII_SIBT_EXT4:
+      CopyMem (&Length32, BlockHdr + sizeof (EFI_HII_STRING_BLOCK) + sizeof (UINT8), sizeof (UINT32));
+      StringCount = 0;
+      *BlockSize  = Length32;
+      break;
+
+    default:
+      return FALSE;
+  }
+
+  *StringIdCount = StringCount;
+  return (BOOLEAN)(*BlockSize != 0);
+}
+
+/**
+  Build the string block index of a string package. The index records the
+  first string ID and the offset of every string block that defines string
+  IDs, so that a string can be found without parsing all the string blocks
+  before it.
+
+  @param  StringPackage           Hii string package instance.
+
+  @retval EFI_SUCCESS             The index is built.
+  @retval EFI_NOT_FOUND           The package has no string, or a block cannot
+                                  be parsed.
+  @retval EFI_OUT_OF_RESOURCES    The system is out of resources to build the
+                                  index.
+
+**/
+STATIC
+EFI_STATUS
+BuildStringBlockIndex (
+  IN OUT HII_STRING_PACKAGE_INSTANCE  *StringPackage
+  )
+{
+  HII_STRING_BLOCK_INDEX  *BlockIndex;
+  UINTN                   Count;
+  UINTN                   Pass;
+  UINT8                   *BlockHdr;
+  UINTN                   BlockSize;
+  UINT16                  StringIdCount;
+  EFI_STRING_ID           CurrentStringId;
+
+  //
+  // Count the blocks in the first pass, record them in the second pass.
+  //
+  BlockIndex = NULL;
+  Count      = 0;
+  for (Pass = 0; Pass < 2; Pass++) {
+    if (Pass == 1) {
+      if (Count == 0) {
+        return EFI_NOT_FOUND;
+      }
+
+      BlockIndex = AllocatePool (Count * sizeof (HII_STRING_BLOCK_INDEX));
+      if (BlockIndex == NULL) {
+        return EFI_OUT_OF_RESOURCES;
+      }
+
+      Count = 0;
+    }
+
+    CurrentStringId = 1;
+    BlockHdr        = StringPackage->StringBlock;
+    while (*BlockHdr != EFI_HII_SIBT_END) {
+      if (!GetStringBlockSize (BlockHdr, &BlockSize, &StringIdCount)) {
+        if (BlockIndex != NULL) {
+          FreePool (BlockIndex);
+        }
+
+        return EFI_NOT_FOUND;
+      }
+
+      if (StringIdCount != 0) {
+        if (BlockIndex != NULL) {
+          BlockIndex[Count].StartStringId = CurrentStringId;
+          BlockIndex[Count].BlockOffset   = (UINT32)(BlockHdr - StringPackage->StringBlock);
+        }
+
+        Count++;
+      }
+
+      CurrentStringId = (EFI_STRING_ID)(CurrentStringId + StringIdCount);
+      BlockHdr       += BlockSize;
+    }
+  }
+
+  StringPackage->StringBlockIndex      = BlockIndex;
+  StringPackage->StringBlockIndexCount = Count;
+  return EFI_SUCCESS;
+}
+
+/**
+  Free the string block index of a string package. This must be called whenever
+  the string blocks of the package are changed, so that the index is rebuilt
+  from the new string blocks by the next FindStringBlock() call.
+
+  @param  StringPackage           Hii string package instance.
+
+**/
+VOID
+InvalidateStringBlockIndex (
+  IN OUT HII_STRING_PACKAGE_INSTANCE  *StringPackage
+  )
+{
+  if (StringPackage->StringBlockIndex != NULL) {
+    FreePool (StringPackage->StringBlockIndex);
+    StringPackage->StringBlockIndex      = NULL;
+    StringPackage->StringBlockIndexCount = 0;
+  }
+}
+
+/**
+  Look up the string block that defines StringId in the string block index of a
+  string package, building the index first if needed.
+
+  @param  StringPackage           Hii string package instance.
+  @param  StringId                The string's id.
+  @param  StartStringId           Output the first string id of the found block.
+  @param  BlockOffset             Output the offset of the found block.
+
+  @retval TRUE                    The block is found.
+  @retval FALSE                   The block is not found, or no index is
+                                  available. The outputs are not changed.
+
+**/
+STATIC
+BOOLEAN
+LookupStringBlockIndex (
+  IN OUT HII_STRING_PACKAGE_INSTANCE  *StringPackage,
+  IN     EFI_STRING_ID                StringId,
+  OUT    EFI_STRING_ID                *StartStringId,
+  OUT    UINTN                        *BlockOffset
+  )
+{
+  UINTN  Low;
+  UINTN  High;
+  UINTN  Middle;
+
+  if ((StringPackage->StringBlockIndex == NULL) && EFI_ERROR (BuildStringBlockIndex (StringPackage))) {
+    return FALSE;
+  }
+
+  //
+  // Find the last block whose first string ID is not greater than StringId.
+  //
+  Low  = 0;
+  High = StringPackage->StringBlockIndexCount;
+  while (Low < High) {
+    Middle = (Low + High) / 2;
+    if (StringPackage->StringBlockIndex[Middle].StartStringId <= StringId) {
+      Low = Middle + 1;
+    } else {
+      High = Middle;
+    }
+  }
+
+  if (Low == 0) {
+    return FALSE;
+  }
+
+  *StartStringId = StringPackage->StringBlockIndex[Low - 1].StartStringId;
+  *BlockOffset   = StringPackage->StringBlockIndex[Low - 1].BlockOffset;
+  return TRUE;
+}
+
 /**
   Parse all string blocks to find a String block specified by StringId.
   If StringId = (EFI_STRING_ID) (-1), find out all EFI_HII_SIBT_FONT blocks
@@ -306,11 +584,22 @@ FindStringBlock (
   ZeroMem (&Zero, sizeof (CHAR16));
 
   //
-  // Parse the string blocks to get the string text and font.
+  // Parse the string blocks to get the string text and font. Start at the
+  // block that defines StringId if the string block index knows where it is,
+  // parsing the blocks before it would only count the string IDs.
   //
   BlockHdr  = StringPackage->StringBlock;
   BlockSize = 0;
   Offset    = 0;
+  if ((StringId != (EFI_STRING_ID)(-1)) && (StringId != 0) &&
+      LookupStringBlockIndex (StringPackage, StringId, &CurrentStringId, &BlockSize))
+  {
+    BlockHdr = StringPackage->StringBlock + BlockSize;
+    if ((StartStringId != NULL) && (BlockSize != 0)) {
+      *StartStringId = CurrentStringId;
+    }
+  }
+
   while (*BlockHdr != EFI_HII_SIBT_END) {
     switch (*BlockHdr) {
       case EFI_HII_SIBT_STRING_SCSU:
@@ -460,6 +749,7 @@ FindStringBlock (
           ASSERT (StringId != CurrentStringId);
           CurrentStringId = 1;
           BlockSize       = 0;
+          LookupStringBlockIndex (StringPackage, StringId, &CurrentStringId, &BlockSize);
         } else {
           BlockSize += sizeof (EFI_HII_SIBT_DUPLICATE_BLOCK);
           CurrentStringId++;
@@ -854,6 +1144,7 @@ InsertLackStringBlock (
   }
 
   FreePool (StringPackage->StringBlock);
+  InvalidateStringBlockIndex (StringPackage);
   StringPackage->StringBlock                  = StringBlock;
   StringPackage->StringPkgHdr->Header.Length += NewBlockSize - OldBlockSize;
 
@@ -1025,6 +1316,7 @@ SetStringWorker (
 
       ZeroMem (StringPackage->StringBlock, OldBlockSize);
       FreePool (StringPackage->StringBlock);
+      InvalidateStringBlockIndex (StringPackage);
       StringPackage->StringBlock                  = Block;
       StringPackage->StringPkgHdr->Header.Length += (UINT32)(BlockSize - OldBlockSize);
       break;
@@ -1059,6 +1351,7 @@ SetStringWorker (
 
       ZeroMem (StringPackage->StringBlock, OldBlockSize);
       FreePool (StringPackage->StringBlock);
+      InvalidateStringBlockIndex (StringPackage);
       StringPackage->StringBlock                  = Block;
       StringPackage->StringPkgHdr->Header.Length += (UINT32)(BlockSize - OldBlockSize);
       break;
@@ -1111,6 +1404,7 @@ SetStringWorker (
 
   ZeroMem (StringPackage->StringBlock, OldBlockSize);
   FreePool (StringPackage->StringBlock);
+  InvalidateStringBlockIndex (StringPackage);
   StringPackage->StringBlock                  = Block;
   StringPackage->StringPkgHdr->Header.Length += Ext2.Length;
 
@@ -1299,6 +1593,7 @@ HiiNewString (
       *BlockPtr = EFI_HII_SIBT_END;
       ZeroMem (StringPackage->StringBlock, OldBlockSize);
       FreePool (StringPackage->StringBlock);
+      InvalidateStringBlockIndex (StringPackage);
       StringPackage->StringBlock                     = StringBlock;
       StringPackage->StringPkgHdr->Header.Length    += Ucs2BlockSize;
       PackageListNode->PackageListHdr.PackageLength += Ucs2BlockSize;
@@ -1435,6 +1730,7 @@ HiiNewString (
     *BlockPtr = EFI_HII_SIBT_END;
     ZeroMem (StringPackage->StringBlock, OldBlockSize);
     FreePool (StringPackage->StringBlock);
+    InvalidateStringBlockIndex (StringPackage);
     StringPackage->StringBlock                     = StringBlock;
     StringPackage->StringPkgHdr->Header.Length    += Ucs2BlockSize;
     PackageListNode->PackageListHdr.PackageLength += Ucs2BlockSize;
@@ -1478,6 +1774,7 @@ HiiNewString (
       *BlockPtr = EFI_HII_SIBT_END;
       ZeroMem (StringPackage->StringBlock, OldBlockSize);
       FreePool (StringPackage->StringBlock);
+      InvalidateStringBlockIndex (StringPackage);
       StringPackage->StringBlock                     = StringBlock;
       StringPackage->StringPkgHdr->Header.Length    += Ucs2FontBlockSize;
       PackageListNode->PackageListHdr.PackageLength += Ucs2FontBlockSize;
@@ -1540,6 +1837,7 @@ HiiNewString (
       *BlockPtr = EFI_HII_SIBT_END;
       ZeroMem (StringPackage->StringBlock, OldBlockSize);
       FreePool (StringPackage->StringBlock);
+      InvalidateStringBlockIndex (StringPackage);
       StringPackage->StringBlock                     = StringBlock;
       StringPackage->StringPkgHdr->Header.Length    += FontBlockSize + Ucs2FontBlockSize;
       PackageListNode->PackageListHdr.PackageLength += FontBlockSize + Ucs2FontBlockSize;
@@ -1583,6 +1881,7 @@ Done:
     // Free the allocated new string Package when new string can't be added.
     //
     RemoveEntryList (&StringPackage->StringEntry);
+    InvalidateStringBlockIndex (StringPackage);
     FreePool (StringPackage->StringBlock);
     FreePool (StringPackage->StringPkgHdr);
     FreePool (StringPackage);
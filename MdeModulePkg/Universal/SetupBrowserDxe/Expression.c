@@ -844,8 +844,59 @@ IdToQuestion (
   IN UINT16                QuestionId
   )
 {
-  LIST_ENTRY              *Link;
-  FORM_BROWSER_STATEMENT  *Question;
+  LIST_ENTRY                   *Link;
+  FORM_BROWSER_STATEMENT       *Question;
+  FORM_BROWSER_QUESTION_INDEX  *Entry;
+  UINTN                        Low;
+  UINTN                        High;
+  UINTN                        Mid;
+
+  if ((FormSet->QuestionIndex != NULL) && (QuestionId != 0)) {
+    //
+    // Locate the first index entry of this QuestionId.
+    //
+    Low  = 0;
+    High = FormSet->QuestionIndexCount;
+    while (Low < High) {
+      Mid = Low + (High - Low) / 2;
+      if (FormSet->QuestionIndex[Mid].QuestionId < QuestionId) {
+        Low = Mid + 1;
+      } else {
+        High = Mid;
+      }
+    }
+
+    if ((Low == FormSet->QuestionIndexCount) || (FormSet->QuestionIndex[Low].QuestionId != QuestionId)) {
+      return NULL;
+    }
+
+    //
+    // Search in the form scope first
+    //
+    for (Entry = &FormSet->QuestionIndex[Low];
+         (Entry < FormSet->QuestionIndex + FormSet->QuestionIndexCount) && (Entry->QuestionId == QuestionId);
+         Entry++)
+    {
+      if (Entry->Form == Form) {
+        return Entry->Question;
+      }
+    }
+
+    //
+    // Then use the first one in the formset scope
+    //
+    Entry    = &FormSet->QuestionIndex[Low];
+    Question = Entry->Question;
+    //
+    // EFI variable storage may be updated by Callback() asynchronous,
+    // to keep synchronous, always reload the Question Value.
+    //
+    if (Question->Storage->Type == EFI_HII_VARSTORE_EFI_VARIABLE) {
+      GetQuestionValue (FormSet, Entry->Form, Question, GetSetValueWithHiiDriver);
+    }
+
+    return Question;
+  }
 
   //
   // Search in the form scope first
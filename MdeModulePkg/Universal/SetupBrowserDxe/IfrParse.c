@@ -1021,6 +1021,10 @@ DestroyFormSet (
     FreePool (FormSet->ExpressionBuffer);
   }
 
+  if (FormSet->QuestionIndex != NULL) {
+    FreePool (FormSet->QuestionIndex);
+  }
+
   FreePool (FormSet);
 }
 
@@ -1148,6 +1152,121 @@ CountOpCodes (
   *NumberOfExpression = ExpressionCount;
 }
 
+/**
+  Compare two entries of the question index.
+
+  Entries are ordered by QuestionId. Entries with the same QuestionId keep the
+  formset order, which is the order the Statements were allocated from the
+  StatementBuffer while parsing.
+
+  @param  Buffer1                Pointer to the first FORM_BROWSER_QUESTION_INDEX.
+  @param  Buffer2                Pointer to the second FORM_BROWSER_QUESTION_INDEX.
+
+  @retval <0                     Buffer1 is less than Buffer2.
+  @retval 0                      Buffer1 is equal to Buffer2.
+  @retval >0                     Buffer1 is greater than Buffer2.
+
+**/
+STATIC
+INTN
+EFIAPI
+CompareQuestionIndex (
+  IN CONST VOID  *Buffer1,
+  IN CONST VOID  *Buffer2
+  )
+{
+  CONST FORM_BROWSER_QUESTION_INDEX  *Entry1;
+  CONST FORM_BROWSER_QUESTION_INDEX  *Entry2;
+
+  Entry1 = (CONST FORM_BROWSER_QUESTION_INDEX *)Buffer1;
+  Entry2 = (CONST FORM_BROWSER_QUESTION_INDEX *)Buffer2;
+
+  if (Entry1->QuestionId != Entry2->QuestionId) {
+    return (Entry1->QuestionId < Entry2->QuestionId) ? -1 : 1;
+  }
+
+  if (Entry1->Question != Entry2->Question) {
+    return (Entry1->Question < Entry2->Question) ? -1 : 1;
+  }
+
+  return 0;
+}
+
+/**
+  Build the index used to search a Question in formset scope using its QuestionId.
+
+  The index is optional. If it can't be allocated, IdToQuestion() falls back to
+  walk the Statement list of every form.
+
+  @param  FormSet                Pointer of the FormSet data structure.
+
+**/
+STATIC
+VOID
+BuildQuestionIndex (
+  IN OUT FORM_BROWSER_FORMSET  *FormSet
+  )
+{
+  LIST_ENTRY                   *Link;
+  LIST_ENTRY                   *StatementLink;
+  FORM_BROWSER_FORM            *Form;
+  FORM_BROWSER_STATEMENT       *Question;
+  FORM_BROWSER_QUESTION_INDEX  *QuestionIndex;
+  FORM_BROWSER_QUESTION_INDEX  Swap;
+  UINTN                        Count;
+
+  Count = 0;
+  Link  = GetFirstNode (&FormSet->FormListHead);
+  while (!IsNull (&FormSet->FormListHead, Link)) {
+    Form          = FORM_BROWSER_FORM_FROM_LINK (Link);
+    StatementLink = GetFirstNode (&Form->StatementListHead);
+    while (!IsNull (&Form->StatementListHead, StatementLink)) {
+      Question = FORM_BROWSER_STATEMENT_FROM_LINK (StatementLink);
+      if (Question->QuestionId != 0) {
+        Count++;
+      }
+
+      StatementLink = GetNextNode (&Form->StatementListHead, StatementLink);
+    }
+
+    Link = GetNextNode (&FormSet->FormListHead, Link);
+  }
+
+  if (Count == 0) {
+    return;
+  }
+
+  QuestionIndex = AllocatePool (Count * sizeof (FORM_BROWSER_QUESTION_INDEX));
+  if (QuestionIndex == NULL) {
+    return;
+  }
+
+  Count = 0;
+  Link  = GetFirstNode (&FormSet->FormListHead);
+  while (!IsNull (&FormSet->FormListHead, Link)) {
+    Form          = FORM_BROWSER_FORM_FROM_LINK (Link);
+    StatementLink = GetFirstNode (&Form->StatementListHead);
+    while (!IsNull (&Form->StatementListHead, StatementLink)) {
+      Question = FORM_BROWSER_STATEMENT_FROM_LINK (StatementLink);
+      if (Question->QuestionId != 0) {
+        QuestionIndex[Count].QuestionId = Question->QuestionId;
+        QuestionIndex[Count].Form       = Form;
+        QuestionIndex[Count].Question   = Question;
+        Count++;
+      }
+
+      StatementLink = GetNextNode (&Form->StatementListHead, StatementLink);
+    }
+
+    Link = GetNextNode (&FormSet->FormListHead, Link);
+  }
+
+  QuickSort (QuestionIndex, Count, sizeof (FORM_BROWSER_QUESTION_INDEX), CompareQuestionIndex, &Swap);
+
+  FormSet->QuestionIndex      = QuestionIndex;
+  FormSet->QuestionIndexCount = Count;
+}
+
 /**
   Parse opcodes in the formset IFR binary.
 
@@ -2746,5 +2865,7 @@ ParseOpCodes (
     }
   }
 
+  BuildQuestionIndex (FormSet);
+
   return EFI_SUCCESS;
 }
@@ -416,6 +416,12 @@ typedef struct {
 
 #define FORM_BROWSER_FORM_FROM_LINK(a)  CR (a, FORM_BROWSER_FORM, Link, FORM_BROWSER_FORM_SIGNATURE)
 
+typedef struct {
+  EFI_QUESTION_ID           QuestionId;
+  FORM_BROWSER_FORM         *Form;       // The form which contains this Question.
+  FORM_BROWSER_STATEMENT    *Question;
+} FORM_BROWSER_QUESTION_INDEX;
+
 #define FORMSET_DEFAULTSTORE_SIGNATURE  SIGNATURE_32 ('F', 'D', 'F', 'S')
 
 typedef struct {
@@ -465,6 +471,9 @@ typedef struct {
   LIST_ENTRY                        DefaultStoreListHead;    // DefaultStore list (FORMSET_DEFAULTSTORE)
   LIST_ENTRY                        FormListHead;            // Form list (FORM_BROWSER_FORM)
   LIST_ENTRY                        ExpressionListHead;      // List of Expressions (FORM_EXPRESSION)
+
+  FORM_BROWSER_QUESTION_INDEX       *QuestionIndex;          // Questions in all forms sorted by QuestionId, built after parse.
+  UINTN                             QuestionIndexCount;      // Number of entries in QuestionIndex.
 } FORM_BROWSER_FORMSET;
 #define FORM_BROWSER_FORMSET_FROM_LINK(a)  CR (a, FORM_BROWSER_FORMSET, Link, FORM_BROWSER_FORMSET_SIGNATURE)
 
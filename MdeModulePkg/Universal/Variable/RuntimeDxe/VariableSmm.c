@@ -511,9 +511,11 @@ SmmVariableHandler (
       }
 
       //
-      // Copy the input communicate buffer payload to pre-allocated SMM variable buffer payload.
+      // Copy the input header to pre-allocated SMM variable buffer payload. The rest of the
+      // payload is the output data buffer of the caller, so only the name is copied after
+      // it is validated, rather than the whole payload.
       //
-      CopyMem (mVariableBufferPayload, SmmVariableFunctionHeader->Data, CommBufferPayloadSize);
+      CopyMem (mVariableBufferPayload, SmmVariableFunctionHeader->Data, OFFSET_OF (SMM_VARIABLE_COMMUNICATE_ACCESS_VARIABLE, Name));
       SmmVariableHeader = (SMM_VARIABLE_COMMUNICATE_ACCESS_VARIABLE *)mVariableBufferPayload;
       if (((UINTN)(~0) - SmmVariableHeader->DataSize < OFFSET_OF (SMM_VARIABLE_COMMUNICATE_ACCESS_VARIABLE, Name)) ||
           ((UINTN)(~0) - SmmVariableHeader->NameSize < OFFSET_OF (SMM_VARIABLE_COMMUNICATE_ACCESS_VARIABLE, Name) + SmmVariableHeader->DataSize))
@@ -543,6 +545,11 @@ SmmVariableHandler (
       // subsequent consumption of the CommBuffer content.
       //
       VariableSpeculationBarrier ();
+      CopyMem (
+        SmmVariableHeader->Name,
+        (UINT8 *)SmmVariableFunctionHeader->Data + OFFSET_OF (SMM_VARIABLE_COMMUNICATE_ACCESS_VARIABLE, Name),
+        SmmVariableHeader->NameSize
+        );
       if ((SmmVariableHeader->NameSize < sizeof (CHAR16)) || (SmmVariableHeader->Name[SmmVariableHeader->NameSize/sizeof (CHAR16) - 1] != L'\0')) {
         //
         // Make sure VariableName is A Null-terminated string.
@@ -558,7 +565,17 @@ SmmVariableHandler (
                  &SmmVariableHeader->DataSize,
                  (UINT8 *)SmmVariableHeader->Name + SmmVariableHeader->NameSize
                  );
-      CopyMem (SmmVariableFunctionHeader->Data, mVariableBufferPayload, CommBufferPayloadSize);
+
+      //
+      // Copy back the header, plus the name and the data on success. DataSize
+      // can only shrink on success, so it stays within the communicate buffer.
+      //
+      InfoSize = OFFSET_OF (SMM_VARIABLE_COMMUNICATE_ACCESS_VARIABLE, Name);
+      if (!EFI_ERROR (Status)) {
+        InfoSize += SmmVariableHeader->NameSize + SmmVariableHeader->DataSize;
+      }
+
+      CopyMem (SmmVariableFunctionHeader->Data, mVariableBufferPayload, InfoSize);
       break;
 
     case SMM_VARIABLE_FUNCTION_GET_NEXT_VARIABLE_NAME:
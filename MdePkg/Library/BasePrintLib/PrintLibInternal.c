@@ -141,15 +141,34 @@ BasePrintLibValueToString (
   )
 {
   UINT32  Remainder;
+  UINT32  Value32;
 
   //
   // Loop to convert one digit at a time in reverse order
   //
   *Buffer = 0;
-  do {
+  if (Radix == 16) {
+    do {
+      *(++Buffer) = mHexStr[(UINTN)Value & 0xf];
+      Value       = (INT64)RShiftU64 ((UINT64)Value, 4);
+    } while (Value != 0);
+
+    return Buffer;
+  }
+
+  //
+  // Only use the 64-bit division until the value fits in 32 bits.
+  //
+  while ((UINT64)Value > MAX_UINT32) {
     Value       = (INT64)DivU64x32Remainder ((UINT64)Value, (UINT32)Radix, &Remainder);
     *(++Buffer) = mHexStr[Remainder];
-  } while (Value != 0);
+  }
+
+  Value32 = (UINT32)Value;
+  do {
+    *(++Buffer) = mHexStr[Value32 % (UINT32)Radix];
+    Value32     = Value32 / (UINT32)Radix;
+  } while (Value32 != 0);
 
   //
   // Return pointer of the end of filled buffer.
@@ -157,6 +176,34 @@ BasePrintLibValueToString (
   return Buffer;
 }
 
+/**
+  Internal function that converts a value to a fixed number of hexadecimal digits.
+
+  @param  Buffer    Location to place the ASCII digits of Value. No Null-terminator
+                    is placed.
+  @param  Value     The value to convert.
+  @param  Digits    The number of hexadecimal digits to place in Buffer.
+
+  @return A pointer to the character after the last digit placed in Buffer.
+
+**/
+CHAR8 *
+BasePrintLibFixedWidthHexToString (
+  OUT CHAR8   *Buffer,
+  IN  UINT32  Value,
+  IN  UINTN   Digits
+  )
+{
+  UINTN  Index;
+
+  for (Index = Digits; Index > 0; Index--) {
+    Buffer[Index - 1] = mHexStr[Value & 0xf];
+    Value           >>= 4;
+  }
+
+  return Buffer + Digits;
+}
+
 /**
   Internal function that converts a decimal value to a Null-terminated string.
 
@@ -559,6 +606,7 @@ BasePrintLibSPrintMarker (
   CONST CHAR8    *ArgumentString;
   UINTN          Character;
   GUID           *TmpGuid;
+  CHAR8          *GuidString;
   TIME           *TmpTime;
   UINTN          Count;
   UINTN          ArgumentMask;
@@ -572,9 +620,6 @@ BasePrintLibSPrintMarker (
   UINTN          Digits;
   UINTN          Radix;
   RETURN_STATUS  Status;
-  UINT32         GuidData1;
-  UINT16         GuidData2;
-  UINT16         GuidData3;
   UINTN          LengthToReturn;
 
   //
@@ -680,6 +725,31 @@ BasePrintLibSPrintMarker (
       break;
     }
 
+    //
+    // Copy a run of characters that need no conversion in one go. This is the
+    // same output the default case below produces one character at a time.
+    //
+    if ((FormatCharacter != '%') && (FormatCharacter != '\r') && (FormatCharacter != '\n')) {
+      do {
+        LengthToReturn += BytesPerOutputCharacter;
+        if (((Flags & COUNT_ONLY_NO_PRINT) == 0) && (Buffer != NULL)) {
+          *Buffer = (CHAR8)FormatCharacter;
+          if (BytesPerOutputCharacter != 1) {
+            *(Buffer + 1) = (CHAR8)(FormatCharacter >> 8);
+          }
+
+          Buffer += BytesPerOutputCharacter;
+        }
+
+        Format         += BytesPerFormatCharacter;
+        FormatCharacter = ((*Format & 0xff) | ((BytesPerFormatCharacter == 1) ? 0 : (*(Format + 1) << 8))) & FormatMask;
+      } while ((FormatCharacter != 0) && (FormatCharacter != '%') &&
+               (FormatCharacter != '\r') && (FormatCharacter != '\n') &&
+               ((Buffer == NULL) || (Buffer < EndBuffer)));
+
+      continue;
+    }
+
     //
     // Clear all the flag bits except those that may have been passed in
     //
@@ -981,26 +1051,25 @@ BasePrintLibSPrintMarker (
             if (TmpGuid == NULL) {
               ArgumentString = "<null guid>";
             } else {
-              GuidData1 = ReadUnaligned32 (&(TmpGuid->Data1));
-              GuidData2 = ReadUnaligned16 (&(TmpGuid->Data2));
-              GuidData3 = ReadUnaligned16 (&(TmpGuid->Data3));
-              BasePrintLibSPrint (
-                ValueBuffer,
-                MAXIMUM_VALUE_CHARACTERS,
-                0,
-                "%08x-%04x-%04x-%02x%02x-%02x%02x%02x%02x%02x%02x",
-                GuidData1,
-                GuidData2,
-                GuidData3,
-                TmpGuid->Data4[0],
-                TmpGuid->Data4[1],
-                TmpGuid->Data4[2],
-                TmpGuid->Data4[3],
-                TmpGuid->Data4[4],
-                TmpGuid->Data4[5],
-                TmpGuid->Data4[6],
-                TmpGuid->Data4[7]
-                );
+              //
+              // Same as "%08x-%04x-%04x-%02x%02x-%02x%02x%02x%02x%02x%02x"
+              // without parsing a format string.
+              //
+              GuidString    = BasePrintLibFixedWidthHexToString (ValueBuffer, ReadUnaligned32 (&(TmpGuid->Data1)), 8);
+              *GuidString++ = '-';
+              GuidString    = BasePrintLibFixedWidthHexToString (GuidString, ReadUnaligned16 (&(TmpGuid->Data2)), 4);
+              *GuidString++ = '-';
+              GuidString    = BasePrintLibFixedWidthHexToString (GuidString, ReadUnaligned16 (&(TmpGuid->Data3)), 4);
+              *GuidString++ = '-';
+              for (Index = 0; Index < sizeof (TmpGuid->Data4); Index++) {
+                if (Index == 2) {
+                  *GuidString++ = '-';
+                }
+
+                GuidString = BasePrintLibFixedWidthHexToString (GuidString, TmpGuid->Data4[Index], 2);
+              }
+
+              *GuidString    = '\0';
               ArgumentString = ValueBuffer;
             }
 
@@ -159,6 +159,24 @@ BasePrintLibValueToString (
   IN UINTN      Radix
   );
 
+/**
+  Internal function that converts a value to a fixed number of hexadecimal digits.
+
+  @param  Buffer    Location to place the ASCII digits of Value. No Null-terminator
+                    is placed.
+  @param  Value     The value to convert.
+  @param  Digits    The number of hexadecimal digits to place in Buffer.
+
+  @return A pointer to the character after the last digit placed in Buffer.
+
+**/
+CHAR8 *
+BasePrintLibFixedWidthHexToString (
+  OUT CHAR8   *Buffer,
+  IN  UINT32  Value,
+  IN  UINTN   Digits
+  );
+
 /**
   Internal function that converts a decimal value to a Null-terminated string.
 
@@ -0,0 +1,334 @@
+/** @file
+  Unit tests and benchmark of the BasePrintLib.
+
+  Copyright (c) 2026, agent. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#include <time.h>
+
+#include <Uefi.h>
+#include <Library/BaseLib.h>
+#include <Library/BaseMemoryLib.h>
+#include <Library/DebugLib.h>
+#include <Library/PrintLib.h>
+#include <Library/UnitTestLib.h>
+
+#define UNIT_TEST_APP_NAME     "BasePrintLib Unit Test Application"
+#define UNIT_TEST_APP_VERSION  "1.0"
+
+#define BENCHMARK_ITERATION_TIME  100000
+
+//
+// Print with AsciiSPrint() and check both the returned length and the string.
+//
+#define ASSERT_ASCII_PRINT(Expected, ...)                               \
+  do {                                                                   \
+    Length = AsciiSPrint (Buffer, sizeof (Buffer), __VA_ARGS__);         \
+    UT_ASSERT_EQUAL (Length, sizeof (Expected) - 1);                     \
+    UT_ASSERT_MEM_EQUAL (Buffer, Expected, sizeof (Expected));           \
+  } while (FALSE)
+
+//
+// Print with UnicodeSPrint() and check both the returned length and the string.
+//
+#define ASSERT_UNICODE_PRINT(Expected, ...)                             \
+  do {                                                                   \
+    Length = UnicodeSPrint (Buffer, sizeof (Buffer), __VA_ARGS__);       \
+    UT_ASSERT_EQUAL (Length, sizeof (Expected) / sizeof (CHAR16) - 1);   \
+    UT_ASSERT_MEM_EQUAL (Buffer, Expected, sizeof (Expected));           \
+  } while (FALSE)
+
+EFI_GUID  mTestGuid = {
+  0x12345678, 0x9abc, 0xdef0, { 0x01, 0x23, 0x45, 0x67, 0x89, 0xab, 0xcd, 0xef }
+};
+
+/**
+  Check the integer conversions of AsciiSPrint().
+
+  @param[in]  Context    Unused.
+
+  @retval  UNIT_TEST_PASSED             The Unit test has completed and the test
+                                        case was successful.
+  @retval  UNIT_TEST_ERROR_TEST_FAILED  A test case assertion has failed.
+**/
+UNIT_TEST_STATUS
+EFIAPI
+AsciiPrintIntegersShouldMatch (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  CHAR8  Buffer[64];
+  UINTN  Length;
+
+  ASSERT_ASCII_PRINT ("0", "%d", 0);
+  ASSERT_ASCII_PRINT ("-12345", "%d", -12345);
+  ASSERT_ASCII_PRINT ("4294967295", "%u", 0xFFFFFFFF);
+  ASSERT_ASCII_PRINT ("+42", "%+d", 42);
+  ASSERT_ASCII_PRINT ("   42|", "%5d|", 42);
+  ASSERT_ASCII_PRINT ("42   |", "%-5d|", 42);
+  ASSERT_ASCII_PRINT ("-0042", "%05d", -42);
+  ASSERT_ASCII_PRINT ("-1,234,567", "%,d", -1234567);
+  ASSERT_ASCII_PRINT ("ABCDEF", "%x", 0xabcdef);
+  ASSERT_ASCII_PRINT ("ABCDEF", "%X", 0xABCDEF);
+  ASSERT_ASCII_PRINT ("000000FF", "%08x", 0xFF);
+  ASSERT_ASCII_PRINT ("-9223372036854775808", "%ld", (INT64)MIN_INT64);
+  ASSERT_ASCII_PRINT ("18446744073709551615", "%lu", MAX_UINT64);
+  ASSERT_ASCII_PRINT ("4294967296", "%ld", (INT64)BIT32);
+  ASSERT_ASCII_PRINT ("123456789ABCDEF0", "%lx", 0x123456789ABCDEF0ull);
+  ASSERT_ASCII_PRINT ("00000000DEADBEEF", "%016lX", 0xDEADBEEFull);
+
+  return UNIT_TEST_PASSED;
+}
+
+/**
+  Check the string, GUID, status and literal handling of AsciiSPrint().
+
+  @param[in]  Context    Unused.
+
+  @retval  UNIT_TEST_PASSED             The Unit test has completed and the test
+                                        case was successful.
+  @retval  UNIT_TEST_ERROR_TEST_FAILED  A test case assertion has failed.
+**/
+UNIT_TEST_STATUS
+EFIAPI
+AsciiPrintStringsShouldMatch (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  CHAR8  Buffer[64];
+  UINTN  Length;
+
+  ASSERT_ASCII_PRINT ("plain literal text", "plain literal text");
+  ASSERT_ASCII_PRINT ("ascii and unicode", "%a and %s", "ascii", L"unicode");
+  ASSERT_ASCII_PRINT ("<null string>", "%a", NULL);
+  ASSERT_ASCII_PRINT ("  abc|", "%5a|", "abc");
+  ASSERT_ASCII_PRINT ("abc  |", "%-5a|", "abc");
+  ASSERT_ASCII_PRINT ("ab|", "%.2a|", "abc");
+  ASSERT_ASCII_PRINT ("x%y", "%c%%%c", 'x', 'y');
+  ASSERT_ASCII_PRINT ("12345678-9ABC-DEF0-0123-456789ABCDEF", "%g", &mTestGuid);
+  ASSERT_ASCII_PRINT ("<null guid>", "%g", NULL);
+  ASSERT_ASCII_PRINT ("Success", "%r", RETURN_SUCCESS);
+  ASSERT_ASCII_PRINT ("Invalid Parameter", "%r", RETURN_INVALID_PARAMETER);
+  ASSERT_ASCII_PRINT ("a\r\nb\r\nc\rd", "a\nb\r\nc\rd");
+  ASSERT_ASCII_PRINT ("a\r\nb", "a\n\rb");
+
+  return UNIT_TEST_PASSED;
+}
+
+/**
+  Check UnicodeSPrint() and the mixed ASCII/Unicode format variants.
+
+  @param[in]  Context    Unused.
+
+  @retval  UNIT_TEST_PASSED             The Unit test has completed and the test
+                                        case was successful.
+  @retval  UNIT_TEST_ERROR_TEST_FAILED  A test case assertion has failed.
+**/
+UNIT_TEST_STATUS
+EFIAPI
+UnicodePrintShouldMatch (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  CHAR16  Buffer[64];
+  CHAR8   AsciiBuffer[64];
+  UINTN   Length;
+
+  ASSERT_UNICODE_PRINT (L"Boot0001: UEFI Shell\r\n", L"Boot%04x: %s\n", 1, L"UEFI Shell");
+  ASSERT_UNICODE_PRINT (L"\x263A smile \x263A", L"\x263A %a \x263A", "smile");
+  ASSERT_UNICODE_PRINT (L"-1,000 12345678-9ABC-DEF0-0123-456789ABCDEF", L"%,d %g", -1000, &mTestGuid);
+
+  Length = UnicodeSPrintAsciiFormat (Buffer, sizeof (Buffer), "%a=%d", "value", 7);
+  UT_ASSERT_EQUAL (Length, 7);
+  UT_ASSERT_MEM_EQUAL (Buffer, L"value=7", sizeof (L"value=7"));
+
+  Length = AsciiSPrintUnicodeFormat (AsciiBuffer, sizeof (AsciiBuffer), L"%s=%x", L"value", 0x1F);
+  UT_ASSERT_EQUAL (Length, 8);
+  UT_ASSERT_MEM_EQUAL (AsciiBuffer, "value=1F", sizeof ("value=1F"));
+
+  return UNIT_TEST_PASSED;
+}
+
+/**
+  Check that output is truncated to the buffer size and always Null-terminated.
+
+  @param[in]  Context    Unused.
+
+  @retval  UNIT_TEST_PASSED             The Unit test has completed and the test
+                                        case was successful.
+  @retval  UNIT_TEST_ERROR_TEST_FAILED  A test case assertion has failed.
+**/
+UNIT_TEST_STATUS
+EFIAPI
+TruncatedPrintShouldMatch (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  CHAR8   Buffer[16];
+  CHAR16  UnicodeBuffer[16];
+  UINTN   Length;
+
+  SetMem (Buffer, sizeof (Buffer), 0xCC);
+  Length = AsciiSPrint (Buffer, 8, "literal text %d", 12345);
+  UT_ASSERT_EQUAL (Length, 7);
+  UT_ASSERT_MEM_EQUAL (Buffer, "literal", sizeof ("literal"));
+  UT_ASSERT_EQUAL ((UINT8)Buffer[8], 0xCC);
+
+  SetMem (Buffer, sizeof (Buffer), 0xCC);
+  Length = AsciiSPrint (Buffer, 8, "ab%d", 123456789);
+  UT_ASSERT_EQUAL (Length, 7);
+  UT_ASSERT_MEM_EQUAL (Buffer, "ab12345", sizeof ("ab12345"));
+  UT_ASSERT_EQUAL ((UINT8)Buffer[8], 0xCC);
+
+  SetMem (UnicodeBuffer, sizeof (UnicodeBuffer), 0xCC);
+  Length = UnicodeSPrint (UnicodeBuffer, 4 * sizeof (CHAR16), L"literal text");
+  UT_ASSERT_EQUAL (Length, 3);
+  UT_ASSERT_MEM_EQUAL (UnicodeBuffer, L"lit", sizeof (L"lit"));
+  UT_ASSERT_EQUAL (UnicodeBuffer[4], 0xCCCC);
+
+  return UNIT_TEST_PASSED;
+}
+
+/**
+  Log the time taken to print the format strings that are most common in
+  firmware debug output.
+
+  @param[in]  Context    Unused.
+
+  @retval  UNIT_TEST_PASSED             The Unit test has completed and the test
+                                        case was successful.
+**/
+UNIT_TEST_STATUS
+EFIAPI
+BenchmarkPrint (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  CHAR8    Buffer[128];
+  CHAR16   UnicodeBuffer[128];
+  UINTN    Index;
+  clock_t  Start;
+  clock_t  Literal;
+  clock_t  Number;
+  clock_t  Guid;
+  clock_t  Unicode;
+
+  Start = clock ();
+  for (Index = 0; Index < BENCHMARK_ITERATION_TIME; Index++) {
+    AsciiSPrint (Buffer, sizeof (Buffer), "Loading driver at 0x%p EntryPoint=0x%p %a\n", (VOID *)Index, (VOID *)Buffer, "Driver.efi");
+  }
+
+  Literal = clock () - Start;
+
+  Start = clock ();
+  for (Index = 0; Index < BENCHMARK_ITERATION_TIME; Index++) {
+    AsciiSPrint (Buffer, sizeof (Buffer), "%ld %lx %d", (UINT64)Index * 123456789, LShiftU64 (Index, 20), (INT32)Index);
+  }
+
+  Number = clock () - Start;
+
+  Start = clock ();
+  for (Index = 0; Index < BENCHMARK_ITERATION_TIME; Index++) {
+    AsciiSPrint (Buffer, sizeof (Buffer), "%g", &mTestGuid);
+  }
+
+  Guid = clock () - Start;
+
+  Start = clock ();
+  for (Index = 0; Index < BENCHMARK_ITERATION_TIME; Index++) {
+    UnicodeSPrint (UnicodeBuffer, sizeof (UnicodeBuffer), L"Boot%04x: %s %d items\r\n", Index, L"UEFI Shell", Index);
+  }
+
+  Unicode = clock () - Start;
+
+  UT_LOG_INFO (
+    "Per call: literal %d ns, number %d ns, GUID %d ns, unicode %d ns\n",
+    (UINT32)((UINT64)Literal * 1000000000 / CLOCKS_PER_SEC / BENCHMARK_ITERATION_TIME),
+    (UINT32)((UINT64)Number * 1000000000 / CLOCKS_PER_SEC / BENCHMARK_ITERATION_TIME),
+    (UINT32)((UINT64)Guid * 1000000000 / CLOCKS_PER_SEC / BENCHMARK_ITERATION_TIME),
+    (UINT32)((UINT64)Unicode * 1000000000 / CLOCKS_PER_SEC / BENCHMARK_ITERATION_TIME)
+    );
+
+  return UNIT_TEST_PASSED;
+}
+
+/**
+  Initialize the unit test framework, suite, and unit tests for the
+  BasePrintLib and run the BasePrintLib unit test.
+
+  @retval  EFI_SUCCESS           All test cases were dispatched.
+  @retval  EFI_OUT_OF_RESOURCES  There are not enough resources available to
+                                 initialize the unit tests.
+**/
+STATIC
+EFI_STATUS
+EFIAPI
+UnitTestingEntry (
+  VOID
+  )
+{
+  EFI_STATUS                  Status;
+  UNIT_TEST_FRAMEWORK_HANDLE  Framework;
+  UNIT_TEST_SUITE_HANDLE      PrintTests;
+  UNIT_TEST_SUITE_HANDLE      BenchmarkTests;
+
+  Framework = NULL;
+
+  DEBUG ((DEBUG_INFO, "%a v%a\n", UNIT_TEST_APP_NAME, UNIT_TEST_APP_VERSION));
+
+  //
+  // Start setting up the test framework for running the tests.
+  //
+  Status = InitUnitTestFramework (&Framework, UNIT_TEST_APP_NAME, gEfiCallerBaseName, UNIT_TEST_APP_VERSION);
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_ERROR, "Failed in InitUnitTestFramework. Status = %r\n", Status));
+    goto EXIT;
+  }
+
+  Status = CreateUnitTestSuite (&PrintTests, Framework, "BasePrintLib Format Tests", "BasePrintLib.Format", NULL, NULL);
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_ERROR, "Failed in CreateUnitTestSuite for BasePrintLib Format Tests\n"));
+    Status = EFI_OUT_OF_RESOURCES;
+    goto EXIT;
+  }
+
+  AddTestCase (PrintTests, "Integer conversions", "Integers", AsciiPrintIntegersShouldMatch, NULL, NULL, NULL);
+  AddTestCase (PrintTests, "String, GUID and status conversions", "Strings", AsciiPrintStringsShouldMatch, NULL, NULL, NULL);
+  AddTestCase (PrintTests, "Unicode output and format", "Unicode", UnicodePrintShouldMatch, NULL, NULL, NULL);
+  AddTestCase (PrintTests, "Truncated output", "Truncation", TruncatedPrintShouldMatch, NULL, NULL, NULL);
+
+  Status = CreateUnitTestSuite (&BenchmarkTests, Framework, "BasePrintLib Benchmark", "BasePrintLib.Benchmark", NULL, NULL);
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_ERROR, "Failed in CreateUnitTestSuite for BasePrintLib Benchmark\n"));
+    Status = EFI_OUT_OF_RESOURCES;
+    goto EXIT;
+  }
+
+  AddTestCase (BenchmarkTests, "Common debug formats", "Benchmark", BenchmarkPrint, NULL, NULL, NULL);
+
+  //
+  // Execute the tests.
+  //
+  Status = RunAllTestSuites (Framework);
+
+EXIT:
+  if (Framework) {
+    FreeUnitTestFramework (Framework);
+  }
+
+  return Status;
+}
+
+/**
+  Standard POSIX C entry point for host based unit test execution.
+**/
+int
+main (
+  int   argc,
+  char  *argv[]
+  )
+{
+  return UnitTestingEntry ();
+}
@@ -688,9 +688,14 @@ EfiDhcp4Configure (
     }
 
     DhcpSb->UserOptionLen = 0;
+    DhcpSb->RapidCommit   = FALSE;
 
     for (Index = 0; Index < Dhcp4CfgData->OptionCount; Index++) {
       DhcpSb->UserOptionLen += Dhcp4CfgData->OptionList[Index]->Length + 2;
+
+      if (Dhcp4CfgData->OptionList[Index]->OpCode == DHCP4_TAG_RAPID_COMMIT) {
+        DhcpSb->RapidCommit = TRUE;
+      }
     }
 
     DhcpSb->ActiveChild = Instance;
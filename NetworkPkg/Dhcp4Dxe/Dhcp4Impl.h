@@ -111,6 +111,7 @@ struct _DHCP_SERVICE {
   DHCP_PROTOCOL                   *ActiveChild;
   EFI_DHCP4_CONFIG_DATA           ActiveConfig;
   UINT32                          UserOptionLen;
+  BOOLEAN                         RapidCommit; // Rapid commit is requested by user, RFC 4039
 
   //
   // Timer event and various timer
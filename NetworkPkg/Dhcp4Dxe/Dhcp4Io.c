@@ -579,6 +579,67 @@ DhcpEndSession (
   DhcpNotifyUser (DhcpSb, DHCP_NOTIFY_ALL);
 }
 
+/**
+  Handle a DHCP ACK carrying the Rapid Commit option received in DHCP
+  select state, see RFC 4039. The lease is recorded and the client
+  transits to BOUND state directly if the user accepts the ACK.
+
+  @param[in]  DhcpSb                The DHCP service instance
+  @param[in]  Packet                The DHCP packet received
+  @param[in]  Para                  The DHCP parameter extracted from the packet. That
+                                    is, all the option value that we care.
+
+  @retval EFI_SUCCESS           The packet is successfully processed.
+  @retval Others                Some error occurred.
+
+**/
+EFI_STATUS
+DhcpHandleRapidCommit (
+  IN DHCP_SERVICE      *DhcpSb,
+  IN EFI_DHCP4_PACKET  *Packet,
+  IN DHCP_PARAMETER    *Para
+  )
+{
+  EFI_STATUS  Status;
+
+  //
+  // Call the user's callback. The action according to the return is as:
+  // 1. EFI_SUCCESS: commit to this lease
+  // 2. EFI_ABORTED: abort the address acquiring.
+  // 3. Others: ignore the ACK and wait for more offers
+  //
+  Status = DhcpCallUser (DhcpSb, Dhcp4RcvdAck, Packet, NULL);
+
+  if (EFI_ERROR (Status)) {
+    FreePool (Packet);
+    return (Status == EFI_ABORTED) ? EFI_ABORTED : EFI_SUCCESS;
+  }
+
+  if (DhcpSb->LastOffer != NULL) {
+    FreePool (DhcpSb->LastOffer);
+    DhcpSb->LastOffer = NULL;
+  }
+
+  //
+  // OK, get the parameter from server, record the lease
+  //
+  DhcpSb->Para = AllocateCopyPool (sizeof (DHCP_PARAMETER), Para);
+  if (DhcpSb->Para == NULL) {
+    FreePool (Packet);
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  DhcpSb->Selected = Packet;
+  Status           = DhcpLeaseAcquired (DhcpSb);
+  if (EFI_ERROR (Status)) {
+    return Status;
+  }
+
+  DhcpSb->IoStatus = EFI_SUCCESS;
+  DhcpNotifyUser (DhcpSb, DHCP_NOTIFY_COMPLETION);
+  return EFI_SUCCESS;
+}
+
 /**
   Handle packets in DHCP select state.
 
@@ -602,6 +663,17 @@ DhcpHandleSelect (
 
   Status = EFI_SUCCESS;
 
+  //
+  // A server supporting rapid commit answers the DISCOVER with an ACK
+  // directly if the user asked for it.
+  //
+  if (DhcpSb->RapidCommit && !DHCP_IS_BOOTP (Para) &&
+      (Para->DhcpType == DHCP_MSG_ACK) && Para->RapidCommit && (Para->ServerId != 0)
+      )
+  {
+    return DhcpHandleRapidCommit (DhcpSb, Packet, Para);
+  }
+
   //
   // First validate the message:
   // 1. the offer is a unicast
@@ -1266,6 +1338,15 @@ DhcpSendMessage (
         continue;
       }
 
+      //
+      // The Rapid Commit option is only valid in DHCP discover, RFC 4039.
+      //
+      if ((Type != DHCP_MSG_DISCOVER) &&
+          (Config->OptionList[Index]->OpCode == DHCP4_TAG_RAPID_COMMIT))
+      {
+        continue;
+      }
+
       Buf = DhcpAppendOption (
               Buf,
               Config->OptionList[Index]->OpCode,
@@ -98,6 +98,8 @@ DHCP_OPTION_FORMAT  DhcpOptionFormats[] = {
   { DHCP4_TAG_STTALK,          DHCP_OPTION_IP,     1, -1, FALSE },
   { DHCP4_TAG_STDA,            DHCP_OPTION_IP,     1, -1, FALSE },
 
+  { DHCP4_TAG_RAPID_COMMIT,    DHCP_OPTION_SWITCH, 0, 0,  TRUE  },
+
   { DHCP4_TAG_CLASSLESS_ROUTE, DHCP_OPTION_INT8,   5, -1, FALSE },
 };
 
@@ -284,6 +286,10 @@ DhcpGetParameter (
     case DHCP4_TAG_T2:
       Para->T2 = NetGetUint32 (Data);
       break;
+
+    case DHCP4_TAG_RAPID_COMMIT:
+      Para->RapidCommit = TRUE;
+      break;
   }
 
   return EFI_SUCCESS;
@@ -457,8 +463,9 @@ DhcpGetOptionLen (
 {
   DHCP_OPTION_COUNT  *OpCount;
 
-  OpCount             = (DHCP_OPTION_COUNT *)Context;
-  OpCount[Tag].Offset = (UINT16)(OpCount[Tag].Offset + Len);
+  OpCount              = (DHCP_OPTION_COUNT *)Context;
+  OpCount[Tag].Offset  = (UINT16)(OpCount[Tag].Offset + Len);
+  OpCount[Tag].Present = TRUE;
 
   return EFI_SUCCESS;
 }
@@ -579,7 +586,7 @@ DhcpParseOption (
   OptNum   = 0;
 
   for (Index = 0; Index < DHCP_MAX_OPTIONS; Index++) {
-    if (OptCount[Index].Offset != 0) {
+    if (OptCount[Index].Present) {
       OptCount[Index].Index = (UINT8)OptNum;
 
       TotalLen               = (UINT16)(TotalLen + OptCount[Index].Offset);
@@ -676,7 +683,11 @@ DhcpValidateOptions (
     //
     Format = DhcpFindOptionFormat (Option->Tag);
 
-    if (Format == NULL) {
+    //
+    // Options without data are only meaningful if the format allows it.
+    // Ignore the others as if they aren't present.
+    //
+    if ((Format == NULL) || ((Option->Len == 0) && (Format->MinOccur != 0))) {
       continue;
     }
 
@@ -713,7 +724,9 @@ ON_EXIT:
 
 /**
   Append an option to the memory, if the option is longer than
-  255 bytes, splits it into several options.
+  255 bytes, splits it into several options. An option without
+  data, such as Rapid Commit, is appended as the tag and a zero
+  length.
 
   @param[out] Buf                    The buffer to append the option to
   @param[in]  Tag                    The option's tag
@@ -734,7 +747,12 @@ DhcpAppendOption (
   INTN  Index;
   INTN  Len;
 
-  ASSERT (DataLen != 0);
+  if (DataLen == 0) {
+    *(Buf++) = Tag;
+    *(Buf++) = 0;
+
+    return Buf;
+  }
 
   for (Index = 0; Index < (DataLen + 254) / 255; Index++) {
     Len = MIN (255, DataLen - Index * 255);
@@ -47,8 +47,9 @@ typedef struct {
 /// Structures used to parse the DHCP options with RFC3396 support.
 ///
 typedef struct {
-  UINT8     Index;
-  UINT16    Offset;
+  UINT8      Index;
+  UINT16     Offset;
+  BOOLEAN    Present;     // Also counts the options without data
 } DHCP_OPTION_COUNT;
 
 typedef struct {
@@ -75,6 +76,7 @@ typedef struct {
   UINT32      Lease;                  // DHCP4_TAG_LEASE
   UINT32      T1;                     // DHCP4_TAG_T1
   UINT32      T2;                     // DHCP4_TAG_T2
+  BOOLEAN     RapidCommit;            // DHCP4_TAG_RAPID_COMMIT
 } DHCP_PARAMETER;
 
 ///
@@ -0,0 +1,203 @@
+/** @file
+  Tests for Dhcp4Option.c.
+
+  Copyright (c) 2026, agent. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+**/
+#include <gtest/gtest.h>
+
+extern "C" {
+  #include <Uefi.h>
+  #include <Library/BaseLib.h>
+  #include <Library/DebugLib.h>
+  #include <Library/BaseMemoryLib.h>
+  #include <Library/MemoryAllocationLib.h>
+  #include "../Dhcp4Impl.h"
+}
+
+////////////////////////////////////////////////////////////////////////
+// Defines
+////////////////////////////////////////////////////////////////////////
+
+#define DHCP4_TEST_PACKET_SIZE  (sizeof (EFI_DHCP4_PACKET) + 64)
+
+////////////////////////////////////////////////////////////////////////
+// DhcpValidateOptions Tests
+////////////////////////////////////////////////////////////////////////
+
+class DhcpValidateOptionsTest : public ::testing::Test {
+protected:
+  EFI_DHCP4_PACKET *Packet;
+  UINT8 *Option;
+
+  // Add any setup code if needed
+  virtual void
+  SetUp (
+    )
+  {
+    Packet = (EFI_DHCP4_PACKET *)AllocateZeroPool (DHCP4_TEST_PACKET_SIZE);
+    ASSERT_NE (Packet, nullptr);
+
+    Packet->Size        = DHCP4_TEST_PACKET_SIZE;
+    Packet->Dhcp4.Magik = DHCP_OPTION_MAGIC;
+    Option              = Packet->Dhcp4.Option;
+  }
+
+  // Add any cleanup code if needed
+  virtual void
+  TearDown (
+    )
+  {
+    FreePool (Packet);
+  }
+
+  // Append an option to the packet
+  void
+  AppendOption (
+    UINT8  Tag,
+    UINT8  Len,
+    UINT8  *Data
+    )
+  {
+    *(Option++) = Tag;
+    *(Option++) = Len;
+    CopyMem (Option, Data, Len);
+    Option += Len;
+  }
+
+  // Terminate the options and compute the packet length
+  void
+  EndOptions (
+    )
+  {
+    *(Option++)    = DHCP4_TAG_EOP;
+    Packet->Length = sizeof (EFI_DHCP4_HEADER) + sizeof (UINT32) + (UINT32)(Option - Packet->Dhcp4.Option);
+  }
+
+  // Append the options every DHCP ACK carries
+  void
+  AppendAckOptions (
+    )
+  {
+    UINT8  Type        = DHCP_MSG_ACK;
+    UINT8  ServerId[]  = { 192, 168, 0, 1 };
+    UINT8  NetMask[]   = { 255, 255, 255, 0 };
+    UINT8  LeaseTime[] = { 0, 0, 0x0E, 0x10 };
+
+    AppendOption (DHCP4_TAG_MSG_TYPE, 1, &Type);
+    AppendOption (DHCP4_TAG_SERVER_ID, 4, ServerId);
+    AppendOption (DHCP4_TAG_NETMASK, 4, NetMask);
+    AppendOption (DHCP4_TAG_LEASE, 4, LeaseTime);
+  }
+};
+
+// Test that an ACK without the Rapid Commit option is parsed as before
+TEST_F (DhcpValidateOptionsTest, AckWithoutRapidCommit) {
+  DHCP_PARAMETER  *Para;
+
+  AppendAckOptions ();
+  EndOptions ();
+
+  ASSERT_EQ (DhcpValidateOptions (Packet, &Para), EFI_SUCCESS);
+  ASSERT_NE (Para, nullptr);
+  EXPECT_EQ (Para->DhcpType, DHCP_MSG_ACK);
+  EXPECT_EQ (Para->ServerId, 0xC0A80001u);
+  EXPECT_EQ (Para->NetMask, 0xFFFFFF00u);
+  EXPECT_EQ (Para->Lease, 3600u);
+  EXPECT_FALSE (Para->RapidCommit);
+  FreePool (Para);
+}
+
+// Test that the Rapid Commit option, which has no data, is parsed
+TEST_F (DhcpValidateOptionsTest, AckWithRapidCommit) {
+  DHCP_PARAMETER  *Para;
+
+  AppendAckOptions ();
+  AppendOption (DHCP4_TAG_RAPID_COMMIT, 0, NULL);
+  EndOptions ();
+
+  ASSERT_EQ (DhcpValidateOptions (Packet, &Para), EFI_SUCCESS);
+  ASSERT_NE (Para, nullptr);
+  EXPECT_EQ (Para->DhcpType, DHCP_MSG_ACK);
+  EXPECT_TRUE (Para->RapidCommit);
+  FreePool (Para);
+}
+
+// Test that an option without data doesn't take over the option parsed
+// before it, whatever the order of the options is
+TEST_F (DhcpValidateOptionsTest, RapidCommitBeforeOtherOptions) {
+  DHCP_PARAMETER  *Para;
+
+  AppendOption (DHCP4_TAG_RAPID_COMMIT, 0, NULL);
+  AppendAckOptions ();
+  EndOptions ();
+
+  ASSERT_EQ (DhcpValidateOptions (Packet, &Para), EFI_SUCCESS);
+  ASSERT_NE (Para, nullptr);
+  EXPECT_EQ (Para->DhcpType, DHCP_MSG_ACK);
+  EXPECT_EQ (Para->ServerId, 0xC0A80001u);
+  EXPECT_EQ (Para->NetMask, 0xFFFFFF00u);
+  EXPECT_TRUE (Para->RapidCommit);
+  FreePool (Para);
+}
+
+// Test that the Rapid Commit option with data is rejected
+TEST_F (DhcpValidateOptionsTest, RapidCommitWithData) {
+  DHCP_PARAMETER  *Para;
+  UINT8           Data = 1;
+
+  AppendAckOptions ();
+  AppendOption (DHCP4_TAG_RAPID_COMMIT, 1, &Data);
+  EndOptions ();
+
+  EXPECT_EQ (DhcpValidateOptions (Packet, &Para), EFI_INVALID_PARAMETER);
+  EXPECT_EQ (Para, nullptr);
+}
+
+// Test that an option without data is ignored if its format requires data
+TEST_F (DhcpValidateOptionsTest, EmptyOptionIgnored) {
+  DHCP_PARAMETER  *Para;
+
+  AppendOption (DHCP4_TAG_HOSTNAME, 0, NULL);
+  AppendAckOptions ();
+  EndOptions ();
+
+  ASSERT_EQ (DhcpValidateOptions (Packet, &Para), EFI_SUCCESS);
+  ASSERT_NE (Para, nullptr);
+  EXPECT_EQ (Para->NetMask, 0xFFFFFF00u);
+  FreePool (Para);
+}
+
+////////////////////////////////////////////////////////////////////////
+// DhcpAppendOption Tests
+////////////////////////////////////////////////////////////////////////
+
+// Test that an option without data is appended as the tag and a zero length
+TEST (DhcpAppendOptionTest, OptionWithoutData) {
+  UINT8  Buffer[4];
+  UINT8  *End;
+
+  SetMem (Buffer, sizeof (Buffer), 0xFF);
+  End = DhcpAppendOption (Buffer, DHCP4_TAG_RAPID_COMMIT, 0, NULL);
+
+  EXPECT_EQ (End, Buffer + 2);
+  EXPECT_EQ (Buffer[0], DHCP4_TAG_RAPID_COMMIT);
+  EXPECT_EQ (Buffer[1], 0);
+  EXPECT_EQ (Buffer[2], 0xFF);
+}
+
+// Test that an option longer than 255 bytes is split
+TEST (DhcpAppendOptionTest, LongOption) {
+  UINT8  Data[300];
+  UINT8  Buffer[310];
+  UINT8  *End;
+
+  SetMem (Data, sizeof (Data), 0x5A);
+  End = DhcpAppendOption (Buffer, DHCP4_TAG_VENDOR, sizeof (Data), Data);
+
+  EXPECT_EQ (End, Buffer + sizeof (Data) + 4);
+  EXPECT_EQ (Buffer[0], DHCP4_TAG_VENDOR);
+  EXPECT_EQ (Buffer[1], 255);
+  EXPECT_EQ (Buffer[257], DHCP4_TAG_VENDOR);
+  EXPECT_EQ (Buffer[258], 45);
+}
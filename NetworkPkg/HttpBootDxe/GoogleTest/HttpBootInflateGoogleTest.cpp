@@ -0,0 +1,296 @@
+/** @file
+  Tests for the streaming gzip decoder in HttpBootInflate.c.
+
+  Copyright (c) 2026, agent. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+**/
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+extern "C" {
+  #include <Uefi.h>
+  #include <Library/BaseLib.h>
+  #include <Library/BaseMemoryLib.h>
+  #include "../HttpBootInflate.h"
+}
+
+////////////////////////////////////////////////////////////////////////
+// Test vectors
+////////////////////////////////////////////////////////////////////////
+
+//
+// "hello hello hello hello\n" compressed with fixed Huffman codes.
+//
+static const UINT8  mFixedGzip[] = {
+  0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xcb, 0x48, 0xcd, 0xc9, 0xc9, 0x57,
+  0xc8, 0x40, 0x27, 0xb9, 0x00, 0x00, 0x88, 0x59, 0x0b, 0x18, 0x00, 0x00, 0x00
+};
+
+//
+// The text of MakeText (4000) compressed with a small symbol buffer, so that the
+// stream holds many blocks with dynamic Huffman codes.
+//
+static const UINT8  mDynamicGzip[] = {
+  0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0x6c, 0x53, 0x41, 0x0e, 0xc3, 0x20,
+  0x0c, 0xbb, 0xfb, 0x15, 0x7c, 0xad, 0xd3, 0xd8, 0x86, 0xd6, 0xad, 0x55, 0xc5, 0xff, 0x35, 0x11,
+  0x92, 0xc5, 0x01, 0x2e, 0x40, 0x43, 0x62, 0x3b, 0x6e, 0x28, 0x9f, 0xed, 0x99, 0xd3, 0x3b, 0x5f,
+  0xdf, 0xbc, 0x27, 0xdc, 0x8e, 0xa3, 0xa6, 0xfd, 0xd8, 0xee, 0xf9, 0xb2, 0x8d, 0x43, 0xf9, 0x51,
+  0x12, 0xa0, 0x1f, 0xb6, 0x6b, 0xad, 0xe4, 0xf9, 0xd2, 0x52, 0x5f, 0xb5, 0x9e, 0x7d, 0x19, 0x41,
+  0xf4, 0x58, 0x84, 0x9c, 0x02, 0x92, 0xac, 0x80, 0x8c, 0x2b, 0xf1, 0x9e, 0x3d, 0xe9, 0x91, 0xbb,
+  0xa8, 0x19, 0x5a, 0xbb, 0x40, 0x95, 0x72, 0x00, 0xad, 0xd4, 0xe9, 0x09, 0x1f, 0x4e, 0x18, 0x41,
+  0xfb, 0xb5, 0x5c, 0x60, 0x6a, 0xca, 0x1b, 0x1f, 0x6c, 0x89, 0x4a, 0x1a, 0x97, 0x88, 0xee, 0xa9,
+  0x04, 0xe9, 0x5a, 0x4c, 0x3c, 0xab, 0x6e, 0x71, 0x3a, 0x5a, 0x9b, 0xac, 0xd2, 0xa0, 0x23, 0x61,
+  0xd0, 0x0e, 0x57, 0xc9, 0xcd, 0xb0, 0x33, 0x86, 0x32, 0xf8, 0xa9, 0x4a, 0x15, 0xc6, 0xb5, 0x6a,
+  0x69, 0x0f, 0x4c, 0x56, 0x30, 0xc9, 0x6c, 0xe2, 0xc2, 0xe2, 0x38, 0x34, 0xec, 0x03, 0x08, 0x90,
+  0xf5, 0xb2, 0x2e, 0x09, 0xac, 0x9a, 0xa1, 0xcc, 0x38, 0xa0, 0x8c, 0x4a, 0x12, 0x18, 0x63, 0xf1,
+  0x18, 0x56, 0x8f, 0xe5, 0xff, 0x63, 0x83, 0x23, 0xd3, 0x28, 0xf9, 0xc0, 0x06, 0xd2, 0xe8, 0xce,
+  0x8f, 0xaf, 0x32, 0xc9, 0x61, 0x18, 0x86, 0x61, 0xe0, 0x9d, 0xff, 0x7f, 0x70, 0x80, 0x1a, 0x96,
+  0xb8, 0xb9, 0x97, 0xa2, 0x49, 0x53, 0x47, 0x22, 0x87, 0x52, 0x79, 0xaf, 0x9a, 0x4a, 0x24, 0x94,
+  0x16, 0xf9, 0x7d, 0xbf, 0xef, 0x8b, 0x3a, 0xc8, 0x3a, 0x29, 0xe0, 0xb6, 0xf4, 0x12, 0x38, 0x4c,
+  0x99, 0x7e, 0x41, 0x9d, 0xb1, 0x19, 0x72, 0xd2, 0xfe, 0x78, 0xb8, 0x4f, 0x91, 0x48, 0xf6, 0xa8,
+  0xbf, 0xd8, 0xe1, 0xf3, 0x60, 0xfa, 0xdc, 0x60, 0x6a, 0xc0, 0xf5, 0x2a, 0x61, 0xca, 0xd9, 0x84,
+  0x39, 0xf3, 0x8a, 0x03, 0x7e, 0x39, 0x67, 0x37, 0x03, 0x93, 0x58, 0x3b, 0x57, 0xd0, 0xf9, 0x00,
+  0x9a, 0x0a, 0xa5, 0xdf, 0x0c, 0x36, 0xab, 0x44, 0xed, 0xa8, 0x06, 0xc9, 0x8b, 0x73, 0xb1, 0x79,
+  0x20, 0x49, 0x6d, 0x20, 0x89, 0x20, 0xa2, 0xda, 0x28, 0xe3, 0xb5, 0xd6, 0x28, 0x2e, 0x44, 0xed,
+  0x10, 0xfe, 0x8b, 0xd7, 0x22, 0xbc, 0xac, 0x95, 0x75, 0xd4, 0x5d, 0xf9, 0xd0, 0x66, 0x13, 0x21,
+  0x23, 0xf7, 0x8b, 0xa8, 0xa8, 0x8b, 0x65, 0xa9, 0x98, 0x36, 0x15, 0xaf, 0x02, 0x92, 0xea, 0x5c,
+  0xd2, 0xad, 0xa6, 0xad, 0x1b, 0x45, 0xa0, 0xb6, 0x74, 0xb9, 0x78, 0x35, 0x56, 0x24, 0x90, 0x0b,
+  0xd4, 0x70, 0x4b, 0x4f, 0x91, 0xe0, 0xb4, 0x8e, 0x27, 0x5e, 0x92, 0xca, 0x0f, 0xc5, 0xae, 0xf4,
+  0x74, 0xe9, 0x29, 0x48, 0xdb, 0xdf, 0x1b, 0xfb, 0x08, 0x43, 0x9f, 0x27, 0xa0, 0xf3, 0xd4, 0x23,
+  0x3c, 0x95, 0x51, 0x1b, 0x49, 0x0e, 0x62, 0x62, 0x04, 0x9e, 0x06, 0x36, 0xce, 0x19, 0x02, 0xfc,
+  0xd9, 0xcb, 0xe9, 0x95, 0x81, 0x80, 0x66, 0x3b, 0x95, 0xf5, 0x02, 0x8b, 0x94, 0x1b, 0x25, 0x20,
+  0x4b, 0xfc, 0x2b, 0xbc, 0x4c, 0x92, 0x00, 0x04, 0x81, 0x18, 0x78, 0x9f, 0xff, 0x3f, 0x58, 0xad,
+  0xb2, 0x30, 0x49, 0x07, 0xf1, 0x0c, 0xc8, 0x2c, 0xc9, 0x34, 0x69, 0x63, 0xf3, 0x7c, 0xa5, 0xf9,
+  0xbe, 0xdf, 0x1c, 0x67, 0x55, 0xb0, 0x8a, 0x35, 0x8c, 0xb1, 0x00, 0x20, 0xd0, 0xf2, 0x25, 0x44,
+  0x95, 0xba, 0x5f, 0xc9, 0x1c, 0xb4, 0xbe, 0xcf, 0xb9, 0x75, 0x18, 0x98, 0xd3, 0x94, 0x1e, 0xfe,
+  0x39, 0x7e, 0x23, 0xe3, 0x31, 0x0b, 0x20, 0xaa, 0x32, 0xb4, 0xdb, 0x66, 0x74, 0x27, 0x3e, 0x2c,
+  0xde, 0x4c, 0x21, 0x68, 0x44, 0xc3, 0xb9, 0x9b, 0xc7, 0xd1, 0xcc, 0xcf, 0x20, 0xb6, 0x36, 0x37,
+  0x4d, 0xa2, 0x2d, 0x28, 0x65, 0x0e, 0xd9, 0xe8, 0xd5, 0x52, 0x89, 0xaf, 0x0f, 0x85, 0xb3, 0xf1,
+  0x10, 0x40, 0x41, 0x6c, 0x88, 0xc2, 0x19, 0xb0, 0xe4, 0xcd, 0x63, 0x09, 0xc5, 0xe2, 0x46, 0x1d,
+  0xc9, 0x3a, 0xb6, 0x3e, 0xd5, 0x66, 0x55, 0x03, 0x4d, 0x34, 0xfe, 0xea, 0x4f, 0xa9, 0xfd, 0xdb,
+  0xa8, 0x9a, 0x43, 0x78, 0xe4, 0xd6, 0x69, 0x30, 0x02, 0xf2, 0xe2, 0xa0, 0x57, 0x51, 0x00, 0x72,
+  0x23, 0xc2, 0xd1, 0x64, 0xec, 0xa4, 0x1e, 0x21, 0x5a, 0x89, 0x12, 0x98, 0x3d, 0x3c, 0xd2, 0x33,
+  0x2d, 0xca, 0xc2, 0x1c, 0xdc, 0xb8, 0x24, 0xd4, 0x06, 0x94, 0x2a, 0x29, 0xd7, 0x17, 0x95, 0xc1,
+  0x7d, 0xb0, 0x53, 0x07, 0x1f, 0x50, 0xe1, 0xe7, 0xf1, 0x72, 0xf7, 0xd2, 0x05, 0x39, 0xab, 0x3e,
+  0x32, 0xa0, 0x0f, 0x00, 0x00
+};
+
+#define DYNAMIC_TEXT_SIZE  4000
+
+////////////////////////////////////////////////////////////////////////
+// Helpers
+////////////////////////////////////////////////////////////////////////
+
+//
+// Build the text the dynamic test vector was made from.
+//
+static std::string
+MakeText (
+  IN UINTN  Size
+  )
+{
+  static const char  *Words[] = { "efi ", "boot ", "http ", "image ", "kernel ", "\n", "loader " };
+  std::string        Text;
+  UINT32             Seed;
+
+  Seed = 1;
+  while (Text.size () < Size) {
+    Seed  = (Seed * 1103515245 + 12345) & 0x7FFFFFFF;
+    Text += Words[(Seed >> 16) % 7];
+  }
+
+  Text.resize (Size);
+  return Text;
+}
+
+//
+// Wrap Data in a gzip member made of stored blocks of at most BlockSize bytes.
+//
+static std::vector<UINT8>
+MakeStoredGzip (
+  IN const std::vector<UINT8>  &Data,
+  IN UINTN                     BlockSize
+  )
+{
+  std::vector<UINT8>  Gzip = { 0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03 };
+  UINTN               Offset;
+  UINTN               Length;
+  UINT32              Crc;
+  UINT32              Size;
+
+  Offset = 0;
+  do {
+    Length = MIN (BlockSize, Data.size () - Offset);
+    Gzip.push_back ((Offset + Length == Data.size ()) ? 1 : 0);
+    Gzip.push_back ((UINT8)Length);
+    Gzip.push_back ((UINT8)(Length >> 8));
+    Gzip.push_back ((UINT8)~Length);
+    Gzip.push_back ((UINT8)(~Length >> 8));
+    Gzip.insert (Gzip.end (), Data.begin () + Offset, Data.begin () + Offset + Length);
+    Offset += Length;
+  } while (Offset < Data.size ());
+
+  Crc  = CalculateCrc32 ((VOID *)Data.data (), Data.size ());
+  Size = (UINT32)Data.size ();
+  for (UINTN Index = 0; Index < 4; Index++) {
+    Gzip.push_back ((UINT8)(Crc >> (Index * 8)));
+  }
+
+  for (UINTN Index = 0; Index < 4; Index++) {
+    Gzip.push_back ((UINT8)(Size >> (Index * 8)));
+  }
+
+  return Gzip;
+}
+
+//
+// Feed Gzip to the decoder in pieces of ChunkSize bytes.
+//
+static EFI_STATUS
+Decode (
+  IN  const UINT8           *Gzip,
+  IN  UINTN                 GzipSize,
+  IN  UINTN                 ChunkSize,
+  OUT std::vector<UINT8>    &Output,
+  OUT HTTP_BOOT_INFLATE     &Inflate
+  )
+{
+  EFI_STATUS  Status;
+  UINTN       Offset;
+
+  HttpBootInflateInit (&Inflate, Output.data (), Output.size ());
+  for (Offset = 0; Offset < GzipSize; Offset += ChunkSize) {
+    Status = HttpBootInflate (&Inflate, Gzip + Offset, MIN (ChunkSize, GzipSize - Offset));
+    if (EFI_ERROR (Status)) {
+      return Status;
+    }
+  }
+
+  return EFI_SUCCESS;
+}
+
+////////////////////////////////////////////////////////////////////////
+// HttpBootInflate Tests
+////////////////////////////////////////////////////////////////////////
+
+class HttpBootInflateTest : public ::testing::TestWithParam<UINTN> {
+protected:
+  HTTP_BOOT_INFLATE Inflate;
+};
+
+// Test Description:
+// A block compressed with fixed Huffman codes is decoded whatever the
+// size of the pieces the stream arrives in.
+TEST_P (HttpBootInflateTest, FixedHuffmanBlock) {
+  std::vector<UINT8>  Output (64);
+
+  ASSERT_EQ (Decode (mFixedGzip, sizeof (mFixedGzip), GetParam (), Output, Inflate), EFI_SUCCESS);
+  ASSERT_EQ (Inflate.State, HttpBootInflateDone);
+  ASSERT_EQ (Inflate.OutputLength, (UINTN)24);
+  EXPECT_EQ (std::string ((char *)Output.data (), 24), "hello hello hello hello\n");
+}
+
+// Test Description:
+// Blocks compressed with dynamic Huffman codes are decoded whatever the
+// size of the pieces the stream arrives in.
+TEST_P (HttpBootInflateTest, DynamicHuffmanBlocks) {
+  std::vector<UINT8>  Output (DYNAMIC_TEXT_SIZE);
+
+  ASSERT_EQ (Decode (mDynamicGzip, sizeof (mDynamicGzip), GetParam (), Output, Inflate), EFI_SUCCESS);
+  ASSERT_EQ (Inflate.State, HttpBootInflateDone);
+  ASSERT_EQ (Inflate.OutputLength, (UINTN)DYNAMIC_TEXT_SIZE);
+  EXPECT_EQ (std::string ((char *)Output.data (), DYNAMIC_TEXT_SIZE), MakeText (DYNAMIC_TEXT_SIZE));
+}
+
+// Test Description:
+// Stored blocks are copied whatever the size of the pieces the stream
+// arrives in.
+TEST_P (HttpBootInflateTest, StoredBlocks) {
+  std::vector<UINT8>  Data (3000);
+  std::vector<UINT8>  Gzip;
+  std::vector<UINT8>  Output (Data.size ());
+
+  for (UINTN Index = 0; Index < Data.size (); Index++) {
+    Data[Index] = (UINT8)(Index * 7 + (Index >> 8));
+  }
+
+  Gzip = MakeStoredGzip (Data, 1000);
+  ASSERT_EQ (Decode (Gzip.data (), Gzip.size (), GetParam (), Output, Inflate), EFI_SUCCESS);
+  ASSERT_EQ (Inflate.State, HttpBootInflateDone);
+  EXPECT_EQ (Output, Data);
+}
+
+INSTANTIATE_TEST_SUITE_P (
+  ChunkSizes,
+  HttpBootInflateTest,
+  ::testing::Values (1, 2, 3, 7, 64, 1500, 65536)
+  );
+
+// Test Description:
+// The optional fields of the gzip header are skipped.
+TEST (HttpBootInflateHeaderTest, OptionalFieldsSkipped) {
+  HTTP_BOOT_INFLATE   Inflate;
+  std::vector<UINT8>  Gzip = { 0x1f, 0x8b, 0x08, 0x1e, 0, 0, 0, 0, 0, 0x03 };
+  std::vector<UINT8>  Output (64);
+
+  // FEXTRA, FNAME, FCOMMENT and FHCRC.
+  Gzip.insert (Gzip.end (), { 0x03, 0x00, 'a', 'b', 'c' });
+  Gzip.insert (Gzip.end (), { 'b', 'o', 'o', 't', '.', 'e', 'f', 'i', 0 });
+  Gzip.insert (Gzip.end (), { 'n', 'o', 'n', 'e', 0 });
+  Gzip.insert (Gzip.end (), { 0x12, 0x34 });
+  Gzip.insert (Gzip.end (), mFixedGzip + 10, mFixedGzip + sizeof (mFixedGzip));
+
+  ASSERT_EQ (Decode (Gzip.data (), Gzip.size (), 5, Output, Inflate), EFI_SUCCESS);
+  ASSERT_EQ (Inflate.State, HttpBootInflateDone);
+  EXPECT_EQ (std::string ((char *)Output.data (), Inflate.OutputLength), "hello hello hello hello\n");
+}
+
+// Test Description:
+// Data that is not a gzip member is rejected.
+TEST (HttpBootInflateErrorTest, BadMagic) {
+  HTTP_BOOT_INFLATE   Inflate;
+  std::vector<UINT8>  Gzip (mFixedGzip, mFixedGzip + sizeof (mFixedGzip));
+  std::vector<UINT8>  Output (64);
+
+  Gzip[1] = 0x8c;
+  EXPECT_EQ (Decode (Gzip.data (), Gzip.size (), Gzip.size (), Output, Inflate), EFI_VOLUME_CORRUPTED);
+}
+
+// Test Description:
+// A CRC32 mismatch in the trailer is reported.
+TEST (HttpBootInflateErrorTest, BadCrc) {
+  HTTP_BOOT_INFLATE   Inflate;
+  std::vector<UINT8>  Gzip (mFixedGzip, mFixedGzip + sizeof (mFixedGzip));
+  std::vector<UINT8>  Output (64);
+
+  Gzip[Gzip.size () - 8] ^= 0x01;
+  EXPECT_EQ (Decode (Gzip.data (), Gzip.size (), Gzip.size (), Output, Inflate), EFI_VOLUME_CORRUPTED);
+}
+
+// Test Description:
+// A back reference before the start of the data is rejected.
+TEST (HttpBootInflateErrorTest, DistanceTooFar) {
+  HTTP_BOOT_INFLATE   Inflate;
+  std::vector<UINT8>  Output (64);
+
+  //
+  // Fixed Huffman block: length 3 (symbol 257) at distance 1 (symbol 0)
+  // with no data decoded yet.
+  //
+  static const UINT8  Gzip[] = {
+    0x1f, 0x8b, 0x08, 0x00, 0, 0, 0, 0, 0, 0x03,
+    0x03, 0x02, 0x00
+  };
+
+  EXPECT_EQ (Decode (Gzip, sizeof (Gzip), sizeof (Gzip), Output, Inflate), EFI_VOLUME_CORRUPTED);
+}
+
+// Test Description:
+// Decoded data larger than the output buffer is reported.
+TEST (HttpBootInflateErrorTest, OutputTooSmall) {
+  HTTP_BOOT_INFLATE   Inflate;
+  std::vector<UINT8>  Output (DYNAMIC_TEXT_SIZE - 1);
+
+  EXPECT_EQ (Decode (mDynamicGzip, sizeof (mDynamicGzip), 100, Output, Inflate), EFI_BUFFER_TOO_SMALL);
+}
@@ -597,26 +597,26 @@ HttpBootHttpIoCallback (
 }
 
 /**
-  Create a HttpIo instance for the file download.
+  Create and configure a HttpIo instance on the boot NIC.
 
   @param[in]    Private        The pointer to the driver's private data.
+  @param[out]   HttpIo         The HttpIo instance to initialize.
 
   @retval EFI_SUCCESS          Successfully created.
   @retval Others               Failed to create HttpIo.
 
 **/
+STATIC
 EFI_STATUS
-HttpBootCreateHttpIo (
-  IN     HTTP_BOOT_PRIVATE_DATA  *Private
+HttpBootInitHttpIo (
+  IN     HTTP_BOOT_PRIVATE_DATA  *Private,
+  OUT    HTTP_IO                 *HttpIo
   )
 {
   HTTP_IO_CONFIG_DATA  ConfigData;
-  EFI_STATUS           Status;
   EFI_HANDLE           ImageHandle;
   UINT32               TimeoutValue;
 
-  ASSERT (Private != NULL);
-
   //
   // Get HTTP timeout value
   //
@@ -636,15 +636,36 @@ HttpBootCreateHttpIo (
     ImageHandle = Private->Ip6Nic->ImageHandle;
   }
 
-  Status = HttpIoCreateIo (
-             ImageHandle,
-             Private->Controller,
-             Private->UsingIpv6 ? IP_VERSION_6 : IP_VERSION_4,
-             &ConfigData,
-             HttpBootHttpIoCallback,
-             (VOID *)Private,
-             &Private->HttpIo
-             );
+  return HttpIoCreateIo (
+           ImageHandle,
+           Private->Controller,
+           Private->UsingIpv6 ? IP_VERSION_6 : IP_VERSION_4,
+           &ConfigData,
+           HttpBootHttpIoCallback,
+           (VOID *)Private,
+           HttpIo
+           );
+}
+
+/**
+  Create a HttpIo instance for the file download.
+
+  @param[in]    Private        The pointer to the driver's private data.
+
+  @retval EFI_SUCCESS          Successfully created.
+  @retval Others               Failed to create HttpIo.
+
+**/
+EFI_STATUS
+HttpBootCreateHttpIo (
+  IN     HTTP_BOOT_PRIVATE_DATA  *Private
+  )
+{
+  EFI_STATUS  Status;
+
+  ASSERT (Private != NULL);
+
+  Status = HttpBootInitHttpIo (Private, &Private->HttpIo);
   if (EFI_ERROR (Status)) {
     return Status;
   }
@@ -867,6 +888,13 @@ HttpBootGetBootFileCallback (
     }
   }
 
+  //
+  // A gzip encoded message-body is decoded to the caller's buffer.
+  //
+  if (CallbackData->Inflate != NULL) {
+    return HttpBootInflate (CallbackData->Inflate, (UINT8 *)Data, Length);
+  }
+
   //
   // Copy data if caller has provided a buffer.
   //
@@ -962,6 +990,8 @@ HttpBootGetBootFile (
   BOOLEAN                  ResumingOperation;
   CHAR8                    *ContentRangeResponseValue;
   CHAR8                    RangeValue[64];
+  BOOLEAN                  AcceptEncoding;
+  HTTP_BOOT_INFLATE        *Inflate;
 
   ASSERT (Private != NULL);
   ASSERT (Private->HttpCreated);
@@ -1002,6 +1032,16 @@ HttpBootGetBootFile (
     ResumingOperation = FALSE;
   }
 
+  //
+  // Only ask for a gzip encoded file when it can be decoded to the caller's buffer.
+  // A download is only resumed when it was not encoded.
+  //
+  AcceptEncoding = (BOOLEAN)(PcdGetBool (PcdHttpBootContentEncoding) &&
+                             !Private->ContentEncodingDisabled &&
+                             !ResumingOperation &&
+                             (HeaderOnly || ((Buffer != NULL) && (*BufferSize != 0))));
+  Inflate = NULL;
+
   //
   // Not found in cache, try to download it through HTTP.
   //
@@ -1033,6 +1073,7 @@ HttpBootGetBootFile (
   //       [Authorization]
   //       [Range]
   //       [If-Match]|[If-Unmodified-Since]
+  //       [Accept-Encoding]
   //
   HeadersCount = 3;
   if (Private->AuthData != NULL) {
@@ -1046,6 +1087,10 @@ HttpBootGetBootFile (
     }
   }
 
+  if (AcceptEncoding) {
+    HeadersCount++;
+  }
+
   HttpIoHeader = HttpIoCreateHeader (HeadersCount);
 
   if (HttpIoHeader == NULL) {
@@ -1104,7 +1149,7 @@ HttpBootGetBootFile (
   // Add HTTP header field 4: Authorization
   //
   if (Private->AuthData != NULL) {
-    ASSERT (HttpIoHeader->MaxHeaderCount == 4);
+    ASSERT (HttpIoHeader->MaxHeaderCount >= 4);
 
     if ((Private->AuthScheme != NULL) && (CompareMem (Private->AuthScheme, "Basic", 5) != 0)) {
       Status = EFI_UNSUPPORTED;
@@ -1185,6 +1230,16 @@ HttpBootGetBootFile (
     }
   }
 
+  //
+  // Add HTTP header field 7 (optional): Accept-Encoding
+  //
+  if (AcceptEncoding) {
+    Status = HttpIoSetHeader (HttpIoHeader, HTTP_HEADER_ACCEPT_ENCODING, HTTP_CONTENT_ENCODING_GZIP);
+    if (EFI_ERROR (Status)) {
+      goto ERROR_3;
+    }
+  }
+
   //
   // 2.2 Build the rest of HTTP request info.
   //
@@ -1389,6 +1444,42 @@ HttpBootGetBootFile (
     }
   }
 
+  //
+  // 3.2.3 Check whether the server encoded the message-body. A gzip encoded
+  // message-body is decoded to the caller's buffer while it is received.
+  //
+  if (AcceptEncoding) {
+    HttpHeader = HttpFindHeader (
+                   ResponseData->HeaderCount,
+                   ResponseData->Headers,
+                   HTTP_HEADER_CONTENT_ENCODING
+                   );
+    if ((HttpHeader != NULL) &&
+        (AsciiStriCmp (HttpHeader->FieldValue, HTTP_CONTENT_ENCODING_GZIP) != 0) &&
+        (AsciiStriCmp (HttpHeader->FieldValue, "x-gzip") != 0) &&
+        (AsciiStriCmp (HttpHeader->FieldValue, HTTP_CONTENT_ENCODING_IDENTITY) != 0))
+    {
+      DEBUG ((DEBUG_ERROR, "HttpBootGetBootFile: Unsupported Content-Encoding: %a\n", HttpHeader->FieldValue));
+      Status = EFI_UNSUPPORTED;
+      goto ERROR_5;
+    }
+
+    if (HeaderOnly) {
+      Private->ContentEncoded = (BOOLEAN)((HttpHeader != NULL) &&
+                                          (AsciiStriCmp (HttpHeader->FieldValue, HTTP_CONTENT_ENCODING_IDENTITY) != 0));
+    } else if ((HttpHeader != NULL) &&
+               (AsciiStriCmp (HttpHeader->FieldValue, HTTP_CONTENT_ENCODING_IDENTITY) != 0))
+    {
+      Inflate = AllocatePool (sizeof (HTTP_BOOT_INFLATE));
+      if (Inflate == NULL) {
+        Status = EFI_OUT_OF_RESOURCES;
+        goto ERROR_5;
+      }
+
+      HttpBootInflateInit (Inflate, Buffer, *BufferSize);
+    }
+  }
+
   //
   // 3.3 Init a message-body parser from the header information.
   //
@@ -1399,6 +1490,7 @@ HttpBootGetBootFile (
   Context.Buffer     = Buffer;
   Context.BufferSize = *BufferSize;
   Context.Cache      = Cache;
+  Context.Inflate    = Inflate;
   Context.Private    = Private;
   Status             = HttpInitMsgParser (
                          HeaderOnly ? HttpMethodHead : HttpMethodGet,
@@ -1419,11 +1511,12 @@ HttpBootGetBootFile (
   Block = NULL;
   if (!HeaderOnly) {
     //
-    // 3.4.1, check whether we are in identity transfer-coding.
+    // 3.4.1, check whether we are in identity transfer-coding. An encoded
+    //        message-body always goes through the parser, which decodes it.
     //
     ContentLength = 0;
     Status        = HttpGetEntityLength (Parser, &ContentLength);
-    if (!EFI_ERROR (Status)) {
+    if (!EFI_ERROR (Status) && (Inflate == NULL)) {
       IdentityMode = TRUE;
     } else {
       IdentityMode = FALSE;
@@ -1551,7 +1644,14 @@ HttpBootGetBootFile (
   //
   // 3.5 Message-body receive & parse is completed, we should be able to get the file size now.
   //
-  if (!ResumingOperation) {
+  if (Inflate != NULL) {
+    if (Inflate->State != HttpBootInflateDone) {
+      Status = EFI_VOLUME_CORRUPTED;
+      goto ERROR_6;
+    }
+
+    ContentLength = Inflate->OutputLength;
+  } else if (!ResumingOperation) {
     Status = HttpGetEntityLength (Parser, &ContentLength);
     if (EFI_ERROR (Status)) {
       goto ERROR_6;
@@ -1580,6 +1680,10 @@ HttpBootGetBootFile (
     HttpFreeMsgParser (Parser);
   }
 
+  if (Inflate != NULL) {
+    FreePool (Inflate);
+  }
+
   return Status;
 
 ERROR_6:
@@ -1587,6 +1691,10 @@ ERROR_6:
     HttpFreeMsgParser (Parser);
   }
 
+  if (Inflate != NULL) {
+    FreePool (Inflate);
+  }
+
   if (Context.Block != NULL) {
     FreePool (Context.Block);
   }
@@ -1617,3 +1725,775 @@ ERROR_1:
 
   return Status;
 }
+
+/**
+  Build the request headers shared by all ranges of the boot file. A slot is
+  left for the Range header, which is set before each request.
+
+  @param[in]    Private        The pointer to the driver's private data.
+  @param[in]    AcceptEncoding Whether to accept a gzip encoded message-body.
+  @param[out]   HttpIoHeader   Return the HTTP header holder.
+
+  @retval EFI_SUCCESS          The headers were built.
+  @retval EFI_UNSUPPORTED      The authentication scheme is not supported.
+  @retval Others               Failed to build the headers.
+
+**/
+STATIC
+EFI_STATUS
+HttpBootBuildRangeHeader (
+  IN     HTTP_BOOT_PRIVATE_DATA  *Private,
+  IN     BOOLEAN                 AcceptEncoding,
+  OUT    HTTP_IO_HEADER          **HttpIoHeader
+  )
+{
+  EFI_STATUS      Status;
+  HTTP_IO_HEADER  *Header;
+  CHAR8           *HostName;
+  CHAR8           BaseAuthValue[80];
+  UINTN           HeadersCount;
+
+  //
+  // Host, Accept, User-Agent and Range, plus the optional Authorization,
+  // If-Match|If-Unmodified-Since and Accept-Encoding.
+  //
+  HeadersCount = 4;
+  if (Private->AuthData != NULL) {
+    if ((Private->AuthScheme != NULL) && (CompareMem (Private->AuthScheme, "Basic", 5) != 0)) {
+      return EFI_UNSUPPORTED;
+    }
+
+    HeadersCount++;
+  }
+
+  if (Private->LastModifiedOrEtag != NULL) {
+    HeadersCount++;
+  }
+
+  if (AcceptEncoding) {
+    HeadersCount++;
+  }
+
+  Header = HttpIoCreateHeader (HeadersCount);
+  if (Header == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  HostName = NULL;
+  Status   = HttpUrlGetHostName (
+               Private->BootFileUri,
+               Private->BootFileUriParser,
+               &HostName
+               );
+  if (EFI_ERROR (Status)) {
+    goto ON_ERROR;
+  }
+
+  Status = HttpIoSetHeader (Header, HTTP_HEADER_HOST, HostName);
+  FreePool (HostName);
+  if (EFI_ERROR (Status)) {
+    goto ON_ERROR;
+  }
+
+  Status = HttpIoSetHeader (Header, HTTP_HEADER_ACCEPT, "*/*");
+  if (EFI_ERROR (Status)) {
+    goto ON_ERROR;
+  }
+
+  Status = HttpIoSetHeader (Header, HTTP_HEADER_USER_AGENT, HTTP_USER_AGENT_EFI_HTTP_BOOT);
+  if (EFI_ERROR (Status)) {
+    goto ON_ERROR;
+  }
+
+  if (Private->AuthData != NULL) {
+    AsciiSPrint (BaseAuthValue, sizeof (BaseAuthValue), "%a %a", "Basic", Private->AuthData);
+    Status = HttpIoSetHeader (Header, HTTP_HEADER_AUTHORIZATION, BaseAuthValue);
+    if (EFI_ERROR (Status)) {
+      goto ON_ERROR;
+    }
+  }
+
+  //
+  // Make sure all ranges come from the same version of the file.
+  //
+  if (Private->LastModifiedOrEtag != NULL) {
+    if (Private->LastModifiedOrEtag[0] == '"') {
+      Status = HttpIoSetHeader (Header, HTTP_HEADER_IF_MATCH, Private->LastModifiedOrEtag);
+    } else {
+      Status = HttpIoSetHeader (Header, HTTP_HEADER_IF_UNMODIFIED_SINCE, Private->LastModifiedOrEtag);
+    }
+
+    if (EFI_ERROR (Status)) {
+      goto ON_ERROR;
+    }
+  }
+
+  if (AcceptEncoding) {
+    Status = HttpIoSetHeader (Header, HTTP_HEADER_ACCEPT_ENCODING, HTTP_CONTENT_ENCODING_GZIP);
+    if (EFI_ERROR (Status)) {
+      goto ON_ERROR;
+    }
+  }
+
+  *HttpIoHeader = Header;
+  return EFI_SUCCESS;
+
+ON_ERROR:
+  HttpIoFreeHeader (Header);
+  return Status;
+}
+
+/**
+  Check that the response header of a range request carries exactly the range
+  requested by the connection.
+
+  @param[in]    Private        The pointer to the driver's private data.
+  @param[in]    Connection     The connection which received the response.
+
+  @retval EFI_SUCCESS          The server returned the requested range.
+  @retval EFI_UNSUPPORTED      The server did not return the requested range.
+
+**/
+STATIC
+EFI_STATUS
+HttpBootCheckRangeResponse (
+  IN     HTTP_BOOT_PRIVATE_DATA      *Private,
+  IN     HTTP_BOOT_RANGE_CONNECTION  *Connection
+  )
+{
+  EFI_HTTP_MESSAGE  *Message;
+  EFI_HTTP_HEADER   *HttpHeader;
+  CHAR8             *Value;
+  UINTN             Start;
+  UINTN             End;
+
+  Message = Connection->HttpIo.RspToken.Message;
+  if (Connection->ResponseData.StatusCode != HTTP_STATUS_206_PARTIAL_CONTENT) {
+    DEBUG ((
+      DEBUG_WARN,
+      "HttpBootCheckRangeResponse: Range request answered with status code %d.\n",
+      Connection->ResponseData.StatusCode
+      ));
+    return EFI_UNSUPPORTED;
+  }
+
+  //
+  // Content-Range: bytes <range-start>-<range-end>/<size>
+  //
+  HttpHeader = HttpFindHeader (Message->HeaderCount, Message->Headers, HTTP_HEADER_CONTENT_RANGE);
+  if ((HttpHeader == NULL) || (AsciiStrnCmp (HttpHeader->FieldValue, "bytes ", 6) != 0)) {
+    return EFI_UNSUPPORTED;
+  }
+
+  Value = HttpHeader->FieldValue + 6;
+  Start = AsciiStrDecimalToUintn (Value);
+  Value = AsciiStrStr (Value, "-");
+  if (Value == NULL) {
+    return EFI_UNSUPPORTED;
+  }
+
+  End   = AsciiStrDecimalToUintn (Value + 1);
+  Value = AsciiStrStr (Value, "/");
+  if ((Value == NULL) ||
+      (AsciiStrDecimalToUintn (Value + 1) != Private->BootFileSize) ||
+      (Start != Connection->Offset) ||
+      (End != Connection->End - 1))
+  {
+    DEBUG ((
+      DEBUG_WARN,
+      "HttpBootCheckRangeResponse: Unexpected Content-Range: %a\n",
+      HttpHeader->FieldValue
+      ));
+    return EFI_UNSUPPORTED;
+  }
+
+  return EFI_SUCCESS;
+}
+
+/**
+  Queue a response token on the connection, either for the response header or
+  for the message-body of the current range, and start the receive timer.
+
+  @param[in, out] Connection   The connection.
+  @param[in]      Buffer       The buffer the boot file is downloaded to.
+  @param[in]      RecvHeader   TRUE to receive the response header, FALSE to
+                               receive the message-body.
+
+  @retval EFI_SUCCESS          The token was queued.
+  @retval Others               Failed to queue the token.
+
+**/
+STATIC
+EFI_STATUS
+HttpBootQueueRangeResponse (
+  IN OUT HTTP_BOOT_RANGE_CONNECTION  *Connection,
+  IN     UINT8                       *Buffer,
+  IN     BOOLEAN                     RecvHeader
+  )
+{
+  EFI_STATUS  Status;
+  HTTP_IO     *HttpIo;
+
+  HttpIo                                = &Connection->HttpIo;
+  HttpIo->RspToken.Status               = EFI_NOT_READY;
+  HttpIo->RspToken.Message->HeaderCount = 0;
+  HttpIo->RspToken.Message->Headers     = NULL;
+  if (RecvHeader) {
+    HttpIo->RspToken.Message->Data.Response = &Connection->ResponseData;
+    HttpIo->RspToken.Message->BodyLength    = 0;
+    HttpIo->RspToken.Message->Body          = NULL;
+  } else {
+    HttpIo->RspToken.Message->Data.Response = NULL;
+    HttpIo->RspToken.Message->BodyLength    = Connection->End - Connection->Offset;
+    HttpIo->RspToken.Message->Body          = Buffer + Connection->Offset;
+  }
+
+  HttpIo->IsRxDone = FALSE;
+  Status           = gBS->SetTimer (HttpIo->TimeoutEvent, TimerRelative, HttpIo->Timeout * TICKS_PER_MS);
+  if (EFI_ERROR (Status)) {
+    return Status;
+  }
+
+  Status = HttpIo->Http->Response (HttpIo->Http, &HttpIo->RspToken);
+  if (EFI_ERROR (Status)) {
+    gBS->SetTimer (HttpIo->TimeoutEvent, TimerCancel, 0);
+    return Status;
+  }
+
+  Connection->State = RecvHeader ? HttpBootRangeRecvHeader : HttpBootRangeRecvBody;
+  return EFI_SUCCESS;
+}
+
+/**
+  Advance the ranged download on one connection without blocking. An idle
+  connection requests the next range of the boot file; a busy connection
+  checks whether its pending token has completed and queues the next one.
+
+  @param[in]      Private        The pointer to the driver's private data.
+  @param[in, out] Connection     The connection.
+  @param[in]      Connections    The number of connections in the download.
+  @param[in]      Buffer         The buffer the boot file is downloaded to.
+  @param[in, out] NextOffset     The start of the part of the file not yet
+                                 assigned to any connection.
+  @param[in, out] ReceivedSize   The number of bytes received on all connections.
+
+  @retval EFI_SUCCESS          The connection is progressing or has nothing to do.
+  @retval EFI_UNSUPPORTED      The server did not return the requested range.
+  @retval EFI_TIMEOUT          No response was received in time.
+  @retval Others               The current range failed.
+
+**/
+STATIC
+EFI_STATUS
+HttpBootProcessRangeConnection (
+  IN     HTTP_BOOT_PRIVATE_DATA      *Private,
+  IN OUT HTTP_BOOT_RANGE_CONNECTION  *Connection,
+  IN     UINTN                       Connections,
+  IN     UINT8                       *Buffer,
+  IN OUT UINTN                       *NextOffset,
+  IN OUT UINTN                       *ReceivedSize
+  )
+{
+  EFI_STATUS  Status;
+  HTTP_IO     *HttpIo;
+  UINTN       Size;
+  UINTN       Share;
+  UINTN       Length;
+  CHAR8       RangeValue[64];
+
+  HttpIo = &Connection->HttpIo;
+
+  switch (Connection->State) {
+    case HttpBootRangeIdle:
+      if (Connection->Offset == Connection->End) {
+        if (*NextOffset == Private->BootFileSize) {
+          return EFI_SUCCESS;
+        }
+
+        //
+        // Take the next range. Near the end of the file, shrink the range so the
+        // rest of the file is spread over all connections instead of leaving one
+        // connection with a long tail.
+        //
+        Size  = Connection->RangeSize;
+        Share = (Private->BootFileSize - *NextOffset) / Connections;
+        if (Size > Share) {
+          Size = MAX (Share, HTTP_BOOT_RANGE_MIN_SIZE);
+        }
+
+        Size                = MIN (Size, Private->BootFileSize - *NextOffset);
+        Connection->Offset  = *NextOffset;
+        Connection->End     = *NextOffset + Size;
+        Connection->Retries = 0;
+        *NextOffset        += Size;
+      }
+
+      AsciiSPrint (
+        RangeValue,
+        sizeof (RangeValue),
+        "bytes=%lu-%lu",
+        (UINT64)Connection->Offset,
+        (UINT64)(Connection->End - 1)
+        );
+      Status = HttpIoSetHeader (Connection->HttpIoHeader, "Range", RangeValue);
+      if (EFI_ERROR (Status)) {
+        return Status;
+      }
+
+      HttpIo->ReqToken.Status                = EFI_NOT_READY;
+      HttpIo->ReqToken.Message->Data.Request = &Connection->RequestData;
+      HttpIo->ReqToken.Message->HeaderCount  = Connection->HttpIoHeader->HeaderCount;
+      HttpIo->ReqToken.Message->Headers      = Connection->HttpIoHeader->Headers;
+      HttpIo->ReqToken.Message->BodyLength   = 0;
+      HttpIo->ReqToken.Message->Body         = NULL;
+
+      HttpIo->IsTxDone = FALSE;
+      Status           = HttpIo->Http->Request (HttpIo->Http, &HttpIo->ReqToken);
+      if (EFI_ERROR (Status)) {
+        return Status;
+      }
+
+      Connection->State = HttpBootRangeSendRequest;
+      return EFI_SUCCESS;
+
+    case HttpBootRangeSendRequest:
+      if (!HttpIo->IsTxDone) {
+        return EFI_SUCCESS;
+      }
+
+      if (EFI_ERROR (HttpIo->ReqToken.Status)) {
+        return HttpIo->ReqToken.Status;
+      }
+
+      return HttpBootQueueRangeResponse (Connection, Buffer, TRUE);
+
+    case HttpBootRangeRecvHeader:
+    case HttpBootRangeRecvBody:
+      if (!HttpIo->IsRxDone) {
+        if (!EFI_ERROR (gBS->CheckEvent (HttpIo->TimeoutEvent))) {
+          return EFI_TIMEOUT;
+        }
+
+        return EFI_SUCCESS;
+      }
+
+      gBS->SetTimer (HttpIo->TimeoutEvent, TimerCancel, 0);
+      Status = HttpIo->RspToken.Status;
+      if (Connection->State == HttpBootRangeRecvHeader) {
+        //
+        // EFI_HTTP_ERROR still carries the response header, the status code
+        // tells what went wrong.
+        //
+        if (EFI_ERROR (Status) && (Status != EFI_HTTP_ERROR)) {
+          return Status;
+        }
+
+        Status = HttpBootCheckRangeResponse (Private, Connection);
+        if (HttpIo->RspToken.Message->Headers != NULL) {
+          HttpFreeHeaderFields (HttpIo->RspToken.Message->Headers, HttpIo->RspToken.Message->HeaderCount);
+        }
+
+        if (EFI_ERROR (Status)) {
+          return Status;
+        }
+
+        return HttpBootQueueRangeResponse (Connection, Buffer, FALSE);
+      }
+
+      if (EFI_ERROR (Status)) {
+        return Status;
+      }
+
+      Length = HttpIo->RspToken.Message->BodyLength;
+      if (Private->HttpBootCallback != NULL) {
+        Status = Private->HttpBootCallback->Callback (
+                                              Private->HttpBootCallback,
+                                              HttpBootHttpEntityBody,
+                                              TRUE,
+                                              (UINT32)Length,
+                                              Buffer + Connection->Offset
+                                              );
+        if (EFI_ERROR (Status)) {
+          return EFI_ABORTED;
+        }
+      }
+
+      Connection->Offset += Length;
+      *ReceivedSize      += Length;
+      if (Connection->Offset < Connection->End) {
+        return HttpBootQueueRangeResponse (Connection, Buffer, FALSE);
+      }
+
+      //
+      // The range is complete, ask for a larger one next time.
+      //
+      Connection->State     = HttpBootRangeIdle;
+      Connection->RangeSize = MIN (Connection->RangeSize * 2, HTTP_BOOT_RANGE_MAX_SIZE);
+      return EFI_SUCCESS;
+
+    default:
+      ASSERT (FALSE);
+      return EFI_DEVICE_ERROR;
+  }
+}
+
+/**
+  Abort the pending tokens of a connection and release its HttpIo.
+
+  @param[in, out] Connection   The connection.
+
+**/
+STATIC
+VOID
+HttpBootCloseRangeConnection (
+  IN OUT HTTP_BOOT_RANGE_CONNECTION  *Connection
+  )
+{
+  if (!Connection->HttpCreated) {
+    return;
+  }
+
+  gBS->SetTimer (Connection->HttpIo.TimeoutEvent, TimerCancel, 0);
+  Connection->HttpIo.Http->Cancel (Connection->HttpIo.Http, NULL);
+
+  //
+  // Let the DPCs queued by the canceled tokens run before their events are closed.
+  //
+  DispatchDpc ();
+  HttpIoDestroyIo (&Connection->HttpIo);
+  Connection->HttpCreated = FALSE;
+  Connection->State       = HttpBootRangeIdle;
+}
+
+/**
+  Download the boot file into a caller provided buffer by fetching byte ranges
+  of it over several concurrent HTTP connections.
+
+  The number of connections is set by PcdHttpBootRangeConnections. The file size
+  must already be known in Private->BootFileSize.
+
+  @param[in]       Private         The pointer to the driver's private data.
+  @param[in, out]  BufferSize      On input the size of Buffer in bytes. On output with a return
+                                   code of EFI_SUCCESS, the amount of data transferred to Buffer.
+  @param[out]      Buffer          The memory buffer to transfer the file to.
+  @param[out]      ImageType       The image type of the downloaded file.
+
+  @retval EFI_SUCCESS              The file was loaded.
+  @retval EFI_UNSUPPORTED          The ranged download is disabled, not worthwhile for this file,
+                                   or the server does not serve byte ranges. The caller should
+                                   use HttpBootGetBootFile() instead.
+  @retval EFI_BUFFER_TOO_SMALL     The BufferSize is too small to hold the file.
+  @retval EFI_OUT_OF_RESOURCES     Could not allocate needed resources.
+  @retval EFI_ABORTED              The download was aborted by the HTTP boot callback.
+  @retval Others                   A range still failed after PcdMaxHttpResumeRetries attempts.
+
+**/
+EFI_STATUS
+HttpBootGetBootFileByRanges (
+  IN     HTTP_BOOT_PRIVATE_DATA  *Private,
+  IN OUT UINTN                   *BufferSize,
+  OUT UINT8                      *Buffer,
+  OUT HTTP_BOOT_IMAGE_TYPE       *ImageType
+  )
+{
+  EFI_STATUS                  Status;
+  HTTP_BOOT_RANGE_CONNECTION  *ConnectionArray;
+  HTTP_BOOT_RANGE_CONNECTION  *Connection;
+  UINTN                       Connections;
+  UINTN                       Index;
+  UINTN                       UrlSize;
+  CHAR16                      *Url;
+  UINTN                       NextOffset;
+  UINTN                       ReceivedSize;
+
+  ASSERT (Private != NULL);
+
+  if ((BufferSize == NULL) || (ImageType == NULL)) {
+    return EFI_INVALID_PARAMETER;
+  }
+
+  //
+  // Ranges of an encoded file can't be decoded independently.
+  //
+  Connections = MIN (PcdGet32 (PcdHttpBootRangeConnections), HTTP_BOOT_RANGE_MAX_CONNECTIONS);
+  if ((Connections < 2) || (Buffer == NULL) || Private->ContentEncoded ||
+      (Private->BootFileSize < 2 * HTTP_BOOT_RANGE_MIN_SIZE))
+  {
+    return EFI_UNSUPPORTED;
+  }
+
+  if (*BufferSize < Private->BootFileSize) {
+    *BufferSize = Private->BootFileSize;
+    return EFI_BUFFER_TOO_SMALL;
+  }
+
+  UrlSize = AsciiStrSize (Private->BootFileUri);
+  Url     = AllocatePool (UrlSize * sizeof (CHAR16));
+  if (Url == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  AsciiStrToUnicodeStrS (Private->BootFileUri, Url, UrlSize);
+  Status = HttpBootGetFileFromCache (Private, Url, BufferSize, Buffer, ImageType);
+  if (Status != EFI_NOT_FOUND) {
+    FreePool (Url);
+    return Status;
+  }
+
+  ConnectionArray = AllocateZeroPool (Connections * sizeof (HTTP_BOOT_RANGE_CONNECTION));
+  if (ConnectionArray == NULL) {
+    FreePool (Url);
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  for (Index = 0; Index < Connections; Index++) {
+    Connection                     = &ConnectionArray[Index];
+    Connection->RequestData.Method = HttpMethodGet;
+    Connection->RequestData.Url    = Url;
+    Connection->RangeSize          = HTTP_BOOT_RANGE_MIN_SIZE;
+    Connection->State              = HttpBootRangeIdle;
+
+    Status = HttpBootBuildRangeHeader (Private, FALSE, &Connection->HttpIoHeader);
+    if (EFI_ERROR (Status)) {
+      goto ON_EXIT;
+    }
+
+    Status = HttpBootInitHttpIo (Private, &Connection->HttpIo);
+    if (EFI_ERROR (Status)) {
+      goto ON_EXIT;
+    }
+
+    Connection->HttpCreated = TRUE;
+  }
+
+  DEBUG ((
+    DEBUG_INFO,
+    "HttpBootGetBootFileByRanges: Downloading %lu bytes over %d connections.\n",
+    (UINT64)Private->BootFileSize,
+    Connections
+    ));
+
+  //
+  // Let the callback know about the download, as HttpIoSendRequest() would.
+  //
+  ConnectionArray[0].HttpIo.ReqMessage.Data.Request = &ConnectionArray[0].RequestData;
+  ConnectionArray[0].HttpIo.ReqMessage.HeaderCount  = ConnectionArray[0].HttpIoHeader->HeaderCount;
+  ConnectionArray[0].HttpIo.ReqMessage.Headers      = ConnectionArray[0].HttpIoHeader->Headers;
+
+  Status = HttpBootHttpIoCallback (
+             HttpIoRequest,
+             &ConnectionArray[0].HttpIo.ReqMessage,
+             Private
+             );
+  if (EFI_ERROR (Status)) {
+    goto ON_EXIT;
+  }
+
+  NextOffset   = 0;
+  ReceivedSize = 0;
+  while (ReceivedSize < Private->BootFileSize) {
+    for (Index = 0; Index < Connections; Index++) {
+      Connection = &ConnectionArray[Index];
+      Status     = HttpBootProcessRangeConnection (
+                     Private,
+                     Connection,
+                     Connections,
+                     Buffer,
+                     &NextOffset,
+                     &ReceivedSize
+                     );
+      if (!EFI_ERROR (Status)) {
+        continue;
+      }
+
+      //
+      // Only network failures are worth retrying. The part of the range
+      // received so far is kept, and the retry asks for the rest of it.
+      //
+      Connection->Retries++;
+      if (((Status != EFI_TIMEOUT) && (Status != EFI_DEVICE_ERROR) &&
+           (Status != EFI_CONNECTION_FIN) && (Status != EFI_CONNECTION_RESET)) ||
+          (Connection->Retries >= PcdGet32 (PcdMaxHttpResumeRetries)))
+      {
+        DEBUG ((
+          DEBUG_ERROR,
+          "HttpBootGetBootFileByRanges: Range %lu-%lu failed after %d attempts - %r\n",
+          (UINT64)Connection->Offset,
+          (UINT64)(Connection->End - 1),
+          Connection->Retries,
+          Status
+          ));
+        goto ON_EXIT;
+      }
+
+      DEBUG ((
+        DEBUG_WARN | DEBUG_INFO,
+        "HttpBootGetBootFileByRanges: Range %lu-%lu interrupted - %r, will retry.\n",
+        (UINT64)Connection->Offset,
+        (UINT64)(Connection->End - 1),
+        Status
+        ));
+
+      Connection->RangeSize = MAX (Connection->RangeSize / 2, HTTP_BOOT_RANGE_MIN_SIZE);
+      HttpBootCloseRangeConnection (Connection);
+      Status = HttpBootInitHttpIo (Private, &Connection->HttpIo);
+      if (EFI_ERROR (Status)) {
+        goto ON_EXIT;
+      }
+
+      Connection->HttpCreated = TRUE;
+    }
+
+    for (Index = 0; Index < Connections; Index++) {
+      Connection = &ConnectionArray[Index];
+      if (Connection->State != HttpBootRangeIdle) {
+        Connection->HttpIo.Http->Poll (Connection->HttpIo.Http);
+      }
+    }
+  }
+
+  *BufferSize = Private->BootFileSize;
+  *ImageType  = Private->ImageType;
+  Status      = EFI_SUCCESS;
+
+ON_EXIT:
+  for (Index = 0; Index < Connections; Index++) {
+    HttpBootCloseRangeConnection (&ConnectionArray[Index]);
+    if (ConnectionArray[Index].HttpIoHeader != NULL) {
+      HttpIoFreeHeader (ConnectionArray[Index].HttpIoHeader);
+    }
+  }
+
+  FreePool (ConnectionArray);
+  FreePool (Url);
+  return Status;
+}
+
+/**
+  Get the decoded size of a gzip encoded boot file.
+
+  The size is read from the ISIZE field in the last 4 bytes of the gzip
+  member, using a suffix range request on the existing HTTP connection.
+
+  @param[in]    Private        The pointer to the driver's private data.
+  @param[out]   DecodedSize    Return the size of the decoded boot file.
+
+  @retval EFI_SUCCESS          The decoded size was returned.
+  @retval EFI_UNSUPPORTED      The server doesn't return the encoded suffix.
+  @retval Others               Failed to get the decoded size. The caller should
+                               re-create the HTTP IO before using it again.
+
+**/
+EFI_STATUS
+HttpBootGetDecodedSize (
+  IN     HTTP_BOOT_PRIVATE_DATA  *Private,
+  OUT    UINTN                   *DecodedSize
+  )
+{
+  EFI_STATUS             Status;
+  HTTP_IO_HEADER         *HttpIoHeader;
+  EFI_HTTP_REQUEST_DATA  RequestData;
+  HTTP_IO_RESPONSE_DATA  ResponseData;
+  HTTP_IO_RESPONSE_DATA  ResponseBody;
+  EFI_HTTP_HEADER        *HttpHeader;
+  UINTN                  UrlSize;
+  CHAR16                 *Url;
+  UINT8                  Trailer[4];
+  UINTN                  ReceivedSize;
+
+  ASSERT (Private != NULL);
+  ASSERT (Private->HttpCreated);
+
+  UrlSize = AsciiStrSize (Private->BootFileUri);
+  Url     = AllocatePool (UrlSize * sizeof (CHAR16));
+  if (Url == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  AsciiStrToUnicodeStrS (Private->BootFileUri, Url, UrlSize);
+
+  Status = HttpBootBuildRangeHeader (Private, TRUE, &HttpIoHeader);
+  if (EFI_ERROR (Status)) {
+    FreePool (Url);
+    return Status;
+  }
+
+  Status = HttpIoSetHeader (HttpIoHeader, "Range", "bytes=-4");
+  if (EFI_ERROR (Status)) {
+    goto ON_EXIT;
+  }
+
+  RequestData.Method = HttpMethodGet;
+  RequestData.Url    = Url;
+  Status             = HttpIoSendRequest (
+                         &Private->HttpIo,
+                         &RequestData,
+                         HttpIoHeader->HeaderCount,
+                         HttpIoHeader->Headers,
+                         0,
+                         NULL
+                         );
+  if (EFI_ERROR (Status)) {
+    goto ON_EXIT;
+  }
+
+  ZeroMem (&ResponseData, sizeof (HTTP_IO_RESPONSE_DATA));
+  Status = HttpIoRecvResponse (&Private->HttpIo, TRUE, &ResponseData);
+  if (EFI_ERROR (Status) || EFI_ERROR (ResponseData.Status)) {
+    if (!EFI_ERROR (Status)) {
+      Status = ResponseData.Status;
+    }
+
+    goto ON_ERROR;
+  }
+
+  //
+  // Only a 206 Partial Content response of the same encoded representation
+  // carries the gzip trailer.
+  //
+  HttpHeader = HttpFindHeader (ResponseData.HeaderCount, ResponseData.Headers, HTTP_HEADER_CONTENT_ENCODING);
+  if ((ResponseData.Response.StatusCode != HTTP_STATUS_206_PARTIAL_CONTENT) ||
+      (HttpHeader == NULL) ||
+      ((AsciiStriCmp (HttpHeader->FieldValue, HTTP_CONTENT_ENCODING_GZIP) != 0) &&
+       (AsciiStriCmp (HttpHeader->FieldValue, "x-gzip") != 0)))
+  {
+    Status = EFI_UNSUPPORTED;
+    goto ON_ERROR;
+  }
+
+  ReceivedSize = 0;
+  while (ReceivedSize < sizeof (Trailer)) {
+    ZeroMem (&ResponseBody, sizeof (HTTP_IO_RESPONSE_DATA));
+    ResponseBody.Body       = (CHAR8 *)Trailer + ReceivedSize;
+    ResponseBody.BodyLength = sizeof (Trailer) - ReceivedSize;
+    Status                  = HttpIoRecvResponse (&Private->HttpIo, FALSE, &ResponseBody);
+    if (EFI_ERROR (Status) || EFI_ERROR (ResponseBody.Status)) {
+      if (!EFI_ERROR (Status)) {
+        Status = ResponseBody.Status;
+      }
+
+      goto ON_ERROR;
+    }
+
+    ReceivedSize += ResponseBody.BodyLength;
+  }
+
+  //
+  // ISIZE is the size of the decoded data modulo 2^32, in little endian.
+  //
+  *DecodedSize = (UINTN)Trailer[0] | ((UINTN)Trailer[1] << 8) |
+                 ((UINTN)Trailer[2] << 16) | ((UINTN)Trailer[3] << 24);
+  if (*DecodedSize == 0) {
+    Status = EFI_UNSUPPORTED;
+  }
+
+ON_ERROR:
+  if (ResponseData.Headers != NULL) {
+    HttpFreeHeaderFields (ResponseData.Headers, ResponseData.HeaderCount);
+  }
+
+ON_EXIT:
+  HttpIoFreeHeader (HttpIoHeader);
+  FreePool (Url);
+  return Status;
+}
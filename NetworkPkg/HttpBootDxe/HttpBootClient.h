@@ -14,6 +14,15 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 #define HTTP_USER_AGENT_EFI_HTTP_BOOT          "UefiHttpBoot/1.0"
 #define HTTP_BOOT_AUTHENTICATION_INFO_MAX_LEN  255
 
+//
+// Limits of the ranged download over several HTTP connections. Each connection
+// starts with the minimum range size, doubles it after every range that completes
+// and halves it after every failure.
+//
+#define HTTP_BOOT_RANGE_MAX_CONNECTIONS  8
+#define HTTP_BOOT_RANGE_MIN_SIZE         SIZE_1MB
+#define HTTP_BOOT_RANGE_MAX_SIZE         SIZE_16MB
+
 //
 // Record the data length and start address of a data block.
 //
@@ -55,9 +64,40 @@ typedef struct {
   UINTN                      BufferSize;
   UINT8                      *Buffer;
 
+  //
+  // Decoder of a gzip encoded message-body, which is decoded to Buffer.
+  //
+  HTTP_BOOT_INFLATE          *Inflate;
+
   HTTP_BOOT_PRIVATE_DATA     *Private;
 } HTTP_BOOT_CALLBACK_DATA;
 
+//
+// State of a connection used by the ranged download.
+//
+typedef enum {
+  HttpBootRangeIdle,
+  HttpBootRangeSendRequest,
+  HttpBootRangeRecvHeader,
+  HttpBootRangeRecvBody
+} HTTP_BOOT_RANGE_STATE;
+
+//
+// A HTTP connection which downloads one range of the boot file at a time.
+//
+typedef struct {
+  HTTP_IO                   HttpIo;
+  BOOLEAN                   HttpCreated;
+  HTTP_IO_HEADER            *HttpIoHeader;
+  EFI_HTTP_REQUEST_DATA     RequestData;
+  EFI_HTTP_RESPONSE_DATA    ResponseData;
+  HTTP_BOOT_RANGE_STATE     State;
+  UINTN                     Offset;       // Next byte of the range to receive.
+  UINTN                     End;          // One past the last byte of the range.
+  UINTN                     RangeSize;    // Size of the next range to request.
+  UINT32                    Retries;      // Failed attempts of the current range.
+} HTTP_BOOT_RANGE_CONNECTION;
+
 /**
   Discover all the boot information for boot file.
 
@@ -86,6 +126,58 @@ HttpBootCreateHttpIo (
   IN     HTTP_BOOT_PRIVATE_DATA  *Private
   );
 
+/**
+  Get the decoded size of a gzip encoded boot file from the ISIZE field of the
+  gzip trailer, by requesting the last 4 bytes of the encoded file.
+
+  If this function fails, the response may not have been fully received, so the
+  caller should re-create the HttpIo before sending another request.
+
+  @param[in]    Private        The pointer to the driver's private data.
+  @param[out]   DecodedSize    Return the decoded size of the boot file.
+
+  @retval EFI_SUCCESS          The decoded size was read.
+  @retval EFI_UNSUPPORTED      The server did not return the end of the gzip encoded file.
+  @retval Others               Failed to send the request or to receive the response.
+
+**/
+EFI_STATUS
+HttpBootGetDecodedSize (
+  IN     HTTP_BOOT_PRIVATE_DATA  *Private,
+  OUT    UINTN                   *DecodedSize
+  );
+
+/**
+  Download the boot file into a caller provided buffer by fetching byte ranges
+  of it over several concurrent HTTP connections.
+
+  The number of connections is set by PcdHttpBootRangeConnections. The file size
+  must already be known in Private->BootFileSize.
+
+  @param[in]       Private         The pointer to the driver's private data.
+  @param[in, out]  BufferSize      On input the size of Buffer in bytes. On output with a return
+                                   code of EFI_SUCCESS, the amount of data transferred to Buffer.
+  @param[out]      Buffer          The memory buffer to transfer the file to.
+  @param[out]      ImageType       The image type of the downloaded file.
+
+  @retval EFI_SUCCESS              The file was loaded.
+  @retval EFI_UNSUPPORTED          The ranged download is disabled, not worthwhile for this file,
+                                   or the server does not serve byte ranges. The caller should
+                                   use HttpBootGetBootFile() instead.
+  @retval EFI_BUFFER_TOO_SMALL     The BufferSize is too small to hold the file.
+  @retval EFI_OUT_OF_RESOURCES     Could not allocate needed resources.
+  @retval EFI_ABORTED              The download was aborted by the HTTP boot callback.
+  @retval Others                   A range still failed after PcdMaxHttpResumeRetries attempts.
+
+**/
+EFI_STATUS
+HttpBootGetBootFileByRanges (
+  IN     HTTP_BOOT_PRIVATE_DATA  *Private,
+  IN OUT UINTN                   *BufferSize,
+  OUT UINT8                      *Buffer,
+  OUT HTTP_BOOT_IMAGE_TYPE       *ImageType
+  );
+
 /**
   This function download the boot file by using UEFI HTTP protocol.
 
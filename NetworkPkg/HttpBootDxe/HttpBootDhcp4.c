@@ -26,6 +26,12 @@ UINT8  mInterestedDhcp4Tags[HTTP_BOOT_DHCP4_TAG_INDEX_MAX] = {
 //
 UINT32  mHttpDhcpTimeout[4] = { 4, 8, 16, 32 };
 
+//
+// Only one short try to request the cached lease in INIT-REBOOT state, the full
+// D.O.R.A process is started if it isn't acknowledged in time.
+//
+UINT32  mHttpDhcpRebootTimeout[1] = { 2 };
+
 /**
   Build the options buffer for the DHCPv4 request packet.
 
@@ -158,6 +164,16 @@ HttpBootBuildDhcp4Options (
 
   Index++;
 
+  //
+  // Append rapid commit option, which has no data.
+  //
+  if (PcdGetBool (PcdHttpBootDhcp4RapidCommit)) {
+    OptList[Index]         = GET_NEXT_DHCP_OPTION (OptList[Index - 1]);
+    OptList[Index]->OpCode = DHCP4_TAG_RAPID_COMMIT;
+    OptList[Index]->Length = 0;
+    Index++;
+  }
+
   return Index;
 }
 
@@ -591,6 +607,22 @@ HttpBootDhcp4CallBack (
   EFI_STATUS               Status;
   BOOLEAN                  Received;
 
+  Private = (HTTP_BOOT_PRIVATE_DATA *)Context;
+
+  if ((Dhcp4Event == Dhcp4RcvdNak) && (CurrentState == Dhcp4Rebooting)) {
+    //
+    // The cached lease is refused, the DHCPv4 driver goes on with a DISCOVER.
+    // Abort it there, the REQUEST of that D.O.R.A process would be sent with
+    // the retries of the INIT-REBOOT state instead of the default ones.
+    //
+    Private->Dhcp4RebootFailed = TRUE;
+    return EFI_SUCCESS;
+  }
+
+  if ((Dhcp4Event == Dhcp4SendDiscover) && Private->Dhcp4RebootFailed) {
+    return EFI_ABORTED;
+  }
+
   if ((Dhcp4Event != Dhcp4SendDiscover) &&
       (Dhcp4Event != Dhcp4RcvdOffer) &&
       (Dhcp4Event != Dhcp4SendRequest) &&
@@ -600,8 +632,6 @@ HttpBootDhcp4CallBack (
     return EFI_SUCCESS;
   }
 
-  Private = (HTTP_BOOT_PRIVATE_DATA *)Context;
-
   //
   // Override the Maximum DHCP Message Size.
   //
@@ -669,10 +699,41 @@ HttpBootDhcp4CallBack (
 
       break;
 
+    case Dhcp4RcvdAck:
+      if ((CurrentState != Dhcp4Selecting) && (CurrentState != Dhcp4Rebooting)) {
+        break;
+      }
+
+      //
+      // The ACK answers a DISCOVER with rapid commit, or the REQUEST for the cached
+      // lease in INIT-REBOOT state. No offer has been selected, so cache the ACK as
+      // an offer and accept it only if it would be selected. Otherwise wait for more
+      // offers, or end the INIT-REBOOT so that the full D.O.R.A process is started.
+      //
+      Status = (CurrentState == Dhcp4Selecting) ? EFI_NOT_READY : EFI_ABORTED;
+      if ((Packet->Length > HTTP_BOOT_DHCP4_PACKET_MAX_SIZE) ||
+          (Private->OfferNum >= HTTP_BOOT_OFFER_MAX_NUM) ||
+          EFI_ERROR (HttpBootCacheDhcp4Offer (Private, Packet)))
+      {
+        break;
+      }
+
+      HttpBootSelectDhcpOffer (Private);
+
+      if (Private->SelectIndex == Private->OfferNum) {
+        Status = EFI_SUCCESS;
+      }
+
+      break;
+
     default:
       break;
   }
 
+  if ((CurrentState == Dhcp4Rebooting) && (Status == EFI_ABORTED)) {
+    Private->Dhcp4RebootFailed = TRUE;
+  }
+
   return Status;
 }
 
@@ -796,6 +857,142 @@ HttpBootSetIp4Policy (
   return EFI_SUCCESS;
 }
 
+/**
+  Convert an EFI_TIME to the number of seconds since a fixed point in the past,
+  the time zone and daylight saving are ignored.
+
+  @param[in]  Time                Pointer to the time to convert.
+
+  @return     The number of seconds.
+
+**/
+STATIC
+UINT64
+HttpBootTimeToSeconds (
+  IN EFI_TIME  *Time
+  )
+{
+  UINT64  Year;
+  UINT64  Month;
+  UINT64  Days;
+
+  //
+  // Count the years from March, so that the leap day is the last day of a year.
+  //
+  Year  = Time->Year;
+  Month = Time->Month;
+  if (Month <= 2) {
+    Year--;
+    Month += 12;
+  }
+
+  Days = 365 * Year + Year / 4 - Year / 100 + Year / 400 + (153 * (Month - 3) + 2) / 5 + Time->Day;
+
+  return ((Days * 24 + Time->Hour) * 60 + Time->Minute) * 60 + Time->Second;
+}
+
+/**
+  Get the DHCPv4 lease cached for the NIC, if it is still in the first half of
+  its lifetime.
+
+  @param[in]   Private          Pointer to HTTP boot driver private data.
+  @param[out]  ClientAddress    Return the IPv4 address of the lease.
+
+  @retval EFI_SUCCESS           The lease can be requested again.
+  @retval EFI_NOT_FOUND         There is no valid lease cached.
+  @retval Others                Failed to read the lease.
+
+**/
+EFI_STATUS
+HttpBootGetDhcp4Lease (
+  IN  HTTP_BOOT_PRIVATE_DATA  *Private,
+  OUT EFI_IPv4_ADDRESS        *ClientAddress
+  )
+{
+  EFI_STATUS             Status;
+  CHAR16                 *MacString;
+  HTTP_BOOT_DHCP4_LEASE  Lease;
+  UINTN                  DataSize;
+  EFI_TIME               Now;
+  UINT64                 Acquired;
+  UINT64                 Current;
+
+  Status = NetLibGetMacString (Private->Controller, NULL, &MacString);
+  if (EFI_ERROR (Status)) {
+    return Status;
+  }
+
+  DataSize = sizeof (Lease);
+  Status   = gRT->GetVariable (MacString, &gHttpBootConfigGuid, NULL, &DataSize, &Lease);
+  FreePool (MacString);
+  if (EFI_ERROR (Status) || (DataSize != sizeof (Lease)) ||
+      EFI_IP4_EQUAL (&Lease.ClientAddress, &mZeroIp4Addr))
+  {
+    return EFI_NOT_FOUND;
+  }
+
+  if (Lease.LeaseTime != MAX_UINT32) {
+    Status = gRT->GetTime (&Now, NULL);
+    if (EFI_ERROR (Status)) {
+      return Status;
+    }
+
+    Acquired = HttpBootTimeToSeconds (&Lease.AcquiredTime);
+    Current  = HttpBootTimeToSeconds (&Now);
+    if ((Current < Acquired) || (Current - Acquired >= Lease.LeaseTime / 2)) {
+      return EFI_NOT_FOUND;
+    }
+  }
+
+  CopyMem (ClientAddress, &Lease.ClientAddress, sizeof (EFI_IPv4_ADDRESS));
+  return EFI_SUCCESS;
+}
+
+/**
+  Cache the DHCPv4 lease for the NIC in a non-volatile variable, or delete the
+  cached one.
+
+  @param[in]  Private             Pointer to HTTP boot driver private data.
+  @param[in]  Mode                The DHCPv4 mode data of the lease, or NULL to delete
+                                  the cached lease.
+
+**/
+VOID
+HttpBootSetDhcp4Lease (
+  IN HTTP_BOOT_PRIVATE_DATA  *Private,
+  IN EFI_DHCP4_MODE_DATA     *Mode    OPTIONAL
+  )
+{
+  EFI_STATUS             Status;
+  CHAR16                 *MacString;
+  HTTP_BOOT_DHCP4_LEASE  Lease;
+
+  Status = NetLibGetMacString (Private->Controller, NULL, &MacString);
+  if (EFI_ERROR (Status)) {
+    return;
+  }
+
+  if (Mode == NULL) {
+    gRT->SetVariable (MacString, &gHttpBootConfigGuid, 0, 0, NULL);
+  } else if (!EFI_ERROR (gRT->GetTime (&Lease.AcquiredTime, NULL))) {
+    CopyMem (&Lease.ClientAddress, &Mode->ClientAddress, sizeof (EFI_IPv4_ADDRESS));
+    Lease.LeaseTime = Mode->LeaseTime;
+
+    Status = gRT->SetVariable (
+                    MacString,
+                    &gHttpBootConfigGuid,
+                    EFI_VARIABLE_NON_VOLATILE | EFI_VARIABLE_BOOTSERVICE_ACCESS,
+                    sizeof (Lease),
+                    &Lease
+                    );
+    if (EFI_ERROR (Status)) {
+      DEBUG ((DEBUG_WARN, "HttpBoot: Failed to cache the DHCPv4 lease - %r\n", Status));
+    }
+  }
+
+  FreePool (MacString);
+}
+
 /**
   Start the D.O.R.A DHCPv4 process to acquire the IPv4 address and other Http boot information.
 
@@ -840,6 +1037,16 @@ HttpBootDhcp4Dora (
   Config.DiscoverTryCount = HTTP_BOOT_DHCP_RETRIES;
   Config.DiscoverTimeout  = mHttpDhcpTimeout;
 
+  //
+  // Request the lease of the previous boot again from INIT-REBOOT state if it's cached.
+  //
+  if (PcdGetBool (PcdHttpBootDhcp4LeaseReuse) &&
+      !EFI_ERROR (HttpBootGetDhcp4Lease (Private, &Config.ClientAddress)))
+  {
+    Config.RequestTryCount = ARRAY_SIZE (mHttpDhcpRebootTimeout);
+    Config.RequestTimeout  = mHttpDhcpRebootTimeout;
+  }
+
   //
   // Configure the DHCPv4 instance for HTTP boot.
   //
@@ -855,10 +1062,39 @@ HttpBootDhcp4Dora (
   ZeroMem (Private->OfferCount, sizeof (Private->OfferCount));
   ZeroMem (Private->OfferIndex, sizeof (Private->OfferIndex));
 
+  Private->Dhcp4RebootFailed = FALSE;
+
   //
   // Start DHCPv4 D.O.R.A. process to acquire IPv4 address.
   //
   Status = Dhcp4->Start (Dhcp4, NULL);
+  if (EFI_ERROR (Status) && !EFI_IP4_EQUAL (&Config.ClientAddress, &mZeroIp4Addr) &&
+      ((Status != EFI_ABORTED) || Private->Dhcp4RebootFailed))
+  {
+    //
+    // The cached lease isn't acknowledged, forget it and start over from INIT state
+    // with the default REQUEST retries. EFI_ABORTED from the user callback of HTTP
+    // boot ends the boot attempt as it does without a cached lease.
+    //
+    HttpBootSetDhcp4Lease (Private, NULL);
+    Dhcp4->Stop (Dhcp4);
+
+    ZeroMem (&Config.ClientAddress, sizeof (EFI_IPv4_ADDRESS));
+    Config.RequestTryCount = 0;
+    Config.RequestTimeout  = NULL;
+    Status                 = Dhcp4->Configure (Dhcp4, &Config);
+    if (EFI_ERROR (Status)) {
+      goto ON_EXIT;
+    }
+
+    Private->OfferNum = 0;
+    ZeroMem (Private->OfferCount, sizeof (Private->OfferCount));
+    ZeroMem (Private->OfferIndex, sizeof (Private->OfferIndex));
+    Private->Dhcp4RebootFailed = FALSE;
+
+    Status = Dhcp4->Start (Dhcp4, NULL);
+  }
+
   if (EFI_ERROR (Status)) {
     goto ON_EXIT;
   }
@@ -872,6 +1108,10 @@ HttpBootDhcp4Dora (
   }
 
   ASSERT (Mode.State == Dhcp4Bound);
+  if (PcdGetBool (PcdHttpBootDhcp4LeaseReuse)) {
+    HttpBootSetDhcp4Lease (Private, &Mode);
+  }
+
   CopyMem (&Private->StationIp, &Mode.ClientAddress, sizeof (EFI_IPv4_ADDRESS));
   CopyMem (&Private->SubnetMask, &Mode.SubnetMask, sizeof (EFI_IPv4_ADDRESS));
   CopyMem (&Private->GatewayIp, &Mode.RouterAddress, sizeof (EFI_IPv4_ADDRESS));
@@ -209,6 +209,16 @@ typedef struct {
   EFI_DHCP4_PACKET_OPTION    *OptList[HTTP_BOOT_DHCP4_TAG_INDEX_MAX];
 } HTTP_BOOT_DHCP4_PACKET_CACHE;
 
+///
+/// The DHCPv4 lease kept in a non-volatile variable named by the MAC address
+/// of the NIC, to be requested again from INIT-REBOOT state on the next boot.
+///
+typedef struct {
+  EFI_IPv4_ADDRESS    ClientAddress;
+  UINT32              LeaseTime;     /// In seconds, MAX_UINT32 means infinite
+  EFI_TIME            AcquiredTime;
+} HTTP_BOOT_DHCP4_LEASE;
+
 /**
   Select an DHCPv4 or DHCP6 offer, and record SelectIndex and SelectProxyType.
 
@@ -220,6 +230,39 @@ HttpBootSelectDhcpOffer (
   IN HTTP_BOOT_PRIVATE_DATA  *Private
   );
 
+/**
+  Get the DHCPv4 lease cached for the NIC, if it is still in the first half of
+  its lifetime.
+
+  @param[in]   Private          Pointer to HTTP boot driver private data.
+  @param[out]  ClientAddress    Return the IPv4 address of the lease.
+
+  @retval EFI_SUCCESS           The lease can be requested again.
+  @retval EFI_NOT_FOUND         There is no valid lease cached.
+  @retval Others                Failed to read the lease.
+
+**/
+EFI_STATUS
+HttpBootGetDhcp4Lease (
+  IN  HTTP_BOOT_PRIVATE_DATA  *Private,
+  OUT EFI_IPv4_ADDRESS        *ClientAddress
+  );
+
+/**
+  Cache the DHCPv4 lease for the NIC in a non-volatile variable, or delete the
+  cached one.
+
+  @param[in]  Private             Pointer to HTTP boot driver private data.
+  @param[in]  Mode                The DHCPv4 mode data of the lease, or NULL to delete
+                                  the cached lease.
+
+**/
+VOID
+HttpBootSetDhcp4Lease (
+  IN HTTP_BOOT_PRIVATE_DATA  *Private,
+  IN EFI_DHCP4_MODE_DATA     *Mode    OPTIONAL
+  );
+
 /**
   Start the D.O.R.A DHCPv4 process to acquire the IPv4 address and other Http boot information.
 
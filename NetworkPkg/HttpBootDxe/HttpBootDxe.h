@@ -107,6 +107,7 @@ typedef enum  {
 #include "HttpBootDhcp6.h"
 #include "HttpBootImpl.h"
 #include "HttpBootSupport.h"
+#include "HttpBootInflate.h"
 #include "HttpBootClient.h"
 #include "HttpBootConfig.h"
 
@@ -216,6 +217,8 @@ struct _HTTP_BOOT_PRIVATE_DATA {
   UINTN                                        BootFileSize;
   UINTN                                        PartialTransferredSize;
   CHAR8                                        *LastModifiedOrEtag;
+  BOOLEAN                                      ContentEncoded;
+  BOOLEAN                                      ContentEncodingDisabled;
   BOOLEAN                                      NoGateway;
   HTTP_BOOT_IMAGE_TYPE                         ImageType;
 
@@ -265,6 +268,12 @@ struct _HTTP_BOOT_PRIVATE_DATA {
   UINT32                         OfferNum;
   UINT32                         OfferCount[HttpOfferTypeMax];
   UINT32                         OfferIndex[HttpOfferTypeMax][HTTP_BOOT_OFFER_MAX_NUM];
+
+  //
+  // Set when the cached DHCPv4 lease is refused in INIT-REBOOT state and the
+  // DHCP process is ended by HttpBootDhcp4CallBack() to start it over.
+  //
+  BOOLEAN                        Dhcp4RebootFailed;
 };
 
 #define HTTP_BOOT_PRIVATE_DATA_SIGNATURE  SIGNATURE_32 ('H', 'B', 'P', 'D')
@@ -313,6 +313,7 @@ HttpBootGetBootFileCaller (
   HTTP_GET_BOOT_FILE_STATE  State;
   EFI_STATUS                Status;
   UINT32                    Retries;
+  UINTN                     DecodedSize;
 
   if (Private->BootFileSize == 0) {
     State = GetBootFileHead;
@@ -342,6 +343,31 @@ HttpBootGetBootFileCaller (
           } else {
             State = GetBootFileGet;
           }
+        } else if (Private->ContentEncoded) {
+          //
+          // The server will send the file gzip encoded, the buffer must hold the decoded file.
+          //
+          Status = HttpBootGetDecodedSize (Private, &DecodedSize);
+          if (!EFI_ERROR (Status)) {
+            Private->BootFileSize = DecodedSize;
+            State                 = LoadBootFile;
+          } else {
+            //
+            // Give up the encoding and get the size of the file as it is.
+            //
+            DEBUG ((DEBUG_WARN | DEBUG_INFO, "HttpBootGetBootFileCaller: Failed to get the decoded size - %r, disable content encoding.\n", Status));
+            Private->ContentEncodingDisabled = TRUE;
+            Private->ContentEncoded          = FALSE;
+            Private->BootFileSize            = 0;
+            Private->HttpCreated             = FALSE;
+            HttpIoDestroyIo (&Private->HttpIo);
+            Status = HttpBootCreateHttpIo (Private);
+            if (EFI_ERROR (Status)) {
+              return Status;
+            }
+
+            State = GetBootFileHead;
+          }
         } else {
           State = LoadBootFile;
         }
@@ -376,6 +402,31 @@ HttpBootGetBootFileCaller (
           return Status;
         }
 
+        //
+        // Try to load a large boot file over several connections in parallel first,
+        // unless a previous single connection download is being resumed.
+        //
+        if (Private->PartialTransferredSize == 0) {
+          Status = HttpBootGetBootFileByRanges (Private, BufferSize, Buffer, ImageType);
+          if (!EFI_ERROR (Status)) {
+            return Status;
+          }
+
+          //
+          // Only a network failure is worth another try over a single connection. An abort
+          // from the HTTP boot callback, or any other error, ends the download.
+          //
+          if ((Status != EFI_UNSUPPORTED) && (Status != EFI_TIMEOUT) && (Status != EFI_DEVICE_ERROR) &&
+              (Status != EFI_CONNECTION_FIN) && (Status != EFI_CONNECTION_RESET))
+          {
+            return Status;
+          }
+
+          if (Status != EFI_UNSUPPORTED) {
+            DEBUG ((DEBUG_WARN | DEBUG_INFO, "HttpBootGetBootFileCaller: Ranged download failed - %r, fall back to a single connection.\n", Status));
+          }
+        }
+
         //
         // Load the boot file into Buffer
         //
@@ -559,13 +610,15 @@ HttpBootStop (
   ZeroMem (&Private->StationIp, sizeof (EFI_IP_ADDRESS));
   ZeroMem (&Private->SubnetMask, sizeof (EFI_IP_ADDRESS));
   ZeroMem (&Private->GatewayIp, sizeof (EFI_IP_ADDRESS));
-  Private->Port                   = 0;
-  Private->BootFileUri            = NULL;
-  Private->BootFileUriParser      = NULL;
-  Private->BootFileSize           = 0;
-  Private->SelectIndex            = 0;
-  Private->SelectProxyType        = HttpOfferTypeMax;
-  Private->PartialTransferredSize = 0;
+  Private->Port                    = 0;
+  Private->BootFileUri             = NULL;
+  Private->BootFileUriParser       = NULL;
+  Private->BootFileSize            = 0;
+  Private->ContentEncoded          = FALSE;
+  Private->ContentEncodingDisabled = FALSE;
+  Private->SelectIndex             = 0;
+  Private->SelectProxyType         = HttpOfferTypeMax;
+  Private->PartialTransferredSize  = 0;
 
   if (!Private->UsingIpv6) {
     //
@@ -0,0 +1,921 @@
+/** @file
+  Streaming decoder of the gzip (RFC1952) and DEFLATE (RFC1951) formats, used to
+  decode a boot file sent with "Content-Encoding: gzip" while it is received.
+
+  Copyright (c) 2026, agent. All rights reserved.<BR>
+
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#include <Uefi.h>
+#include <Library/BaseLib.h>
+#include <Library/BaseMemoryLib.h>
+
+#include "HttpBootInflate.h"
+
+#define GZIP_ID1       0x1F
+#define GZIP_ID2       0x8B
+#define GZIP_CM_DEFLATE  8
+
+#define GZIP_FLG_FHCRC     BIT1
+#define GZIP_FLG_FEXTRA    BIT2
+#define GZIP_FLG_FNAME     BIT3
+#define GZIP_FLG_FCOMMENT  BIT4
+#define GZIP_FLG_RESERVED  (BIT5 | BIT6 | BIT7)
+
+#define INFLATE_SYMBOL_SHORT    (-1)
+#define INFLATE_SYMBOL_INVALID  (-2)
+
+//
+// Position in the encoded data to go back to when a unit of the stream
+// cannot be decoded until more data arrives.
+//
+typedef struct {
+  UINT32    BitBuffer;
+  UINTN     BitCount;
+  UINTN     CarryPos;
+  UINTN     InputPos;
+} INFLATE_CHECKPOINT;
+
+//
+// Base values and extra bits of the length symbols 257..285 and of the
+// distance symbols 0..29.
+//
+GLOBAL_REMOVE_IF_UNREFERENCED CONST UINT16  mInflateLengthBase[29] = {
+  3,  4,  5,  6,  7,  8,  9,  10, 11,  13,  15,  17,  19,  23, 27, 31,
+  35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258
+};
+
+GLOBAL_REMOVE_IF_UNREFERENCED CONST UINT8  mInflateLengthExtra[29] = {
+  0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+  3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0
+};
+
+GLOBAL_REMOVE_IF_UNREFERENCED CONST UINT16  mInflateDistBase[30] = {
+  1,    2,    3,    4,    5,    7,     9,     13,    17,  25,   33,   49,   65,   97,   129,
+  193,  257,  385,  513,  769,  1025,  1537,  2049,  3073, 4097, 6145, 8193, 12289, 16385, 24577
+};
+
+GLOBAL_REMOVE_IF_UNREFERENCED CONST UINT8  mInflateDistExtra[30] = {
+  0, 0, 0, 0, 1, 1, 2, 2,  3,  3,  4,  4,  5,  5,  6,
+  6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13
+};
+
+//
+// Order of the code length code lengths in a dynamic block header.
+//
+GLOBAL_REMOVE_IF_UNREFERENCED CONST UINT8  mInflateCodeLengthOrder[19] = {
+  16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15
+};
+
+/**
+  Record the current position in the encoded data.
+
+  @param[in]   Inflate       The decoder.
+  @param[out]  Checkpoint    Return the position.
+
+**/
+STATIC
+VOID
+InflateSave (
+  IN  HTTP_BOOT_INFLATE   *Inflate,
+  OUT INFLATE_CHECKPOINT  *Checkpoint
+  )
+{
+  Checkpoint->BitBuffer = Inflate->BitBuffer;
+  Checkpoint->BitCount  = Inflate->BitCount;
+  Checkpoint->CarryPos  = Inflate->CarryPos;
+  Checkpoint->InputPos  = Inflate->InputPos;
+}
+
+/**
+  Go back to a position recorded by InflateSave().
+
+  @param[in, out]  Inflate       The decoder.
+  @param[in]       Checkpoint    The position.
+
+**/
+STATIC
+VOID
+InflateRestore (
+  IN OUT HTTP_BOOT_INFLATE   *Inflate,
+  IN     INFLATE_CHECKPOINT  *Checkpoint
+  )
+{
+  Inflate->BitBuffer = Checkpoint->BitBuffer;
+  Inflate->BitCount  = Checkpoint->BitCount;
+  Inflate->CarryPos  = Checkpoint->CarryPos;
+  Inflate->InputPos  = Checkpoint->InputPos;
+}
+
+/**
+  Load encoded bytes into the bit buffer until it holds at least Count bits.
+
+  @param[in, out]  Inflate       The decoder.
+  @param[in]       Count         The number of bits needed, at most 16.
+
+  @retval TRUE     The bit buffer holds Count bits.
+  @retval FALSE    The encoded data ran out. The bit buffer holds what was left.
+
+**/
+STATIC
+BOOLEAN
+InflateNeedBits (
+  IN OUT HTTP_BOOT_INFLATE  *Inflate,
+  IN     UINTN              Count
+  )
+{
+  UINT8  Byte;
+
+  while (Inflate->BitCount < Count) {
+    if (Inflate->CarryPos < Inflate->CarryLength) {
+      Byte = Inflate->Carry[Inflate->CarryPos++];
+    } else if (Inflate->InputPos < Inflate->InputLength) {
+      Byte = Inflate->Input[Inflate->InputPos++];
+    } else {
+      return FALSE;
+    }
+
+    Inflate->BitBuffer |= (UINT32)Byte << Inflate->BitCount;
+    Inflate->BitCount  += 8;
+  }
+
+  return TRUE;
+}
+
+/**
+  Remove Count bits from the bit buffer.
+
+  @param[in, out]  Inflate       The decoder.
+  @param[in]       Count         The number of bits, at most 16 and at most
+                                 the number of bits in the bit buffer.
+
+  @return The bits removed.
+
+**/
+STATIC
+UINT32
+InflateDropBits (
+  IN OUT HTTP_BOOT_INFLATE  *Inflate,
+  IN     UINTN              Count
+  )
+{
+  UINT32  Value;
+
+  Value                = Inflate->BitBuffer & ((1U << Count) - 1);
+  Inflate->BitBuffer >>= Count;
+  Inflate->BitCount   -= Count;
+  return Value;
+}
+
+/**
+  Read Count bits of the encoded data.
+
+  @param[in, out]  Inflate       The decoder.
+  @param[in]       Count         The number of bits, at most 16.
+  @param[out]      Value         Return the bits.
+
+  @retval TRUE     The bits were read.
+  @retval FALSE    The encoded data ran out.
+
+**/
+STATIC
+BOOLEAN
+InflateGetBits (
+  IN OUT HTTP_BOOT_INFLATE  *Inflate,
+  IN     UINTN              Count,
+  OUT    UINT32             *Value
+  )
+{
+  if (!InflateNeedBits (Inflate, Count)) {
+    return FALSE;
+  }
+
+  *Value = InflateDropBits (Inflate, Count);
+  return TRUE;
+}
+
+/**
+  Build a canonical Huffman code from the code length of each symbol.
+
+  @param[out]  Huffman       The Huffman code.
+  @param[in]   Lengths       The code length of each symbol, 0 if the symbol is not used.
+  @param[in]   Count         The number of symbols.
+
+  @retval TRUE     The code was built. It may be incomplete, in which case
+                   decoding an unassigned code fails.
+  @retval FALSE    The code lengths are over-subscribed.
+
+**/
+STATIC
+BOOLEAN
+InflateBuildHuffman (
+  OUT HTTP_BOOT_HUFFMAN  *Huffman,
+  IN  CONST UINT8        *Lengths,
+  IN  UINTN              Count
+  )
+{
+  UINT16  Offsets[16];
+  INTN    Left;
+  UINTN   Length;
+  UINTN   Index;
+  UINTN   Symbol;
+  UINTN   Code;
+  UINTN   Reversed;
+  UINTN   Bit;
+  UINTN   Fill;
+
+  ZeroMem (Huffman->Count, sizeof (Huffman->Count));
+  ZeroMem (Huffman->Fast, sizeof (Huffman->Fast));
+  for (Symbol = 0; Symbol < Count; Symbol++) {
+    Huffman->Count[Lengths[Symbol]]++;
+  }
+
+  Left = 1;
+  for (Length = 1; Length < 16; Length++) {
+    Left <<= 1;
+    Left  -= Huffman->Count[Length];
+    if (Left < 0) {
+      return FALSE;
+    }
+  }
+
+  Offsets[1] = 0;
+  for (Length = 1; Length < 15; Length++) {
+    Offsets[Length + 1] = Offsets[Length] + Huffman->Count[Length];
+  }
+
+  for (Symbol = 0; Symbol < Count; Symbol++) {
+    if (Lengths[Symbol] != 0) {
+      Huffman->Symbol[Offsets[Lengths[Symbol]]++] = (UINT16)Symbol;
+    }
+  }
+
+  //
+  // Fill the lookup table with the short codes. The table is indexed by the
+  // next bits of the stream, which hold the code with its first bit lowest.
+  //
+  Code  = 0;
+  Index = 0;
+  for (Length = 1; Length <= HTTP_BOOT_INFLATE_FAST_BITS; Length++) {
+    for (Symbol = 0; Symbol < Huffman->Count[Length]; Symbol++) {
+      Reversed = 0;
+      for (Bit = 0; Bit < Length; Bit++) {
+        Reversed |= ((Code >> Bit) & 1) << (Length - 1 - Bit);
+      }
+
+      for (Fill = Reversed; Fill < ARRAY_SIZE (Huffman->Fast); Fill += (UINTN)1 << Length) {
+        Huffman->Fast[Fill] = (UINT16)((Length << 12) | Huffman->Symbol[Index]);
+      }
+
+      Code++;
+      Index++;
+    }
+
+    Code <<= 1;
+  }
+
+  return TRUE;
+}
+
+/**
+  Decode the next symbol of a Huffman code.
+
+  @param[in, out]  Inflate       The decoder.
+  @param[in]       Huffman       The Huffman code.
+
+  @return The symbol, INFLATE_SYMBOL_SHORT if the encoded data ran out, or
+          INFLATE_SYMBOL_INVALID if the code is not assigned.
+
+**/
+STATIC
+INTN
+InflateDecodeSymbol (
+  IN OUT HTTP_BOOT_INFLATE  *Inflate,
+  IN     HTTP_BOOT_HUFFMAN  *Huffman
+  )
+{
+  UINT16  Entry;
+  UINTN   Length;
+  UINTN   Code;
+  UINTN   First;
+  UINTN   Index;
+  UINTN   Count;
+
+  if (InflateNeedBits (Inflate, HTTP_BOOT_INFLATE_FAST_BITS)) {
+    Entry = Huffman->Fast[Inflate->BitBuffer & (ARRAY_SIZE (Huffman->Fast) - 1)];
+    if (Entry != 0) {
+      InflateDropBits (Inflate, Entry >> 12);
+      return Entry & 0xFFF;
+    }
+  }
+
+  //
+  // A long code, or too few bits left for a table lookup: walk the code bit by bit.
+  //
+  Code  = 0;
+  First = 0;
+  Index = 0;
+  for (Length = 1; Length < 16; Length++) {
+    if (!InflateNeedBits (Inflate, Length)) {
+      return INFLATE_SYMBOL_SHORT;
+    }
+
+    Code |= (Inflate->BitBuffer >> (Length - 1)) & 1;
+    Count = Huffman->Count[Length];
+    if (Code - First < Count) {
+      InflateDropBits (Inflate, Length);
+      return Huffman->Symbol[Index + Code - First];
+    }
+
+    Index  += Count;
+    First  += Count;
+    First <<= 1;
+    Code  <<= 1;
+  }
+
+  return INFLATE_SYMBOL_INVALID;
+}
+
+/**
+  Parse the gzip member header.
+
+  @param[in, out]  Inflate       The decoder.
+
+  @retval EFI_SUCCESS            The header was parsed.
+  @retval EFI_NOT_READY          More encoded data is needed.
+  @retval EFI_VOLUME_CORRUPTED   The header is not valid.
+
+**/
+STATIC
+EFI_STATUS
+InflateGzipHeader (
+  IN OUT HTTP_BOOT_INFLATE  *Inflate
+  )
+{
+  UINT32  Value;
+  UINT32  Flags;
+  UINT32  Length;
+
+  if (!InflateGetBits (Inflate, 8, &Value)) {
+    return EFI_NOT_READY;
+  }
+
+  if (Value != GZIP_ID1) {
+    return EFI_VOLUME_CORRUPTED;
+  }
+
+  if (!InflateGetBits (Inflate, 8, &Value)) {
+    return EFI_NOT_READY;
+  }
+
+  if (Value != GZIP_ID2) {
+    return EFI_VOLUME_CORRUPTED;
+  }
+
+  if (!InflateGetBits (Inflate, 8, &Value)) {
+    return EFI_NOT_READY;
+  }
+
+  if (Value != GZIP_CM_DEFLATE) {
+    return EFI_VOLUME_CORRUPTED;
+  }
+
+  if (!InflateGetBits (Inflate, 8, &Flags)) {
+    return EFI_NOT_READY;
+  }
+
+  if ((Flags & GZIP_FLG_RESERVED) != 0) {
+    return EFI_VOLUME_CORRUPTED;
+  }
+
+  //
+  // Skip MTIME, XFL and OS.
+  //
+  for (Length = 0; Length < 6; Length++) {
+    if (!InflateGetBits (Inflate, 8, &Value)) {
+      return EFI_NOT_READY;
+    }
+  }
+
+  if ((Flags & GZIP_FLG_FEXTRA) != 0) {
+    if (!InflateGetBits (Inflate, 16, &Length)) {
+      return EFI_NOT_READY;
+    }
+
+    while (Length-- > 0) {
+      if (!InflateGetBits (Inflate, 8, &Value)) {
+        return EFI_NOT_READY;
+      }
+    }
+  }
+
+  if ((Flags & GZIP_FLG_FNAME) != 0) {
+    do {
+      if (!InflateGetBits (Inflate, 8, &Value)) {
+        return EFI_NOT_READY;
+      }
+    } while (Value != 0);
+  }
+
+  if ((Flags & GZIP_FLG_FCOMMENT) != 0) {
+    do {
+      if (!InflateGetBits (Inflate, 8, &Value)) {
+        return EFI_NOT_READY;
+      }
+    } while (Value != 0);
+  }
+
+  if ((Flags & GZIP_FLG_FHCRC) != 0) {
+    if (!InflateGetBits (Inflate, 16, &Value)) {
+      return EFI_NOT_READY;
+    }
+  }
+
+  Inflate->State = HttpBootInflateBlockHeader;
+  return EFI_SUCCESS;
+}
+
+/**
+  Parse the header of a DEFLATE block, including the code lengths of a block
+  compressed with dynamic Huffman codes.
+
+  @param[in, out]  Inflate       The decoder.
+
+  @retval EFI_SUCCESS            The header was parsed.
+  @retval EFI_NOT_READY          More encoded data is needed.
+  @retval EFI_VOLUME_CORRUPTED   The header is not valid.
+
+**/
+STATIC
+EFI_STATUS
+InflateBlockHeader (
+  IN OUT HTTP_BOOT_INFLATE  *Inflate
+  )
+{
+  UINT8   Lengths[286 + 30];
+  UINT32  Value;
+  UINT32  Type;
+  UINT32  LitLenCount;
+  UINT32  DistCount;
+  UINT32  CodeLengthCount;
+  UINT32  Repeat;
+  UINTN   Index;
+  INTN    Symbol;
+  UINT8   Length;
+
+  if (!InflateGetBits (Inflate, 1, &Value) || !InflateGetBits (Inflate, 2, &Type)) {
+    return EFI_NOT_READY;
+  }
+
+  Inflate->LastBlock = (BOOLEAN)(Value != 0);
+
+  switch (Type) {
+    case 0:
+      //
+      // Stored block: LEN and NLEN follow at the next byte boundary.
+      //
+      InflateDropBits (Inflate, Inflate->BitCount & 7);
+      if (!InflateGetBits (Inflate, 16, &Value) || !InflateGetBits (Inflate, 16, &Repeat)) {
+        return EFI_NOT_READY;
+      }
+
+      if (Value != (~Repeat & 0xFFFF)) {
+        return EFI_VOLUME_CORRUPTED;
+      }
+
+      Inflate->StoredLength = Value;
+      Inflate->State        = HttpBootInflateStored;
+      return EFI_SUCCESS;
+
+    case 1:
+      //
+      // Fixed Huffman codes.
+      //
+      SetMem (Lengths, 144, 8);
+      SetMem (Lengths + 144, 256 - 144, 9);
+      SetMem (Lengths + 256, 280 - 256, 7);
+      SetMem (Lengths + 280, 288 - 280, 8);
+      InflateBuildHuffman (&Inflate->LitLen, Lengths, 288);
+      SetMem (Lengths, 30, 5);
+      InflateBuildHuffman (&Inflate->Dist, Lengths, 30);
+      Inflate->State = HttpBootInflateHuffman;
+      return EFI_SUCCESS;
+
+    case 2:
+      break;
+
+    default:
+      return EFI_VOLUME_CORRUPTED;
+  }
+
+  //
+  // Dynamic Huffman codes.
+  //
+  if (!InflateGetBits (Inflate, 5, &LitLenCount) ||
+      !InflateGetBits (Inflate, 5, &DistCount) ||
+      !InflateGetBits (Inflate, 4, &CodeLengthCount))
+  {
+    return EFI_NOT_READY;
+  }
+
+  LitLenCount     += 257;
+  DistCount       += 1;
+  CodeLengthCount += 4;
+  if ((LitLenCount > 286) || (DistCount > 30)) {
+    return EFI_VOLUME_CORRUPTED;
+  }
+
+  //
+  // The code length code is built in the distance code, which is rebuilt below.
+  //
+  ZeroMem (Lengths, 19);
+  for (Index = 0; Index < CodeLengthCount; Index++) {
+    if (!InflateGetBits (Inflate, 3, &Value)) {
+      return EFI_NOT_READY;
+    }
+
+    Lengths[mInflateCodeLengthOrder[Index]] = (UINT8)Value;
+  }
+
+  if (!InflateBuildHuffman (&Inflate->Dist, Lengths, 19)) {
+    return EFI_VOLUME_CORRUPTED;
+  }
+
+  Index = 0;
+  while (Index < LitLenCount + DistCount) {
+    Symbol = InflateDecodeSymbol (Inflate, &Inflate->Dist);
+    if (Symbol == INFLATE_SYMBOL_SHORT) {
+      return EFI_NOT_READY;
+    }
+
+    if (Symbol < 0) {
+      return EFI_VOLUME_CORRUPTED;
+    }
+
+    if (Symbol < 16) {
+      Lengths[Index++] = (UINT8)Symbol;
+      continue;
+    }
+
+    Length = 0;
+    if (Symbol == 16) {
+      if (Index == 0) {
+        return EFI_VOLUME_CORRUPTED;
+      }
+
+      Length = Lengths[Index - 1];
+      if (!InflateGetBits (Inflate, 2, &Repeat)) {
+        return EFI_NOT_READY;
+      }
+
+      Repeat += 3;
+    } else if (Symbol == 17) {
+      if (!InflateGetBits (Inflate, 3, &Repeat)) {
+        return EFI_NOT_READY;
+      }
+
+      Repeat += 3;
+    } else {
+      if (!InflateGetBits (Inflate, 7, &Repeat)) {
+        return EFI_NOT_READY;
+      }
+
+      Repeat += 11;
+    }
+
+    if (Index + Repeat > LitLenCount + DistCount) {
+      return EFI_VOLUME_CORRUPTED;
+    }
+
+    SetMem (Lengths + Index, Repeat, Length);
+    Index += Repeat;
+  }
+
+  //
+  // The end-of-block symbol must have a code.
+  //
+  if (Lengths[256] == 0) {
+    return EFI_VOLUME_CORRUPTED;
+  }
+
+  if (!InflateBuildHuffman (&Inflate->LitLen, Lengths, LitLenCount) ||
+      !InflateBuildHuffman (&Inflate->Dist, Lengths + LitLenCount, DistCount))
+  {
+    return EFI_VOLUME_CORRUPTED;
+  }
+
+  Inflate->State = HttpBootInflateHuffman;
+  return EFI_SUCCESS;
+}
+
+/**
+  Copy the data of a stored block to the output buffer.
+
+  @param[in, out]  Inflate       The decoder.
+
+  @retval EFI_SUCCESS            The block is complete.
+  @retval EFI_NOT_READY          More encoded data is needed. The data available
+                                 has been copied.
+  @retval EFI_BUFFER_TOO_SMALL   The output buffer is full.
+
+**/
+STATIC
+EFI_STATUS
+InflateStoredBlock (
+  IN OUT HTTP_BOOT_INFLATE  *Inflate
+  )
+{
+  UINTN  Length;
+
+  if (Inflate->StoredLength > Inflate->OutputSize - Inflate->OutputLength) {
+    return EFI_BUFFER_TOO_SMALL;
+  }
+
+  //
+  // The bit buffer is byte aligned here, it may still hold a few whole bytes.
+  //
+  while ((Inflate->StoredLength > 0) && (Inflate->BitCount >= 8)) {
+    Inflate->Output[Inflate->OutputLength++] = (UINT8)InflateDropBits (Inflate, 8);
+    Inflate->StoredLength--;
+  }
+
+  Length = MIN (Inflate->StoredLength, Inflate->CarryLength - Inflate->CarryPos);
+  CopyMem (Inflate->Output + Inflate->OutputLength, Inflate->Carry + Inflate->CarryPos, Length);
+  Inflate->CarryPos     += Length;
+  Inflate->OutputLength += Length;
+  Inflate->StoredLength -= Length;
+
+  Length = MIN (Inflate->StoredLength, Inflate->InputLength - Inflate->InputPos);
+  CopyMem (Inflate->Output + Inflate->OutputLength, Inflate->Input + Inflate->InputPos, Length);
+  Inflate->InputPos     += Length;
+  Inflate->OutputLength += Length;
+  Inflate->StoredLength -= Length;
+
+  if (Inflate->StoredLength != 0) {
+    return EFI_NOT_READY;
+  }
+
+  Inflate->State = Inflate->LastBlock ? HttpBootInflateGzipTrailer : HttpBootInflateBlockHeader;
+  return EFI_SUCCESS;
+}
+
+/**
+  Decode the symbols of a block compressed with Huffman codes.
+
+  @param[in, out]  Inflate       The decoder.
+
+  @retval EFI_SUCCESS            The block is complete.
+  @retval EFI_NOT_READY          More encoded data is needed. The symbols available
+                                 have been decoded.
+  @retval EFI_VOLUME_CORRUPTED   The block is not valid.
+  @retval EFI_BUFFER_TOO_SMALL   The output buffer is full.
+
+**/
+STATIC
+EFI_STATUS
+InflateHuffmanBlock (
+  IN OUT HTTP_BOOT_INFLATE  *Inflate
+  )
+{
+  INFLATE_CHECKPOINT  Checkpoint;
+  INTN                Symbol;
+  UINT32              Extra;
+  UINTN               Length;
+  UINTN               Distance;
+  UINT8               *Destination;
+  UINT8               *Source;
+  UINTN               Index;
+
+  for ( ; ;) {
+    InflateSave (Inflate, &Checkpoint);
+    Symbol = InflateDecodeSymbol (Inflate, &Inflate->LitLen);
+    if (Symbol == INFLATE_SYMBOL_SHORT) {
+      break;
+    }
+
+    if (Symbol < 0) {
+      return EFI_VOLUME_CORRUPTED;
+    }
+
+    if (Symbol < 256) {
+      if (Inflate->OutputLength == Inflate->OutputSize) {
+        return EFI_BUFFER_TOO_SMALL;
+      }
+
+      Inflate->Output[Inflate->OutputLength++] = (UINT8)Symbol;
+      continue;
+    }
+
+    if (Symbol == 256) {
+      Inflate->State = Inflate->LastBlock ? HttpBootInflateGzipTrailer : HttpBootInflateBlockHeader;
+      return EFI_SUCCESS;
+    }
+
+    Symbol -= 257;
+    if (Symbol >= (INTN)ARRAY_SIZE (mInflateLengthBase)) {
+      return EFI_VOLUME_CORRUPTED;
+    }
+
+    if (!InflateGetBits (Inflate, mInflateLengthExtra[Symbol], &Extra)) {
+      break;
+    }
+
+    Length = mInflateLengthBase[Symbol] + Extra;
+
+    Symbol = InflateDecodeSymbol (Inflate, &Inflate->Dist);
+    if (Symbol == INFLATE_SYMBOL_SHORT) {
+      break;
+    }
+
+    if ((Symbol < 0) || (Symbol >= (INTN)ARRAY_SIZE (mInflateDistBase))) {
+      return EFI_VOLUME_CORRUPTED;
+    }
+
+    if (!InflateGetBits (Inflate, mInflateDistExtra[Symbol], &Extra)) {
+      break;
+    }
+
+    Distance = mInflateDistBase[Symbol] + Extra;
+    if (Distance > Inflate->OutputLength) {
+      return EFI_VOLUME_CORRUPTED;
+    }
+
+    if (Length > Inflate->OutputSize - Inflate->OutputLength) {
+      return EFI_BUFFER_TOO_SMALL;
+    }
+
+    //
+    // The source may overlap the destination, copy byte by byte.
+    //
+    Destination = Inflate->Output + Inflate->OutputLength;
+    Source      = Destination - Distance;
+    for (Index = 0; Index < Length; Index++) {
+      Destination[Index] = Source[Index];
+    }
+
+    Inflate->OutputLength += Length;
+  }
+
+  InflateRestore (Inflate, &Checkpoint);
+  return EFI_NOT_READY;
+}
+
+/**
+  Parse the gzip member trailer and verify the decoded data against it.
+
+  @param[in, out]  Inflate       The decoder.
+
+  @retval EFI_SUCCESS            The decoded data matches the trailer.
+  @retval EFI_NOT_READY          More encoded data is needed.
+  @retval EFI_VOLUME_CORRUPTED   The decoded data does not match the trailer.
+
+**/
+STATIC
+EFI_STATUS
+InflateGzipTrailer (
+  IN OUT HTTP_BOOT_INFLATE  *Inflate
+  )
+{
+  UINT32  Low;
+  UINT32  High;
+  UINT32  Crc;
+
+  InflateDropBits (Inflate, Inflate->BitCount & 7);
+  if (!InflateGetBits (Inflate, 16, &Low) || !InflateGetBits (Inflate, 16, &High)) {
+    return EFI_NOT_READY;
+  }
+
+  Crc = Low | (High << 16);
+  if (!InflateGetBits (Inflate, 16, &Low) || !InflateGetBits (Inflate, 16, &High)) {
+    return EFI_NOT_READY;
+  }
+
+  if (((Low | (High << 16)) != (UINT32)Inflate->OutputLength) ||
+      (Crc != CalculateCrc32 (Inflate->Output, Inflate->OutputLength)))
+  {
+    return EFI_VOLUME_CORRUPTED;
+  }
+
+  Inflate->State = HttpBootInflateDone;
+  return EFI_SUCCESS;
+}
+
+/**
+  Initialize the decoder for a new gzip stream.
+
+  @param[out]  Inflate       The decoder.
+  @param[in]   Output        The buffer to decode the stream to.
+  @param[in]   OutputSize    The size of Output in bytes.
+
+**/
+VOID
+HttpBootInflateInit (
+  OUT HTTP_BOOT_INFLATE  *Inflate,
+  IN  UINT8              *Output,
+  IN  UINTN              OutputSize
+  )
+{
+  ZeroMem (Inflate, sizeof (HTTP_BOOT_INFLATE));
+  Inflate->State      = HttpBootInflateGzipHeader;
+  Inflate->Output     = Output;
+  Inflate->OutputSize = OutputSize;
+}
+
+/**
+  Decode the next part of a gzip stream.
+
+  All of Input is consumed. Whatever cannot be decoded until more data arrives
+  is kept in the decoder. Data following the end of the stream is ignored.
+
+  @param[in, out]  Inflate       The decoder.
+  @param[in]       Input         The next encoded bytes of the stream.
+  @param[in]       InputLength   The number of bytes in Input.
+
+  @retval EFI_SUCCESS            Input was consumed. Inflate->State is HttpBootInflateDone
+                                 once the whole stream has been decoded and its CRC32
+                                 and size have been verified.
+  @retval EFI_VOLUME_CORRUPTED   The stream is not valid gzip data.
+  @retval EFI_BUFFER_TOO_SMALL   The decoded data does not fit in the output buffer.
+  @retval EFI_UNSUPPORTED        A gzip header field is too large to be kept in the decoder.
+
+**/
+EFI_STATUS
+HttpBootInflate (
+  IN OUT HTTP_BOOT_INFLATE  *Inflate,
+  IN     CONST UINT8        *Input,
+  IN     UINTN              InputLength
+  )
+{
+  EFI_STATUS          Status;
+  INFLATE_CHECKPOINT  Checkpoint;
+  UINTN               Length;
+
+  Inflate->Input       = Input;
+  Inflate->InputLength = InputLength;
+  Inflate->InputPos    = 0;
+
+  Status = EFI_SUCCESS;
+  while (!EFI_ERROR (Status) && (Inflate->State != HttpBootInflateDone)) {
+    InflateSave (Inflate, &Checkpoint);
+    switch (Inflate->State) {
+      case HttpBootInflateGzipHeader:
+        Status = InflateGzipHeader (Inflate);
+        break;
+
+      case HttpBootInflateBlockHeader:
+        Status = InflateBlockHeader (Inflate);
+        break;
+
+      case HttpBootInflateStored:
+        //
+        // Copied data is not given back, the block keeps track of its progress.
+        //
+        Status = InflateStoredBlock (Inflate);
+        InflateSave (Inflate, &Checkpoint);
+        break;
+
+      case HttpBootInflateHuffman:
+        //
+        // Decoded symbols are not given back, the block stops at the last complete one.
+        //
+        Status = InflateHuffmanBlock (Inflate);
+        InflateSave (Inflate, &Checkpoint);
+        break;
+
+      case HttpBootInflateGzipTrailer:
+        Status = InflateGzipTrailer (Inflate);
+        break;
+
+      default:
+        Status = EFI_VOLUME_CORRUPTED;
+        break;
+    }
+  }
+
+  if (Status == EFI_NOT_READY) {
+    //
+    // Keep the encoded bytes of the unit which is not complete yet.
+    //
+    InflateRestore (Inflate, &Checkpoint);
+    Length = Inflate->CarryLength - Inflate->CarryPos;
+    if (Length + Inflate->InputLength - Inflate->InputPos > sizeof (Inflate->Carry)) {
+      Status = EFI_UNSUPPORTED;
+    } else {
+      CopyMem (Inflate->Carry, Inflate->Carry + Inflate->CarryPos, Length);
+      CopyMem (Inflate->Carry + Length, Inflate->Input + Inflate->InputPos, Inflate->InputLength - Inflate->InputPos);
+      Inflate->CarryLength = Length + Inflate->InputLength - Inflate->InputPos;
+      Inflate->CarryPos    = 0;
+      Status               = EFI_SUCCESS;
+    }
+  } else if (!EFI_ERROR (Status)) {
+    Inflate->CarryLength = 0;
+    Inflate->CarryPos    = 0;
+  }
+
+  Inflate->Input       = NULL;
+  Inflate->InputLength = 0;
+  Inflate->InputPos    = 0;
+  return Status;
+}
@@ -0,0 +1,116 @@
+/** @file
+  Declaration of the streaming gzip decoder for the HTTP Content-Encoding.
+
+  Copyright (c) 2026, agent. All rights reserved.<BR>
+
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#ifndef __EFI_HTTP_BOOT_INFLATE_H__
+#define __EFI_HTTP_BOOT_INFLATE_H__
+
+//
+// Encoded bytes kept between two calls of HttpBootInflate() when a gzip header,
+// a block header or a Huffman symbol is split across them.
+//
+#define HTTP_BOOT_INFLATE_CARRY_SIZE  1024
+
+//
+// Codes up to this length are decoded with a single table lookup.
+//
+#define HTTP_BOOT_INFLATE_FAST_BITS  9
+
+typedef enum {
+  HttpBootInflateGzipHeader,
+  HttpBootInflateBlockHeader,
+  HttpBootInflateStored,
+  HttpBootInflateHuffman,
+  HttpBootInflateGzipTrailer,
+  HttpBootInflateDone
+} HTTP_BOOT_INFLATE_STATE;
+
+//
+// A canonical Huffman code of a DEFLATE block.
+//
+typedef struct {
+  UINT16    Count[16];                                  // Number of codes of each length.
+  UINT16    Symbol[288];                                // Symbols ordered by code length.
+  UINT16    Fast[1 << HTTP_BOOT_INFLATE_FAST_BITS];     // (Length << 12) | Symbol, or 0 for longer codes.
+} HTTP_BOOT_HUFFMAN;
+
+//
+// Decoder state of a gzip stream (RFC1952) which is decoded into a memory buffer
+// as the encoded data arrives.
+//
+typedef struct {
+  HTTP_BOOT_INFLATE_STATE    State;
+  BOOLEAN                    LastBlock;
+  UINTN                      StoredLength;  // Bytes left in the current stored block.
+
+  //
+  // Decoded data. Back references are resolved in the buffer itself, so the
+  // whole buffer serves as the sliding window.
+  //
+  UINT8                      *Output;
+  UINTN                      OutputSize;
+  UINTN                      OutputLength;
+
+  //
+  // Encoded data: the bytes carried over from the previous call are read
+  // before the bytes passed to the current one.
+  //
+  UINT32                     BitBuffer;
+  UINTN                      BitCount;
+  UINT8                      Carry[HTTP_BOOT_INFLATE_CARRY_SIZE];
+  UINTN                      CarryLength;
+  UINTN                      CarryPos;
+  CONST UINT8                *Input;
+  UINTN                      InputLength;
+  UINTN                      InputPos;
+
+  HTTP_BOOT_HUFFMAN          LitLen;
+  HTTP_BOOT_HUFFMAN          Dist;
+} HTTP_BOOT_INFLATE;
+
+/**
+  Initialize the decoder for a new gzip stream.
+
+  @param[out]  Inflate       The decoder.
+  @param[in]   Output        The buffer to decode the stream to.
+  @param[in]   OutputSize    The size of Output in bytes.
+
+**/
+VOID
+HttpBootInflateInit (
+  OUT HTTP_BOOT_INFLATE  *Inflate,
+  IN  UINT8              *Output,
+  IN  UINTN              OutputSize
+  );
+
+/**
+  Decode the next part of a gzip stream.
+
+  All of Input is consumed. Whatever cannot be decoded until more data arrives
+  is kept in the decoder. Data following the end of the stream is ignored.
+
+  @param[in, out]  Inflate       The decoder.
+  @param[in]       Input         The next encoded bytes of the stream.
+  @param[in]       InputLength   The number of bytes in Input.
+
+  @retval EFI_SUCCESS            Input was consumed. Inflate->State is HttpBootInflateDone
+                                 once the whole stream has been decoded and its CRC32
+                                 and size have been verified.
+  @retval EFI_VOLUME_CORRUPTED   The stream is not valid gzip data.
+  @retval EFI_BUFFER_TOO_SMALL   The decoded data does not fit in the output buffer.
+  @retval EFI_UNSUPPORTED        A gzip header field is too large to be kept in the decoder.
+
+**/
+EFI_STATUS
+HttpBootInflate (
+  IN OUT HTTP_BOOT_INFLATE  *Inflate,
+  IN     CONST UINT8        *Input,
+  IN     UINTN              InputLength
+  );
+
+#endif
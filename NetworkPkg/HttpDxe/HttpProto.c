@@ -821,6 +821,13 @@ HttpCleanProtocol (
   IN  HTTP_PROTOCOL  *HttpInstance
   )
 {
+  //
+  // Keep the TLS session for the next connection to the same host.
+  //
+  if (HttpInstance->TlsAlreadyCreated) {
+    TlsSaveSession (HttpInstance);
+  }
+
   HttpCloseConnection (HttpInstance);
 
   HttpCloseTcpConnCloseEvent (HttpInstance);
@@ -1088,6 +1095,7 @@ HttpConfigureTcp4 (
   Tcp4Option->KeepAliveInterval   = HTTP_KEEP_ALIVE_INTERVAL;
   Tcp4Option->EnableNagle         = TRUE;
   Tcp4Option->EnableWindowScaling = TRUE;
+  Tcp4Option->EnableSelectiveAck  = TRUE;
   Tcp4CfgData->ControlOption      = Tcp4Option;
 
   if ((HttpInstance->State == HTTP_STATE_TCP_CONNECTED) ||
@@ -1172,6 +1180,7 @@ HttpConfigureTcp6 (
   Tcp6Option->KeepAliveInterval   = HTTP_KEEP_ALIVE_INTERVAL;
   Tcp6Option->EnableNagle         = TRUE;
   Tcp6Option->EnableWindowScaling = TRUE;
+  Tcp6Option->EnableSelectiveAck  = TRUE;
 
   if ((HttpInstance->State == HTTP_STATE_TCP_CONNECTED) ||
       (HttpInstance->State == HTTP_STATE_TCP_CLOSED))
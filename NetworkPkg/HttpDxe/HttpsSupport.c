@@ -10,6 +10,13 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 
 #include "HttpDriver.h"
 
+//
+// TLS sessions of the recent HTTPS connections. The oldest entry is replaced
+// when it is full.
+//
+HTTPS_SESSION_CACHE_ENTRY  mHttpsSessionCache[HTTPS_SESSION_CACHE_SIZE];
+UINTN                      mHttpsSessionCacheNext;
+
 /**
   Returns the first occurrence of a Null-terminated ASCII sub-string in a Null-terminated
   ASCII string and ignore case during the search process.
@@ -1157,6 +1164,127 @@ ON_EXIT:
   return Status;
 }
 
+/**
+  Find the TLS session cache entry of a host and port.
+
+  @param[in]  HostName           The host name.
+  @param[in]  Port               The port.
+
+  @return  The cache entry, or NULL if there is none.
+
+**/
+STATIC
+HTTPS_SESSION_CACHE_ENTRY *
+HttpsFindSessionCacheEntry (
+  IN CHAR8   *HostName,
+  IN UINT16  Port
+  )
+{
+  UINTN  Index;
+
+  for (Index = 0; Index < HTTPS_SESSION_CACHE_SIZE; Index++) {
+    if ((mHttpsSessionCache[Index].HostName != NULL) &&
+        (mHttpsSessionCache[Index].Port == Port) &&
+        (AsciiStrCmp (mHttpsSessionCache[Index].HostName, HostName) == 0))
+    {
+      return &mHttpsSessionCache[Index];
+    }
+  }
+
+  return NULL;
+}
+
+/**
+  Keep the session ID of the established TLS session, so that the next TLS
+  connection to the same host and port can resume it.
+
+  @param[in]  HttpInstance       The HTTP instance private data.
+
+**/
+VOID
+EFIAPI
+TlsSaveSession (
+  IN  HTTP_PROTOCOL  *HttpInstance
+  )
+{
+  EFI_STATUS                 Status;
+  EFI_TLS_SESSION_ID         SessionId;
+  UINTN                      SessionIdSize;
+  HTTPS_SESSION_CACHE_ENTRY  *Entry;
+  CHAR8                      *HostName;
+
+  if ((HttpInstance->Tls == NULL) || (HttpInstance->RemoteHost == NULL) ||
+      (HttpInstance->TlsSessionState != EfiTlsSessionDataTransferring))
+  {
+    return;
+  }
+
+  SessionIdSize = sizeof (SessionId);
+  Status        = HttpInstance->Tls->GetSessionData (
+                                       HttpInstance->Tls,
+                                       EfiTlsSessionID,
+                                       &SessionId,
+                                       &SessionIdSize
+                                       );
+  if (EFI_ERROR (Status) || (SessionId.Length == 0)) {
+    return;
+  }
+
+  Entry = HttpsFindSessionCacheEntry (HttpInstance->RemoteHost, HttpInstance->RemotePort);
+  if (Entry == NULL) {
+    HostName = AllocateCopyPool (AsciiStrSize (HttpInstance->RemoteHost), HttpInstance->RemoteHost);
+    if (HostName == NULL) {
+      return;
+    }
+
+    Entry                  = &mHttpsSessionCache[mHttpsSessionCacheNext];
+    mHttpsSessionCacheNext = (mHttpsSessionCacheNext + 1) % HTTPS_SESSION_CACHE_SIZE;
+    if (Entry->HostName != NULL) {
+      FreePool (Entry->HostName);
+    }
+
+    Entry->HostName = HostName;
+    Entry->Port     = HttpInstance->RemotePort;
+  }
+
+  CopyMem (&Entry->SessionId, &SessionId, sizeof (SessionId));
+}
+
+/**
+  Offer the TLS session saved for the host and port of the HTTP instance for
+  resumption. A full handshake is done if there is none, or if the server
+  doesn't resume it.
+
+  @param[in]  HttpInstance       The HTTP instance private data.
+
+**/
+VOID
+EFIAPI
+TlsResumeSession (
+  IN  HTTP_PROTOCOL  *HttpInstance
+  )
+{
+  EFI_STATUS                 Status;
+  HTTPS_SESSION_CACHE_ENTRY  *Entry;
+
+  if (HttpInstance->RemoteHost == NULL) {
+    return;
+  }
+
+  Entry = HttpsFindSessionCacheEntry (HttpInstance->RemoteHost, HttpInstance->RemotePort);
+  if (Entry == NULL) {
+    return;
+  }
+
+  Status = HttpInstance->Tls->SetSessionData (
+                                HttpInstance->Tls,
+                                EfiTlsSessionID,
+                                &Entry->SessionId,
+                                sizeof (EFI_TLS_SESSION_ID)
+                                );
+  DEBUG ((DEBUG_INFO, "TlsResumeSession: Resume the session of %a:%d - %r\n", Entry->HostName, Entry->Port, Status));
+}
+
 /**
   Connect one TLS session by finishing the TLS handshake process.
 
@@ -1207,6 +1335,11 @@ TlsConnectSession (
     return Status;
   }
 
+  //
+  // Try to resume the previous session with the same host.
+  //
+  TlsResumeSession (HttpInstance);
+
   //
   // Create ClientHello
   //
@@ -1405,6 +1538,8 @@ TlsConnectSession (
 
   if (HttpInstance->TlsSessionState != EfiTlsSessionDataTransferring) {
     Status = EFI_ABORTED;
+  } else {
+    TlsSaveSession (HttpInstance);
   }
 
   return Status;
@@ -1444,6 +1579,12 @@ TlsCloseSession (
     return EFI_INVALID_PARAMETER;
   }
 
+  //
+  // Keep the session for the next connection to the same host, a TLS 1.3
+  // server may have sent new session tickets since the handshake.
+  //
+  TlsSaveSession (HttpInstance);
+
   HttpInstance->TlsSessionState = EfiTlsSessionClosing;
 
   Status = HttpInstance->Tls->SetSessionData (
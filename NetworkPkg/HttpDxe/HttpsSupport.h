@@ -12,6 +12,20 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 
 #define HTTPS_DEFAULT_PORT  443
 
+//
+// Number of TLS sessions kept for resumption.
+//
+#define HTTPS_SESSION_CACHE_SIZE  8
+
+//
+// TLS session of a recent HTTPS connection, keyed by host and port.
+//
+typedef struct {
+  CHAR8                 *HostName;
+  UINT16                Port;
+  EFI_TLS_SESSION_ID    SessionId;
+} HTTPS_SESSION_CACHE_ENTRY;
+
 #define HTTPS_FLAG  "https://"
 
 /**
@@ -169,6 +183,33 @@ TlsReceiveOnePdu (
   IN     EFI_EVENT      Timeout
   );
 
+/**
+  Keep the session ID of the established TLS session, so that the next TLS
+  connection to the same host and port can resume it.
+
+  @param[in]  HttpInstance       The HTTP instance private data.
+
+**/
+VOID
+EFIAPI
+TlsSaveSession (
+  IN  HTTP_PROTOCOL  *HttpInstance
+  );
+
+/**
+  Offer the TLS session saved for the host and port of the HTTP instance for
+  resumption. A full handshake is done if there is none, or if the server
+  doesn't resume it.
+
+  @param[in]  HttpInstance       The HTTP instance private data.
+
+**/
+VOID
+EFIAPI
+TlsResumeSession (
+  IN  HTTP_PROTOCOL  *HttpInstance
+  );
+
 /**
   Connect one TLS session by finishing the TLS handshake process.
 
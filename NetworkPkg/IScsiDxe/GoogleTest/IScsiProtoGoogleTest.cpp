@@ -0,0 +1,1055 @@
+/** @file
+  Tests for the outstanding SCSI commands of IScsiProto.c.
+
+  The real pass thru, command and receive paths run against a simulated target.
+  The TCP connection and the timers are simulated too, on a clock in units of
+  100ns, so that a target which does not answer is observed rather than waited for.
+
+  Copyright (c) 2026, agent. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+**/
+#include <gtest/gtest.h>
+#include <deque>
+#include <iostream>
+#include <set>
+#include <vector>
+
+extern "C" {
+  #include <Uefi.h>
+  #include <Library/BaseLib.h>
+  #include <Library/BaseMemoryLib.h>
+  #include <Library/MemoryAllocationLib.h>
+  #include "../IScsiImpl.h"
+}
+
+////////////////////////////////////////////////////////////////////////
+// Defines
+////////////////////////////////////////////////////////////////////////
+
+#define TEST_BLOCK_SIZE  512
+
+//
+// The command window the target grants, and its round trip time.
+//
+#define TEST_CMD_WINDOW  8
+#define TEST_RTT         (2 * TICKS_PER_MS)
+
+//
+// 1 Gbit/s.
+//
+#define TEST_LINK_BYTES_PER_US  125
+
+////////////////////////////////////////////////////////////////////////
+// Simulated clock and events
+////////////////////////////////////////////////////////////////////////
+
+typedef struct {
+  UINT32              Type;
+  EFI_EVENT_NOTIFY    Notify;
+  VOID                *Context;
+  BOOLEAN             Signaled;
+  EFI_TIMER_DELAY     TimerType;
+  UINT64              TriggerTime;
+  UINT64              Period;
+} FAKE_EVENT;
+
+static UINT64                  mNow;
+static std::set<FAKE_EVENT *>  mEvents;
+
+static EFI_STATUS
+EFIAPI
+FakeCreateEvent (
+  IN  UINT32            Type,
+  IN  EFI_TPL           NotifyTpl,
+  IN  EFI_EVENT_NOTIFY  NotifyFunction,
+  IN  VOID              *NotifyContext,
+  OUT EFI_EVENT         *Event
+  )
+{
+  FAKE_EVENT  *FakeEvent;
+
+  FakeEvent            = new FAKE_EVENT ();
+  FakeEvent->Type      = Type;
+  FakeEvent->Notify    = NotifyFunction;
+  FakeEvent->Context   = NotifyContext;
+  FakeEvent->TimerType = TimerCancel;
+
+  mEvents.insert (FakeEvent);
+  *Event = FakeEvent;
+
+  return EFI_SUCCESS;
+}
+
+static EFI_STATUS
+EFIAPI
+FakeCloseEvent (
+  IN EFI_EVENT  Event
+  )
+{
+  FAKE_EVENT  *FakeEvent;
+
+  FakeEvent = (FAKE_EVENT *)Event;
+  if (mEvents.erase (FakeEvent) == 0) {
+    return EFI_INVALID_PARAMETER;
+  }
+
+  delete FakeEvent;
+  return EFI_SUCCESS;
+}
+
+static EFI_STATUS
+EFIAPI
+FakeSetTimer (
+  IN EFI_EVENT        Event,
+  IN EFI_TIMER_DELAY  Type,
+  IN UINT64           TriggerTime
+  )
+{
+  FAKE_EVENT  *FakeEvent;
+
+  FakeEvent              = (FAKE_EVENT *)Event;
+  FakeEvent->TimerType   = Type;
+  FakeEvent->TriggerTime = mNow + TriggerTime;
+  FakeEvent->Period      = TriggerTime;
+
+  return EFI_SUCCESS;
+}
+
+static EFI_STATUS
+EFIAPI
+FakeSignalEvent (
+  IN EFI_EVENT  Event
+  )
+{
+  FAKE_EVENT  *FakeEvent;
+
+  FakeEvent = (FAKE_EVENT *)Event;
+  if (((FakeEvent->Type & EVT_NOTIFY_SIGNAL) != 0) && (FakeEvent->Notify != NULL)) {
+    FakeEvent->Notify (Event, FakeEvent->Context);
+  } else {
+    FakeEvent->Signaled = TRUE;
+  }
+
+  return EFI_SUCCESS;
+}
+
+static EFI_STATUS
+EFIAPI
+FakeCheckEvent (
+  IN EFI_EVENT  Event
+  )
+{
+  FAKE_EVENT  *FakeEvent;
+
+  FakeEvent = (FAKE_EVENT *)Event;
+  if (FakeEvent->Signaled) {
+    FakeEvent->Signaled = FALSE;
+    return EFI_SUCCESS;
+  }
+
+  if ((FakeEvent->TimerType != TimerCancel) && (mNow >= FakeEvent->TriggerTime)) {
+    return EFI_SUCCESS;
+  }
+
+  return EFI_NOT_READY;
+}
+
+static EFI_STATUS
+EFIAPI
+FakeCloseProtocol (
+  IN EFI_HANDLE  Handle,
+  IN EFI_GUID    *Protocol,
+  IN EFI_HANDLE  AgentHandle,
+  IN EFI_HANDLE  ControllerHandle
+  )
+{
+  return EFI_SUCCESS;
+}
+
+static EFI_TPL
+EFIAPI
+FakeRaiseTpl (
+  IN EFI_TPL  NewTpl
+  )
+{
+  return TPL_APPLICATION;
+}
+
+static VOID
+EFIAPI
+FakeRestoreTpl (
+  IN EFI_TPL  OldTpl
+  )
+{
+}
+
+static EFI_STATUS
+EFIAPI
+FakeFreePool (
+  IN VOID  *Buffer
+  )
+{
+  FreePool (Buffer);
+  return EFI_SUCCESS;
+}
+
+/**
+  Advance the clock to the next timer with a notification function, and run it.
+
+  @retval TRUE   A timer was run.
+  @retval FALSE  No such timer is armed.
+**/
+static BOOLEAN
+FireNextTimer (
+  VOID
+  )
+{
+  FAKE_EVENT  *Next;
+
+  Next = NULL;
+  for (FAKE_EVENT *FakeEvent : mEvents) {
+    if ((FakeEvent->Notify != NULL) && (FakeEvent->TimerType != TimerCancel) &&
+        ((Next == NULL) || (FakeEvent->TriggerTime < Next->TriggerTime)))
+    {
+      Next = FakeEvent;
+    }
+  }
+
+  if (Next == NULL) {
+    return FALSE;
+  }
+
+  mNow = MAX (mNow, Next->TriggerTime);
+  if (Next->TimerType == TimerPeriodic) {
+    Next->TriggerTime += Next->Period;
+  } else {
+    Next->TimerType = TimerCancel;
+  }
+
+  Next->Notify (Next, Next->Context);
+  return TRUE;
+}
+
+////////////////////////////////////////////////////////////////////////
+// Simulated connection
+////////////////////////////////////////////////////////////////////////
+
+//
+// The bytes the target has sent, with the time they reach the initiator.
+//
+typedef struct {
+  UINT64                ReadyAt;
+  std::vector<UINT8>    Bytes;
+} WIRE_CHUNK;
+
+static std::deque<WIRE_CHUNK>  mWire;
+static UINTN                   mWireOffset;
+static UINT32                  mWireChunksRead;
+static EFI_TCP4_IO_TOKEN       *mPendingRx;
+static EFI_TCP4_PROTOCOL       mFakeTcp4;
+
+//
+// The blocking receives, and whether one of them would never have returned.
+//
+static UINTN    mReceiveCalls;
+static BOOLEAN  mReceiveHung;
+
+static UINTN
+WireReadyBytes (
+  VOID
+  )
+{
+  UINTN  Length;
+
+  Length = 0;
+  for (const WIRE_CHUNK &Chunk : mWire) {
+    if (Chunk.ReadyAt > mNow) {
+      break;
+    }
+
+    Length += Chunk.Bytes.size ();
+  }
+
+  return (Length == 0) ? 0 : Length - mWireOffset;
+}
+
+static VOID
+WireRead (
+  OUT UINT8  *Buffer,
+  IN  UINTN  Length
+  )
+{
+  UINTN  Copy;
+
+  while (Length != 0) {
+    WIRE_CHUNK  &Chunk = mWire.front ();
+
+    Copy = MIN (Length, Chunk.Bytes.size () - mWireOffset);
+    CopyMem (Buffer, Chunk.Bytes.data () + mWireOffset, Copy);
+    Buffer      += Copy;
+    Length      -= Copy;
+    mWireOffset += Copy;
+
+    if (mWireOffset == Chunk.Bytes.size ()) {
+      mWire.pop_front ();
+      mWireOffset = 0;
+      mWireChunksRead++;
+    }
+  }
+}
+
+static VOID
+CompletePendingRx (
+  IN EFI_STATUS  Status
+  )
+{
+  EFI_TCP4_IO_TOKEN  *Token;
+
+  Token                         = mPendingRx;
+  mPendingRx                    = NULL;
+  Token->CompletionToken.Status = Status;
+  gBS->SignalEvent (Token->CompletionToken.Event);
+}
+
+static EFI_STATUS
+EFIAPI
+FakeTcp4Receive (
+  IN EFI_TCP4_PROTOCOL  *This,
+  IN EFI_TCP4_IO_TOKEN  *Token
+  )
+{
+  if (mPendingRx != NULL) {
+    return EFI_ACCESS_DENIED;
+  }
+
+  mPendingRx = Token;
+  return EFI_SUCCESS;
+}
+
+static EFI_STATUS
+EFIAPI
+FakeTcp4Poll (
+  IN EFI_TCP4_PROTOCOL  *This
+  )
+{
+  EFI_TCP4_RECEIVE_DATA  *RxData;
+
+  if (mPendingRx == NULL) {
+    return EFI_SUCCESS;
+  }
+
+  RxData = mPendingRx->Packet.RxData;
+  if (WireReadyBytes () >= RxData->DataLength) {
+    WireRead ((UINT8 *)RxData->FragmentTable[0].FragmentBuffer, RxData->FragmentTable[0].FragmentLength);
+    CompletePendingRx (EFI_SUCCESS);
+  }
+
+  return EFI_SUCCESS;
+}
+
+static EFI_STATUS
+EFIAPI
+FakeTcp4Cancel (
+  IN EFI_TCP4_PROTOCOL          *This,
+  IN EFI_TCP4_COMPLETION_TOKEN  *Token OPTIONAL
+  )
+{
+  if ((mPendingRx == NULL) || (&mPendingRx->CompletionToken != Token)) {
+    return EFI_NOT_FOUND;
+  }
+
+  CompletePendingRx (EFI_ABORTED);
+  return EFI_SUCCESS;
+}
+
+////////////////////////////////////////////////////////////////////////
+// Simulated target
+////////////////////////////////////////////////////////////////////////
+
+typedef struct {
+  UINT32    InitiatorTaskTag;
+  UINT32    Lba;
+  UINT32    Length;
+} TARGET_COMMAND;
+
+typedef struct {
+  //
+  // Hold the commands instead of answering them, or answer them in reverse
+  // order once ReverseBatch of them are received.
+  //
+  BOOLEAN                        Silent;
+  UINT32                         ReverseBatch;
+  std::vector<TARGET_COMMAND>    Held;
+
+  UINT32                         StatSN;
+  UINT32                         ExpCmdSN;
+  UINT32                         Done;
+  UINT64                         LinkFreeAt;
+
+  //
+  // The commands received, the nonblocking ones whose events are signaled, and
+  // the most commands outstanding on the connection at once.
+  //
+  UINT32                         Received;
+  UINT32                         Completed;
+  UINT32                         MaxOutstanding;
+} TARGET;
+
+static TARGET  mTarget;
+
+static UINT8
+BlockByte (
+  IN UINT32  Lba,
+  IN UINT32  Offset
+  )
+{
+  return (UINT8)((Lba + Offset / TEST_BLOCK_SIZE) * 131 + Offset);
+}
+
+/**
+  Send the data and the status of a READ command in one SCSI Data-In PDU.
+**/
+static VOID
+TargetRespond (
+  IN const TARGET_COMMAND  &Command
+  )
+{
+  WIRE_CHUNK          Chunk;
+  ISCSI_SCSI_DATA_IN  *DataIn;
+  UINT32              Offset;
+
+  Chunk.Bytes.assign (sizeof (ISCSI_SCSI_DATA_IN) + Command.Length, 0);
+
+  mTarget.Done++;
+
+  DataIn         = (ISCSI_SCSI_DATA_IN *)Chunk.Bytes.data ();
+  DataIn->OpCode = ISCSI_OPCODE_SCSI_DATA_IN;
+  DataIn->Flags  = ISCSI_BHS_FLAG_FINAL | SCSI_DATA_IN_PDU_FLAG_STATUS_VALID;
+  ISCSI_SET_DATASEG_LEN (DataIn, Command.Length);
+  DataIn->InitiatorTaskTag  = HTONL (Command.InitiatorTaskTag);
+  DataIn->TargetTransferTag = HTONL (ISCSI_RESERVED_TAG);
+  DataIn->StatSN            = HTONL (mTarget.StatSN++);
+  DataIn->ExpCmdSN          = HTONL (mTarget.ExpCmdSN);
+  DataIn->MaxCmdSN          = HTONL (mTarget.Done + TEST_CMD_WINDOW);
+
+  for (Offset = 0; Offset < Command.Length; Offset++) {
+    Chunk.Bytes[sizeof (ISCSI_SCSI_DATA_IN) + Offset] = BlockByte (Command.Lba, Offset);
+  }
+
+  //
+  // The PDUs share the link, each one after the previous one.
+  //
+  Chunk.ReadyAt      = MAX (mNow + TEST_RTT, mTarget.LinkFreeAt) + Chunk.Bytes.size () * 10 / TEST_LINK_BYTES_PER_US;
+  mTarget.LinkFreeAt = Chunk.ReadyAt;
+
+  mWire.push_back (Chunk);
+}
+
+static VOID
+TargetRespondHeld (
+  VOID
+  )
+{
+  for (const TARGET_COMMAND &Command : mTarget.Held) {
+    TargetRespond (Command);
+  }
+
+  mTarget.Held.clear ();
+}
+
+////////////////////////////////////////////////////////////////////////
+// Symbol Definitions
+// These functions are not directly under test - but required to compile
+////////////////////////////////////////////////////////////////////////
+
+extern "C" {
+  EFI_STATUS
+  EFIAPI
+  TcpIoCreateSocket (
+    IN EFI_HANDLE          Image,
+    IN EFI_HANDLE          Controller,
+    IN UINT8               TcpVersion,
+    IN TCP_IO_CONFIG_DATA  *ConfigData,
+    OUT TCP_IO             *TcpIo
+    )
+  {
+    ZeroMem (TcpIo, sizeof (TCP_IO));
+    TcpIo->TcpVersion = TcpVersion;
+    TcpIo->Tcp.Tcp4   = &mFakeTcp4;
+    return EFI_SUCCESS;
+  }
+
+  VOID
+  EFIAPI
+  TcpIoDestroySocket (
+    IN TCP_IO  *TcpIo
+    )
+  {
+  }
+
+  EFI_STATUS
+  EFIAPI
+  TcpIoConnect (
+    IN OUT TCP_IO     *TcpIo,
+    IN     EFI_EVENT  Timeout        OPTIONAL
+    )
+  {
+    return EFI_UNSUPPORTED;
+  }
+
+  VOID
+  EFIAPI
+  TcpIoReset (
+    IN OUT TCP_IO  *TcpIo
+    )
+  {
+    mWire.clear ();
+    mWireOffset = 0;
+  }
+
+  /**
+    The target receives the PDUs as soon as they are transmitted.
+  **/
+  EFI_STATUS
+  EFIAPI
+  TcpIoTransmit (
+    IN TCP_IO   *TcpIo,
+    IN NET_BUF  *Packet
+    )
+  {
+    std::vector<UINT8>  Buffer (Packet->TotalSize);
+    SCSI_COMMAND        *ScsiCmd;
+    TARGET_COMMAND      Command;
+
+    NetbufCopy (Packet, 0, Packet->TotalSize, Buffer.data ());
+    if (ISCSI_GET_OPCODE (Buffer.data ()) != ISCSI_OPCODE_SCSI_CMD) {
+      return EFI_SUCCESS;
+    }
+
+    ScsiCmd = (SCSI_COMMAND *)Buffer.data ();
+
+    Command.InitiatorTaskTag = NTOHL (ScsiCmd->InitiatorTaskTag);
+    Command.Length           = NTOHL (ScsiCmd->ExpDataXferLength);
+    Command.Lba              = NTOHL (*(UINT32 *)&ScsiCmd->Cdb[2]);
+
+    mTarget.ExpCmdSN       = NTOHL (ScsiCmd->CmdSN) + 1;
+    mTarget.Received++;
+    mTarget.MaxOutstanding = MAX (mTarget.MaxOutstanding, mTarget.Received - mWireChunksRead);
+
+    if (mTarget.Silent || (mTarget.ReverseBatch != 0)) {
+      mTarget.Held.insert (mTarget.Held.begin (), Command);
+      if (mTarget.Held.size () == mTarget.ReverseBatch) {
+        TargetRespondHeld ();
+      }
+    } else {
+      TargetRespond (Command);
+    }
+
+    return EFI_SUCCESS;
+  }
+
+  /**
+    Wait for the data like the real TcpIoReceive(), by moving the clock to the
+    time it arrives.
+  **/
+  EFI_STATUS
+  EFIAPI
+  TcpIoReceive (
+    IN OUT TCP_IO     *TcpIo,
+    IN     NET_BUF    *Packet,
+    IN     BOOLEAN    AsyncMode,
+    IN     EFI_EVENT  Timeout       OPTIONAL
+    )
+  {
+    FAKE_EVENT                 *TimeoutEvent;
+    std::vector<NET_FRAGMENT>  Fragments (Packet->BlockOpNum);
+    UINT32                     FragmentCount;
+    UINT32                     Index;
+    UINT64                     Next;
+
+    mReceiveCalls++;
+    TimeoutEvent = (FAKE_EVENT *)Timeout;
+
+    while (WireReadyBytes () < Packet->TotalSize) {
+      if (mWire.empty () || (mWire.back ().ReadyAt <= mNow)) {
+        //
+        // Nothing more is on the way, the real function polls until the timeout.
+        //
+        if ((TimeoutEvent == NULL) || (TimeoutEvent->TimerType == TimerCancel)) {
+          mReceiveHung = TRUE;
+        } else {
+          mNow = MAX (mNow, TimeoutEvent->TriggerTime);
+        }
+
+        return EFI_TIMEOUT;
+      }
+
+      Next = mNow;
+      for (const WIRE_CHUNK &Chunk : mWire) {
+        if (Chunk.ReadyAt > mNow) {
+          Next = Chunk.ReadyAt;
+          break;
+        }
+      }
+
+      if ((TimeoutEvent != NULL) && (TimeoutEvent->TimerType != TimerCancel) && (TimeoutEvent->TriggerTime < Next)) {
+        mNow = TimeoutEvent->TriggerTime;
+        return EFI_TIMEOUT;
+      }
+
+      mNow = Next;
+    }
+
+    FragmentCount = (UINT32)Fragments.size ();
+    NetbufBuildExt (Packet, Fragments.data (), &FragmentCount);
+    for (Index = 0; Index < FragmentCount; Index++) {
+      WireRead (Fragments[Index].Bulk, Fragments[Index].Len);
+    }
+
+    return EFI_SUCCESS;
+  }
+
+  EFI_STATUS
+  IScsiAsciiStrToIp (
+    IN  CHAR8           *Str,
+    IN  UINT8           IpMode,
+    OUT EFI_IP_ADDRESS  *Ip
+    )
+  {
+    return EFI_UNSUPPORTED;
+  }
+
+  UINTN
+  IScsiNetNtoi (
+    IN     CHAR8  *Str
+    )
+  {
+    return 0;
+  }
+
+  EFI_STATUS
+  IScsiCHAPOnRspReceived (
+    IN ISCSI_CONNECTION  *Conn
+    )
+  {
+    return EFI_UNSUPPORTED;
+  }
+
+  EFI_STATUS
+  IScsiCHAPToSendReq (
+    IN      ISCSI_CONNECTION  *Conn,
+    IN OUT  NET_BUF           *Pdu
+    )
+  {
+    return EFI_UNSUPPORTED;
+  }
+
+  EFI_STATUS
+  IScsiDns4 (
+    IN     EFI_HANDLE                   Image,
+    IN     EFI_HANDLE                   Controller,
+    IN OUT ISCSI_SESSION_CONFIG_NVDATA  *NvData
+    )
+  {
+    return EFI_UNSUPPORTED;
+  }
+
+  EFI_STATUS
+  IScsiDns6 (
+    IN     EFI_HANDLE                   Image,
+    IN     EFI_HANDLE                   Controller,
+    IN OUT ISCSI_SESSION_CONFIG_NVDATA  *NvData
+    )
+  {
+    return EFI_UNSUPPORTED;
+  }
+}
+
+////////////////////////////////////////////////////////////////////////
+// IScsiPipelineTest Tests
+////////////////////////////////////////////////////////////////////////
+
+//
+// A READ(10) request, and the event signaled when it completes.
+//
+class ReadRequest {
+public:
+  EFI_EXT_SCSI_PASS_THRU_SCSI_REQUEST_PACKET  Packet;
+  UINT8                                       Cdb[16];
+  std::vector<UINT8>                          Data;
+  UINT32                                      Lba;
+  EFI_EVENT                                   Event;
+  BOOLEAN                                     Done;
+
+  ReadRequest (
+    UINT32  StartLba,
+    UINT16  Blocks,
+    UINT64  Timeout
+    ) : Data (Blocks * TEST_BLOCK_SIZE, 0), Lba (StartLba), Event (NULL), Done (FALSE)
+  {
+    ZeroMem (&Packet, sizeof (Packet));
+    ZeroMem (Cdb, sizeof (Cdb));
+
+    Cdb[0] = 0x28;
+    Cdb[2] = (UINT8)(Lba >> 24);
+    Cdb[3] = (UINT8)(Lba >> 16);
+    Cdb[4] = (UINT8)(Lba >> 8);
+    Cdb[5] = (UINT8)Lba;
+    Cdb[7] = (UINT8)(Blocks >> 8);
+    Cdb[8] = (UINT8)Blocks;
+
+    Packet.Timeout          = Timeout;
+    Packet.InDataBuffer     = Data.data ();
+    Packet.InTransferLength = (UINT32)Data.size ();
+    Packet.Cdb              = Cdb;
+    Packet.CdbLength        = 10;
+    Packet.DataDirection    = EFI_EXT_SCSI_DATA_DIRECTION_READ;
+  }
+
+  BOOLEAN
+  DataIsCorrect (
+    VOID
+    )
+  {
+    UINT32  Offset;
+
+    for (Offset = 0; Offset < Data.size (); Offset++) {
+      if (Data[Offset] != BlockByte (Lba, Offset)) {
+        return FALSE;
+      }
+    }
+
+    return TRUE;
+  }
+
+  BOOLEAN
+  DataIsUntouched (
+    VOID
+    )
+  {
+    for (UINT8 Byte : Data) {
+      if (Byte != 0) {
+        return FALSE;
+      }
+    }
+
+    return TRUE;
+  }
+};
+
+static VOID
+EFIAPI
+OnReadDone (
+  IN EFI_EVENT  Event,
+  IN VOID       *Context
+  )
+{
+  ((ReadRequest *)Context)->Done = TRUE;
+  mTarget.Completed++;
+}
+
+class IScsiPipelineTest : public ::testing::Test {
+protected:
+  EFI_BOOT_SERVICES                *SavedBs;
+  EFI_BOOT_SERVICES                FakeBs;
+  ISCSI_DRIVER_DATA                *Private;
+  ISCSI_SESSION                    *Session;
+  EFI_EXT_SCSI_PASS_THRU_PROTOCOL  *PassThru;
+  UINT8                            Target[TARGET_MAX_BYTES];
+  std::vector<ReadRequest *>       Requests;
+
+  void
+  SetUp (
+    ) override
+  {
+    mWire.clear ();
+    mNow            = 0;
+    mWireOffset     = 0;
+    mWireChunksRead = 0;
+    mPendingRx      = NULL;
+    mReceiveCalls   = 0;
+    mReceiveHung    = FALSE;
+    mTarget         = TARGET ();
+
+    ZeroMem (&mFakeTcp4, sizeof (mFakeTcp4));
+    mFakeTcp4.Receive = FakeTcp4Receive;
+    mFakeTcp4.Poll    = FakeTcp4Poll;
+    mFakeTcp4.Cancel  = FakeTcp4Cancel;
+
+    ZeroMem (&FakeBs, sizeof (FakeBs));
+    FakeBs.RaiseTPL      = FakeRaiseTpl;
+    FakeBs.RestoreTPL    = FakeRestoreTpl;
+    FakeBs.FreePool      = FakeFreePool;
+    FakeBs.CreateEvent   = FakeCreateEvent;
+    FakeBs.CloseEvent    = FakeCloseEvent;
+    FakeBs.SetTimer      = FakeSetTimer;
+    FakeBs.SignalEvent   = FakeSignalEvent;
+    FakeBs.CheckEvent    = FakeCheckEvent;
+    FakeBs.CloseProtocol = FakeCloseProtocol;
+
+    SavedBs = gBS;
+    gBS     = &FakeBs;
+
+    Private            = (ISCSI_DRIVER_DATA *)AllocateZeroPool (sizeof (ISCSI_DRIVER_DATA));
+    Private->Signature = ISCSI_DRIVER_DATA_SIGNATURE;
+    CopyMem (&Private->IScsiExtScsiPassThru, &gIScsiExtScsiPassThruProtocolTemplate, sizeof (EFI_EXT_SCSI_PASS_THRU_PROTOCOL));
+    PassThru = &Private->IScsiExtScsiPassThru;
+
+    Session             = (ISCSI_SESSION *)AllocateZeroPool (sizeof (ISCSI_SESSION));
+    Session->Private    = Private;
+    Session->ConfigData = (ISCSI_ATTEMPT_CONFIG_NVDATA *)AllocateZeroPool (sizeof (ISCSI_ATTEMPT_CONFIG_NVDATA));
+    Private->Session    = Session;
+
+    ZeroMem (Target, sizeof (Target));
+
+    IScsiSessionInit (Session, FALSE);
+    LogIn ();
+  }
+
+  void
+  TearDown (
+    ) override
+  {
+    //
+    // Fail the commands left outstanding before their events are closed.
+    //
+    Private->InPassThru = FALSE;
+    IScsiSessionAbort (Session);
+
+    for (ReadRequest *Request : Requests) {
+      if (Request->Event != NULL) {
+        gBS->CloseEvent (Request->Event);
+      }
+
+      delete Request;
+    }
+
+    EXPECT_TRUE (mEvents.empty ());
+    for (FAKE_EVENT *FakeEvent : mEvents) {
+      delete FakeEvent;
+    }
+
+    mEvents.clear ();
+
+    FreePool (Session->ConfigData);
+    FreePool (Session);
+    FreePool (Private);
+
+    gBS = SavedBs;
+  }
+
+  //
+  // Stand in for the login: one connection in full feature phase, and a new
+  // connection on the target side.
+  //
+  void
+  LogIn (
+    VOID
+    )
+  {
+    ISCSI_CONNECTION  *Conn;
+
+    Conn = IScsiCreateConnection (Session);
+    ASSERT_NE (Conn, nullptr);
+
+    Conn->State     = CONN_STATE_LOGGED_IN;
+    Conn->ExpStatSN = 1;
+    IScsiAttatchConnection (Session, Conn);
+
+    Session->State    = SESSION_STATE_LOGGED_IN;
+    Session->ExpCmdSN = 1;
+    Session->MaxCmdSN = TEST_CMD_WINDOW;
+
+    mTarget.StatSN     = 1;
+    mTarget.ExpCmdSN   = 1;
+    mTarget.Done       = 0;
+    mTarget.LinkFreeAt = mNow;
+  }
+
+  ReadRequest *
+  NewRead (
+    UINT32   Lba,
+    UINT16   Blocks,
+    UINT64   Timeout,
+    BOOLEAN  NonBlocking
+    )
+  {
+    ReadRequest  *Request;
+
+    Request = new ReadRequest (Lba, Blocks, Timeout);
+    if (NonBlocking) {
+      FakeCreateEvent (EVT_NOTIFY_SIGNAL, TPL_CALLBACK, OnReadDone, Request, &Request->Event);
+    }
+
+    Requests.push_back (Request);
+    return Request;
+  }
+};
+
+//
+// Keeping several reads outstanding overlaps their round trips.
+//
+TEST_F (IScsiPipelineTest, PipelinedReadsOverlapRoundTrips) {
+  const UINT32  Count  = 64;
+  const UINT16  Blocks = 16;
+  ReadRequest   *Request;
+  UINT64        Start;
+  UINT64        BlockingTicks;
+  UINT64        PipelinedTicks;
+  UINT32        Index;
+  UINT32        Submitted;
+  UINT32        Timers;
+
+  Start = mNow;
+  for (Index = 0; Index < Count; Index++) {
+    Request = NewRead (Index * Blocks, Blocks, 0, FALSE);
+    ASSERT_EQ (PassThru->PassThru (PassThru, Target, 0, &Request->Packet, NULL), EFI_SUCCESS);
+    ASSERT_TRUE (Request->DataIsCorrect ());
+  }
+
+  BlockingTicks = mNow - Start;
+  EXPECT_EQ (mTarget.MaxOutstanding, 1U);
+
+  mTarget.MaxOutstanding = 0;
+
+  Start     = mNow;
+  Submitted = 0;
+  for (Index = 0; Index < Count; Index++) {
+    Request = NewRead ((Count + Index) * Blocks, Blocks, 0, TRUE);
+    ASSERT_EQ (PassThru->PassThru (PassThru, Target, 0, &Request->Packet, Request->Event), EFI_SUCCESS);
+    Submitted++;
+  }
+
+  for (Timers = 0; (mTarget.Completed < Submitted) && (Timers < 100); Timers++) {
+    ASSERT_TRUE (FireNextTimer ());
+  }
+
+  PipelinedTicks = mNow - Start;
+
+  ASSERT_EQ (mTarget.Completed, Count);
+  for (Index = Count; Index < 2 * Count; Index++) {
+    EXPECT_TRUE (Requests[Index]->DataIsCorrect ());
+    EXPECT_EQ (Requests[Index]->Packet.HostAdapterStatus, EFI_EXT_SCSI_STATUS_HOST_ADAPTER_OK);
+  }
+
+  EXPECT_EQ (mTarget.MaxOutstanding, (UINT32)TEST_CMD_WINDOW);
+  EXPECT_FALSE (mReceiveHung);
+  EXPECT_LT (PipelinedTicks, BlockingTicks);
+
+  //
+  // The poll timer stops once nothing is outstanding.
+  //
+  EXPECT_FALSE (FireNextTimer ());
+
+  std::cout << "[          ] " << Count << " reads of " << Blocks * TEST_BLOCK_SIZE / 1024 << " KiB, "
+            << "RTT " << TEST_RTT / TICKS_PER_MS << " ms, window " << TEST_CMD_WINDOW << ": "
+            << "blocking " << BlockingTicks / 10 << " us, "
+            << "nonblocking " << PipelinedTicks / 10 << " us" << std::endl;
+}
+
+//
+// The data of each read goes to its own buffer, whatever the order of the responses.
+//
+TEST_F (IScsiPipelineTest, ResponsesOutOfOrderAreMatchedByTaskTag) {
+  const UINT32  Count = 4;
+  ReadRequest   *Request;
+  UINT32        Index;
+
+  mTarget.ReverseBatch = Count;
+
+  for (Index = 0; Index < Count; Index++) {
+    Request = NewRead (1000 * (Index + 1), 8, 0, TRUE);
+    ASSERT_EQ (PassThru->PassThru (PassThru, Target, 0, &Request->Packet, Request->Event), EFI_SUCCESS);
+  }
+
+  while (mTarget.Completed < Count) {
+    ASSERT_TRUE (FireNextTimer ());
+  }
+
+  for (Index = 0; Index < Count; Index++) {
+    EXPECT_TRUE (Requests[Index]->Done);
+    EXPECT_TRUE (Requests[Index]->DataIsCorrect ());
+  }
+}
+
+//
+// The poll timer only takes the PDUs already received, it never waits for a
+// target that does not answer, even for a command without a timeout.
+//
+TEST_F (IScsiPipelineTest, PollTimerDoesNotWaitForTarget) {
+  ReadRequest  *Request;
+  UINT64       Start;
+  UINT32       Index;
+
+  mTarget.Silent = TRUE;
+
+  Request = NewRead (7, 8, 0, TRUE);
+  ASSERT_EQ (PassThru->PassThru (PassThru, Target, 0, &Request->Packet, Request->Event), EFI_SUCCESS);
+
+  Start = mNow;
+  for (Index = 0; Index < 5; Index++) {
+    ASSERT_TRUE (FireNextTimer ());
+  }
+
+  EXPECT_EQ (mNow - Start, 5 * ISCSI_POLL_INTERVAL);
+  EXPECT_EQ (mReceiveCalls, 0U);
+  EXPECT_FALSE (mReceiveHung);
+  EXPECT_FALSE (Request->Done);
+  EXPECT_TRUE (Request->DataIsUntouched ());
+
+  //
+  // The answer is taken by the next timer after it arrives.
+  //
+  mTarget.Silent = FALSE;
+  TargetRespondHeld ();
+
+  while (!Request->Done) {
+    ASSERT_TRUE (FireNextTimer ());
+  }
+
+  EXPECT_TRUE (Request->DataIsCorrect ());
+  EXPECT_LE (mNow - Start, 5 * ISCSI_POLL_INTERVAL + TEST_RTT + ISCSI_POLL_INTERVAL);
+  EXPECT_FALSE (mReceiveHung);
+  EXPECT_FALSE (FireNextTimer ());
+}
+
+//
+// A session reinstated inside the pass thru function reuses the initiator task
+// tags of the commands it failed, whose events are signaled on its return.
+//
+TEST_F (IScsiPipelineTest, AbortedCommandsDoNotTakeNewResponses) {
+  ReadRequest  *Failed[2];
+  ReadRequest  *Request;
+
+  mTarget.Silent = TRUE;
+
+  Failed[0] = NewRead (10, 8, 0, TRUE);
+  Failed[1] = NewRead (20, 8, 0, TRUE);
+  ASSERT_EQ (PassThru->PassThru (PassThru, Target, 0, &Failed[0]->Packet, Failed[0]->Event), EFI_SUCCESS);
+  ASSERT_EQ (PassThru->PassThru (PassThru, Target, 0, &Failed[1]->Packet, Failed[1]->Event), EFI_SUCCESS);
+
+  Private->InPassThru = TRUE;
+
+  IScsiSessionAbort (Session);
+  IScsiSessionInit (Session, TRUE);
+
+  mTarget.Silent = FALSE;
+  mTarget.Held.clear ();
+  LogIn ();
+
+  Request = NewRead (30, 8, 0, FALSE);
+  ASSERT_EQ (IScsiExecuteScsiCommand (PassThru, Target, 0, &Request->Packet, NULL), EFI_SUCCESS);
+  EXPECT_TRUE (Request->DataIsCorrect ());
+
+  EXPECT_FALSE (Failed[0]->Done);
+  EXPECT_FALSE (Failed[1]->Done);
+
+  Private->InPassThru = FALSE;
+  IScsiSignalScsiCommands (Session);
+
+  for (ReadRequest *Aborted : Failed) {
+    EXPECT_TRUE (Aborted->Done);
+    EXPECT_TRUE (Aborted->DataIsUntouched ());
+    EXPECT_EQ (Aborted->Packet.HostAdapterStatus, EFI_EXT_SCSI_STATUS_HOST_ADAPTER_OTHER);
+  }
+}
@@ -90,19 +90,35 @@ IScsiExtScsiPassThruFunction (
     return EFI_INVALID_PARAMETER;
   }
 
-  Status = IScsiExecuteScsiCommand (This, Target, Lun, Packet);
+  Private = ISCSI_DRIVER_DATA_FROM_EXT_SCSI_PASS_THRU (This);
+  if (Private->InPassThru) {
+    //
+    // The session is in use by the pass thru function or its poll timer.
+    //
+    return EFI_NOT_READY;
+  }
+
+  Private->InPassThru = TRUE;
+
+  Status = IScsiExecuteScsiCommand (This, Target, Lun, Packet, Event);
   if ((Status != EFI_SUCCESS) && (Status != EFI_NOT_READY)) {
     //
     // Try to reinstate the session and re-execute the Scsi command.
     //
-    Private = ISCSI_DRIVER_DATA_FROM_EXT_SCSI_PASS_THRU (This);
     if (EFI_ERROR (IScsiSessionReinstatement (Private->Session))) {
-      return EFI_DEVICE_ERROR;
+      Status = EFI_DEVICE_ERROR;
+    } else {
+      Status = IScsiExecuteScsiCommand (This, Target, Lun, Packet, Event);
     }
-
-    Status = IScsiExecuteScsiCommand (This, Target, Lun, Packet);
   }
 
+  Private->InPassThru = FALSE;
+
+  //
+  // Signal the nonblocking commands completed while this command was executed.
+  //
+  IScsiSignalScsiCommands (Private->Session);
+
   return Status;
 }
 
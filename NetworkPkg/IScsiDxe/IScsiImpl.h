@@ -106,6 +106,7 @@ struct _ISCSI_SESSION {
   UINT32                         NumConns;
 
   LIST_ENTRY                     TcbList;
+  LIST_ENTRY                     CompletedTcbList;
 
   //
   // Session-wide parameters
@@ -131,6 +132,7 @@ struct _ISCSI_CONNECTION {
   LIST_ENTRY           Link;
 
   EFI_EVENT            TimeoutEvent;
+  EFI_EVENT            PollEvent;
 
   ISCSI_SESSION        *Session;
 
@@ -157,6 +159,12 @@ struct _ISCSI_CONNECTION {
   BOOLEAN              Ipv6Flag;
   TCP_IO               TcpIo;
 
+  //
+  // The first byte of the next PDU, received by IScsiPollConnection().
+  //
+  BOOLEAN              RxFirstByteValid;
+  UINT8                RxFirstByte;
+
   //
   // Connection-only parameters.
   //
@@ -197,6 +205,7 @@ struct _ISCSI_DRIVER_DATA {
   EFI_DEVICE_PATH_PROTOCOL           *DevicePath;
   EFI_HANDLE                         ChildHandle;
   ISCSI_SESSION                      *Session;
+  BOOLEAN                            InPassThru;
 };
 
 #endif
@@ -235,6 +235,19 @@ IScsiCreateConnection (
     return NULL;
   }
 
+  Status = gBS->CreateEvent (
+                  EVT_TIMER | EVT_NOTIFY_SIGNAL,
+                  TPL_CALLBACK,
+                  IScsiOnPollTimer,
+                  Conn,
+                  &Conn->PollEvent
+                  );
+  if (EFI_ERROR (Status)) {
+    gBS->CloseEvent (Conn->TimeoutEvent);
+    FreePool (Conn);
+    return NULL;
+  }
+
   NetbufQueInit (&Conn->RspQue);
 
   //
@@ -256,6 +269,8 @@ IScsiCreateConnection (
 
     if (EFI_ERROR (Status)) {
       DEBUG ((DEBUG_ERROR, "The configuration of Target address or DNS server address is invalid!\n"));
+      gBS->CloseEvent (Conn->PollEvent);
+      gBS->CloseEvent (Conn->TimeoutEvent);
       FreePool (Conn);
       return NULL;
     }
@@ -292,6 +307,7 @@ IScsiCreateConnection (
              &Conn->TcpIo
              );
   if (EFI_ERROR (Status)) {
+    gBS->CloseEvent (Conn->PollEvent);
     gBS->CloseEvent (Conn->TimeoutEvent);
     FreePool (Conn);
     Conn = NULL;
@@ -314,6 +330,7 @@ IScsiDestroyConnection (
   TcpIoDestroySocket (&Conn->TcpIo);
 
   NetbufQueFlush (&Conn->RspQue);
+  gBS->CloseEvent (Conn->PollEvent);
   gBS->CloseEvent (Conn->TimeoutEvent);
   FreePool (Conn);
 }
@@ -1283,6 +1300,95 @@ IScsiNbufExtFree (
 {
 }
 
+/**
+  Check whether the target has started to send a PDU on the connection, without
+  waiting for it. If it has, the first byte of the PDU is received and kept in the
+  connection, and IScsiReceivePdu() receives the rest of the PDU.
+
+  @param[in, out]  Conn          The iSCSI connection.
+
+  @retval EFI_SUCCESS            The target has started to send a PDU.
+  @retval EFI_NOT_READY          No data is available on the connection.
+  @retval EFI_OUT_OF_RESOURCES   Failed to allocate memory.
+  @retval Others                 Other errors as indicated.
+
+**/
+EFI_STATUS
+IScsiPollConnection (
+  IN OUT ISCSI_CONNECTION  *Conn
+  )
+{
+  TCP_IO                 *TcpIo;
+  TCP_IO_IO_TOKEN        RxToken;
+  EFI_TCP4_RECEIVE_DATA  RxData;
+  EFI_EVENT              Event;
+  EFI_STATUS             Status;
+
+  if (Conn->RxFirstByteValid) {
+    return EFI_SUCCESS;
+  }
+
+  TcpIo = &Conn->TcpIo;
+
+  //
+  // The token is checked right after the TCP instance is polled, so the event
+  // needs no notification function.
+  //
+  Status = gBS->CreateEvent (0, TPL_CALLBACK, NULL, NULL, &Event);
+  if (EFI_ERROR (Status)) {
+    return Status;
+  }
+
+  ZeroMem (&RxData, sizeof (RxData));
+  RxData.DataLength                      = 1;
+  RxData.FragmentCount                   = 1;
+  RxData.FragmentTable[0].FragmentLength = 1;
+  RxData.FragmentTable[0].FragmentBuffer = &Conn->RxFirstByte;
+
+  ZeroMem (&RxToken, sizeof (RxToken));
+  RxToken.Tcp4Token.CompletionToken.Event  = Event;
+  RxToken.Tcp4Token.CompletionToken.Status = EFI_NOT_READY;
+  RxToken.Tcp4Token.Packet.RxData          = &RxData;
+
+  //
+  // Take the byte if it is already received, cancel the request otherwise.
+  // Cancelling a pending request discards no data.
+  //
+  if (TcpIo->TcpVersion == TCP_VERSION_4) {
+    Status = TcpIo->Tcp.Tcp4->Receive (TcpIo->Tcp.Tcp4, &RxToken.Tcp4Token);
+    if (!EFI_ERROR (Status)) {
+      TcpIo->Tcp.Tcp4->Poll (TcpIo->Tcp.Tcp4);
+      if (EFI_ERROR (gBS->CheckEvent (Event))) {
+        TcpIo->Tcp.Tcp4->Cancel (TcpIo->Tcp.Tcp4, &RxToken.Tcp4Token.CompletionToken);
+      }
+    }
+  } else {
+    Status = TcpIo->Tcp.Tcp6->Receive (TcpIo->Tcp.Tcp6, &RxToken.Tcp6Token);
+    if (!EFI_ERROR (Status)) {
+      TcpIo->Tcp.Tcp6->Poll (TcpIo->Tcp.Tcp6);
+      if (EFI_ERROR (gBS->CheckEvent (Event))) {
+        TcpIo->Tcp.Tcp6->Cancel (TcpIo->Tcp.Tcp6, &RxToken.Tcp6Token.CompletionToken);
+      }
+    }
+  }
+
+  if (!EFI_ERROR (Status)) {
+    Status = RxToken.Tcp4Token.CompletionToken.Status;
+  }
+
+  gBS->CloseEvent (Event);
+
+  if (Status == EFI_ABORTED) {
+    return EFI_NOT_READY;
+  }
+
+  if (!EFI_ERROR (Status)) {
+    Conn->RxFirstByteValid = TRUE;
+  }
+
+  return Status;
+}
+
 /**
   Receive an iSCSI response PDU. An iSCSI response PDU contains an iSCSI PDU header and
   an optional data segment. The two parts will be put into two blocks of buffers in the
@@ -1293,6 +1399,8 @@ IScsiNbufExtFree (
   @param[out] Pdu          The received iSCSI pdu.
   @param[in]  Context      The context used to describe information on the caller provided
                            buffer to receive data segment of the iSCSI pdu. It is optional.
+                           If it is NULL, the data segment of an iSCSI SCSI Data In pdu is
+                           received into the buffer of the task the pdu belongs to.
   @param[in]  HeaderDigest Whether there will be header digest received.
   @param[in]  DataDigest   Whether there will be data digest.
   @param[in]  TimeoutEvent The timeout event. It is optional.
@@ -1324,6 +1432,7 @@ IScsiReceivePdu (
   UINT32        FragmentCount;
   NET_BUF       *DataSeg;
   UINT32        PadAndCRC32[2];
+  ISCSI_TCB     *Tcb;
 
   NbufList = AllocatePool (sizeof (LIST_ENTRY));
   if (NbufList == NULL) {
@@ -1351,9 +1460,27 @@ IScsiReceivePdu (
   InsertTailList (NbufList, &PduHdr->List);
 
   //
-  // First step, receive the BHS of the PDU.
+  // First step, receive the BHS of the PDU. Its first byte may have been
+  // received by IScsiPollConnection().
   //
-  Status = TcpIoReceive (&Conn->TcpIo, PduHdr, FALSE, TimeoutEvent);
+  if (Conn->RxFirstByteValid) {
+    Conn->RxFirstByteValid = FALSE;
+    Header[0]              = Conn->RxFirstByte;
+
+    Fragment[0].Len  = Len - 1;
+    Fragment[0].Bulk = Header + 1;
+
+    DataSeg = NetbufFromExt (&Fragment[0], 1, 0, 0, IScsiNbufExtFree, NULL);
+    if (DataSeg == NULL) {
+      Status = EFI_OUT_OF_RESOURCES;
+      goto ON_EXIT;
+    }
+
+    Status = TcpIoReceive (&Conn->TcpIo, DataSeg, FALSE, TimeoutEvent);
+    NetbufFree (DataSeg);
+  } else {
+    Status = TcpIoReceive (&Conn->TcpIo, PduHdr, FALSE, TimeoutEvent);
+  }
 
   if (EFI_ERROR (Status)) {
     goto ON_EXIT;
@@ -1389,6 +1516,17 @@ IScsiReceivePdu (
       // if the PDU is an iSCSI SCSI data.
       //
       InDataOffset = ISCSI_GET_BUFFER_OFFSET (Header);
+      if ((Context == NULL) && (Conn->Session != NULL)) {
+        //
+        // Several SCSI commands may be outstanding, receive the data into the
+        // buffer of the one identified by the initiator task tag.
+        //
+        Tcb = IScsiFindTcb (Conn->Session, NTOHL (((ISCSI_BASIC_HEADER *)Header)->InitiatorTaskTag));
+        if (Tcb != NULL) {
+          Context = &Tcb->InBufferContext;
+        }
+      }
+
       if ((Context == NULL) || ((InDataOffset + Len) > Context->InDataLen)) {
         Status = EFI_PROTOCOL_ERROR;
         goto ON_EXIT;
@@ -2112,6 +2250,60 @@ IScsiDelTcb (
   FreePool (Tcb);
 }
 
+/**
+  Find the task control block of the outstanding SCSI command by its initiator task tag.
+
+  @param[in]  Session          The iSCSI session.
+  @param[in]  InitiatorTaskTag The initiator task tag in host byte order.
+
+  @return The task control block, or NULL if no such task is outstanding.
+
+**/
+ISCSI_TCB *
+IScsiFindTcb (
+  IN ISCSI_SESSION  *Session,
+  IN UINT32         InitiatorTaskTag
+  )
+{
+  LIST_ENTRY  *Entry;
+  ISCSI_TCB   *Tcb;
+
+  NET_LIST_FOR_EACH (Entry, &Session->TcbList) {
+    Tcb = NET_LIST_USER_STRUCT (Entry, ISCSI_TCB, Link);
+    if ((Tcb->InitiatorTaskTag == InitiatorTaskTag) && !Tcb->StatusXferd) {
+      return Tcb;
+    }
+  }
+
+  return NULL;
+}
+
+/**
+  Get the oldest nonblocking SCSI command that has not completed.
+
+  @param[in]  Session  The iSCSI session.
+
+  @return The task control block, or NULL if no nonblocking command is outstanding.
+
+**/
+ISCSI_TCB *
+IScsiGetPendingTcb (
+  IN ISCSI_SESSION  *Session
+  )
+{
+  LIST_ENTRY  *Entry;
+  ISCSI_TCB   *Tcb;
+
+  NET_LIST_FOR_EACH (Entry, &Session->TcbList) {
+    Tcb = NET_LIST_USER_STRUCT (Entry, ISCSI_TCB, Link);
+    if ((Tcb->Event != NULL) && !Tcb->StatusXferd) {
+      return Tcb;
+    }
+  }
+
+  return NULL;
+}
+
 /**
   Create a data segment, pad it, and calculate the CRC if needed.
 
@@ -2882,6 +3074,174 @@ IScsiOnNopInRcvd (
   return EFI_SUCCESS;
 }
 
+/**
+  Receive and process the PDUs of the outstanding SCSI commands on the connection.
+
+  The PDUs are dispatched to the commands by their initiator task tags, so that
+  several commands may be outstanding on the connection. The nonblocking commands
+  that complete are left in the task list of the session, for
+  IScsiSignalScsiCommands() to signal their events.
+
+  @param[in]  Conn    The iSCSI connection.
+  @param[in]  Tcb     The task control block of the blocking command to wait for. If it
+                      is NULL, wait until all the nonblocking commands complete.
+  @param[in]  NoWait  If TRUE, only the PDUs the target has started to send are
+                      received, and the function returns once no more data is
+                      available on the connection.
+
+  @retval EFI_SUCCESS          The commands waited for are completed, or no more PDU is
+                               available if NoWait is TRUE.
+  @retval EFI_BAD_BUFFER_SIZE  The buffer of Tcb was not the proper size for the request.
+  @retval EFI_PROTOCOL_ERROR   Some kind of iSCSI protocol error occurred.
+  @retval Others               Other errors as indicated.
+
+**/
+EFI_STATUS
+IScsiWaitScsiCommands (
+  IN ISCSI_CONNECTION  *Conn,
+  IN ISCSI_TCB         *Tcb     OPTIONAL,
+  IN BOOLEAN           NoWait
+  )
+{
+  EFI_STATUS     Status;
+  ISCSI_SESSION  *Session;
+  ISCSI_TCB      *WaitTcb;
+  ISCSI_TCB      *PduTcb;
+  EFI_EVENT      TimeoutEvent;
+  NET_BUF        *Pdu;
+  UINT8          *PduHdr;
+
+  Session = Conn->Session;
+  Status  = EFI_SUCCESS;
+
+  while (TRUE) {
+    WaitTcb = (Tcb != NULL) ? Tcb : IScsiGetPendingTcb (Session);
+    if ((WaitTcb == NULL) || WaitTcb->StatusXferd) {
+      break;
+    }
+
+    if (NoWait) {
+      Status = IScsiPollConnection (Conn);
+      if (Status == EFI_NOT_READY) {
+        Status = EFI_SUCCESS;
+        break;
+      }
+
+      if (EFI_ERROR (Status)) {
+        break;
+      }
+    }
+
+    //
+    // Start the timeout timer.
+    //
+    TimeoutEvent = NULL;
+    if (WaitTcb->Packet->Timeout != 0) {
+      Status = gBS->SetTimer (Conn->TimeoutEvent, TimerRelative, MultU64x32 (WaitTcb->Packet->Timeout, 4));
+      if (EFI_ERROR (Status)) {
+        break;
+      }
+
+      TimeoutEvent = Conn->TimeoutEvent;
+    }
+
+    //
+    // Try to receive PDU from target.
+    //
+    Status = IScsiReceivePdu (Conn, &Pdu, NULL, FALSE, FALSE, TimeoutEvent);
+
+    if (TimeoutEvent != NULL) {
+      gBS->SetTimer (TimeoutEvent, TimerCancel, 0);
+    }
+
+    if (EFI_ERROR (Status)) {
+      break;
+    }
+
+    PduHdr = NetbufGetByte (Pdu, 0, NULL);
+    if (PduHdr == NULL) {
+      Status = EFI_PROTOCOL_ERROR;
+      NetbufFree (Pdu);
+      break;
+    }
+
+    //
+    // Find the command the PDU belongs to.
+    //
+    PduTcb = WaitTcb;
+    switch (ISCSI_GET_OPCODE (PduHdr)) {
+      case ISCSI_OPCODE_SCSI_DATA_IN:
+      case ISCSI_OPCODE_R2T:
+      case ISCSI_OPCODE_SCSI_RSP:
+        PduTcb = IScsiFindTcb (Session, NTOHL (((ISCSI_BASIC_HEADER *)PduHdr)->InitiatorTaskTag));
+        break;
+
+      default:
+        break;
+    }
+
+    if (PduTcb == NULL) {
+      Status = EFI_PROTOCOL_ERROR;
+      NetbufFree (Pdu);
+      break;
+    }
+
+    switch (ISCSI_GET_OPCODE (PduHdr)) {
+      case ISCSI_OPCODE_SCSI_DATA_IN:
+        Status = IScsiOnDataInRcvd (Pdu, PduTcb, PduTcb->Packet);
+        break;
+
+      case ISCSI_OPCODE_R2T:
+        Status = IScsiOnR2TRcvd (Pdu, PduTcb, PduTcb->Lun, PduTcb->Packet);
+        break;
+
+      case ISCSI_OPCODE_SCSI_RSP:
+        Status = IScsiOnScsiRspRcvd (Pdu, PduTcb, PduTcb->Packet);
+        break;
+
+      case ISCSI_OPCODE_NOP_IN:
+        Status = IScsiOnNopInRcvd (Pdu, PduTcb);
+        break;
+
+      case ISCSI_OPCODE_VENDOR_T0:
+      case ISCSI_OPCODE_VENDOR_T1:
+      case ISCSI_OPCODE_VENDOR_T2:
+        //
+        // These messages are vendor specific. Skip them.
+        //
+        break;
+
+      default:
+        Status = EFI_PROTOCOL_ERROR;
+        break;
+    }
+
+    NetbufFree (Pdu);
+
+    if ((PduTcb != Tcb) && (Status == EFI_BAD_BUFFER_SIZE)) {
+      //
+      // The residual of a nonblocking command is reported in its packet.
+      //
+      Status = EFI_SUCCESS;
+    }
+
+    if ((PduTcb->Event != NULL) && PduTcb->StatusXferd && !EFI_ERROR (Status)) {
+      //
+      // Keep the completed nonblocking command for IScsiSignalScsiCommands(),
+      // its initiator task tag no longer identifies an outstanding task.
+      //
+      RemoveEntryList (&PduTcb->Link);
+      InsertTailList (&Session->CompletedTcbList, &PduTcb->Link);
+    }
+
+    if (EFI_ERROR (Status)) {
+      break;
+    }
+  }
+
+  return Status;
+}
+
 /**
   Execute the SCSI command issued through the EXT SCSI PASS THRU protocol.
 
@@ -2890,9 +3250,12 @@ IScsiOnNopInRcvd (
   @param[in]       Lun       The LUN.
   @param[in, out]  Packet    The request packet containing IO request, SCSI command
                              buffer and buffers to read/write.
+  @param[in]       Event     If it is not NULL, the command is sent without waiting for
+                             its response, and Event is signaled by IScsiSignalScsiCommands()
+                             when the command completes.
 
   @retval EFI_SUCCESS          The SCSI command is executed and the result is updated to
-                               the Packet.
+                               the Packet, or the nonblocking SCSI command is sent.
   @retval EFI_DEVICE_ERROR     Session state was not as required.
   @retval EFI_OUT_OF_RESOURCES Failed to allocate memory.
   @retval EFI_PROTOCOL_ERROR   There is no such data in the net buffer.
@@ -2905,28 +3268,24 @@ IScsiExecuteScsiCommand (
   IN EFI_EXT_SCSI_PASS_THRU_PROTOCOL                 *PassThru,
   IN UINT8                                           *Target,
   IN UINT64                                          Lun,
-  IN OUT EFI_EXT_SCSI_PASS_THRU_SCSI_REQUEST_PACKET  *Packet
+  IN OUT EFI_EXT_SCSI_PASS_THRU_SCSI_REQUEST_PACKET  *Packet,
+  IN EFI_EVENT                                       Event     OPTIONAL
   )
 {
-  EFI_STATUS               Status;
-  ISCSI_DRIVER_DATA        *Private;
-  ISCSI_SESSION            *Session;
-  EFI_EVENT                TimeoutEvent;
-  ISCSI_CONNECTION         *Conn;
-  ISCSI_TCB                *Tcb;
-  NET_BUF                  *Pdu;
-  ISCSI_XFER_CONTEXT       *XferContext;
-  UINT8                    *Data;
-  ISCSI_IN_BUFFER_CONTEXT  InBufferContext;
-  UINT64                   Timeout;
-  UINT8                    *PduHdr;
+  EFI_STATUS          Status;
+  ISCSI_DRIVER_DATA   *Private;
+  ISCSI_SESSION       *Session;
+  ISCSI_CONNECTION    *Conn;
+  ISCSI_TCB           *Tcb;
+  NET_BUF             *Pdu;
+  ISCSI_XFER_CONTEXT  *XferContext;
+  UINT8               *Data;
+  UINT8               *PduHdr;
 
-  Private      = ISCSI_DRIVER_DATA_FROM_EXT_SCSI_PASS_THRU (PassThru);
-  Session      = Private->Session;
-  Status       = EFI_SUCCESS;
-  Tcb          = NULL;
-  TimeoutEvent = NULL;
-  Timeout      = 0;
+  Private = ISCSI_DRIVER_DATA_FROM_EXT_SCSI_PASS_THRU (PassThru);
+  Session = Private->Session;
+  Status  = EFI_SUCCESS;
+  Tcb     = NULL;
 
   if (Session->State != SESSION_STATE_LOGGED_IN) {
     Status = EFI_DEVICE_ERROR;
@@ -2940,15 +3299,27 @@ IScsiExecuteScsiCommand (
            ISCSI_CONNECTION_SIGNATURE
            );
 
-  if (Packet->Timeout != 0) {
-    Timeout = MultU64x32 (Packet->Timeout, 4);
+  Status = IScsiNewTcb (Conn, &Tcb);
+  if ((Status == EFI_NOT_READY) && (IScsiGetPendingTcb (Session) != NULL)) {
+    //
+    // The command window is closed by the outstanding nonblocking commands,
+    // complete them to let the target open the window again.
+    //
+    Status = IScsiWaitScsiCommands (Conn, NULL, FALSE);
+    if (!EFI_ERROR (Status)) {
+      Status = IScsiNewTcb (Conn, &Tcb);
+    }
   }
 
-  Status = IScsiNewTcb (Conn, &Tcb);
   if (EFI_ERROR (Status)) {
     goto ON_EXIT;
   }
 
+  Tcb->Packet                    = Packet;
+  Tcb->Lun                       = Lun;
+  Tcb->InBufferContext.InData    = (UINT8 *)Packet->InDataBuffer;
+  Tcb->InBufferContext.InDataLen = Packet->InTransferLength;
+
   //
   // Encapsulate the SCSI request packet into an iSCSI SCSI Command PDU.
   //
@@ -3001,85 +3372,114 @@ IScsiExecuteScsiCommand (
     }
   }
 
-  InBufferContext.InData    = (UINT8 *)Packet->InDataBuffer;
-  InBufferContext.InDataLen = Packet->InTransferLength;
-
-  while (!Tcb->StatusXferd) {
+  if (Event != NULL) {
     //
-    // Start the timeout timer.
+    // Leave the command outstanding. Its PDUs are received by the poll timer
+    // of the connection, or by the blocking command executed next.
     //
-    if (Timeout != 0) {
-      Status = gBS->SetTimer (Conn->TimeoutEvent, TimerRelative, Timeout);
-      if (EFI_ERROR (Status)) {
-        goto ON_EXIT;
-      }
+    Tcb->Event = Event;
+    gBS->SetTimer (Conn->PollEvent, TimerPeriodic, ISCSI_POLL_INTERVAL);
+    return EFI_SUCCESS;
+  }
 
-      TimeoutEvent = Conn->TimeoutEvent;
-    }
+  Status = IScsiWaitScsiCommands (Conn, Tcb, FALSE);
 
-    //
-    // Try to receive PDU from target.
-    //
-    Status = IScsiReceivePdu (Conn, &Pdu, &InBufferContext, FALSE, FALSE, TimeoutEvent);
-    if (EFI_ERROR (Status)) {
-      goto ON_EXIT;
-    }
+ON_EXIT:
 
-    PduHdr = NetbufGetByte (Pdu, 0, NULL);
-    if (PduHdr == NULL) {
-      Status = EFI_PROTOCOL_ERROR;
-      NetbufFree (Pdu);
-      goto ON_EXIT;
-    }
+  if (Tcb != NULL) {
+    IScsiDelTcb (Tcb);
+  }
 
-    switch (ISCSI_GET_OPCODE (PduHdr)) {
-      case ISCSI_OPCODE_SCSI_DATA_IN:
-        Status = IScsiOnDataInRcvd (Pdu, Tcb, Packet);
-        break;
+  return Status;
+}
 
-      case ISCSI_OPCODE_R2T:
-        Status = IScsiOnR2TRcvd (Pdu, Tcb, Lun, Packet);
-        break;
+/**
+  Signal the events of the nonblocking SCSI commands that have completed, and
+  destroy their task control blocks.
 
-      case ISCSI_OPCODE_SCSI_RSP:
-        Status = IScsiOnScsiRspRcvd (Pdu, Tcb, Packet);
-        break;
+  @param[in]  Session  The iSCSI session.
 
-      case ISCSI_OPCODE_NOP_IN:
-        Status = IScsiOnNopInRcvd (Pdu, Tcb);
-        break;
+**/
+VOID
+IScsiSignalScsiCommands (
+  IN ISCSI_SESSION  *Session
+  )
+{
+  LIST_ENTRY  CompletedList;
+  ISCSI_TCB   *Tcb;
+  EFI_EVENT   Event;
 
-      case ISCSI_OPCODE_VENDOR_T0:
-      case ISCSI_OPCODE_VENDOR_T1:
-      case ISCSI_OPCODE_VENDOR_T2:
-        //
-        // These messages are vendor specific. Skip them.
-        //
-        break;
+  //
+  // Take the completed commands off the session first, the notify functions
+  // of the events may issue new commands to the session.
+  //
+  InitializeListHead (&CompletedList);
 
-      default:
-        Status = EFI_PROTOCOL_ERROR;
-        break;
-    }
+  while (!IsListEmpty (&Session->CompletedTcbList)) {
+    Tcb = NET_LIST_HEAD (&Session->CompletedTcbList, ISCSI_TCB, Link);
+    RemoveEntryList (&Tcb->Link);
+    InsertTailList (&CompletedList, &Tcb->Link);
+  }
 
-    NetbufFree (Pdu);
+  while (!IsListEmpty (&CompletedList)) {
+    Tcb   = NET_LIST_HEAD (&CompletedList, ISCSI_TCB, Link);
+    Event = Tcb->Event;
 
-    if (EFI_ERROR (Status)) {
-      break;
-    }
+    IScsiDelTcb (Tcb);
+    gBS->SignalEvent (Event);
   }
+}
 
-ON_EXIT:
+/**
+  The timer callback to poll the connection for the completion of the nonblocking
+  SCSI commands sent on it.
+
+  @param[in]  Event    The timer event.
+  @param[in]  Context  The iSCSI connection.
+
+**/
+VOID
+EFIAPI
+IScsiOnPollTimer (
+  IN EFI_EVENT  Event,
+  IN VOID       *Context
+  )
+{
+  ISCSI_CONNECTION   *Conn;
+  ISCSI_SESSION      *Session;
+  ISCSI_DRIVER_DATA  *Private;
+  EFI_STATUS         Status;
+
+  Conn    = (ISCSI_CONNECTION *)Context;
+  Session = Conn->Session;
+  Private = Session->Private;
 
-  if (TimeoutEvent != NULL) {
-    gBS->SetTimer (TimeoutEvent, TimerCancel, 0);
+  if (Private->InPassThru) {
+    //
+    // The pass thru function in progress receives the PDUs on the connection.
+    //
+    return;
   }
 
-  if (Tcb != NULL) {
-    IScsiDelTcb (Tcb);
+  Private->InPassThru = TRUE;
+
+  //
+  // Only process the PDUs that have arrived, the timer polls again for the rest.
+  //
+  Status = IScsiWaitScsiCommands (Conn, NULL, TRUE);
+  if (EFI_ERROR (Status)) {
+    //
+    // The outstanding commands are failed by the reinstatement, which also
+    // destroys this connection together with its poll timer.
+    //
+    IScsiSessionReinstatement (Session);
+  } else if (IScsiGetPendingTcb (Session) == NULL) {
+    gBS->SetTimer (Event, TimerCancel, 0);
   }
 
-  return Status;
+  Private->InPassThru = FALSE;
+
+  IScsiSignalScsiCommands (Session);
 }
 
 /**
@@ -3133,6 +3533,7 @@ IScsiSessionInit (
 
     InitializeListHead (&Session->Conns);
     InitializeListHead (&Session->TcbList);
+    InitializeListHead (&Session->CompletedTcbList);
   }
 
   Session->Tsih = 0;
@@ -3169,6 +3570,9 @@ IScsiSessionAbort (
 {
   ISCSI_CONNECTION  *Conn;
   EFI_GUID          *ProtocolGuid;
+  LIST_ENTRY        *Entry;
+  LIST_ENTRY        *NextEntry;
+  ISCSI_TCB         *Tcb;
 
   if (Session->State != SESSION_STATE_LOGGED_IN) {
     return;
@@ -3176,6 +3580,23 @@ IScsiSessionAbort (
 
   ASSERT (!IsListEmpty (&Session->Conns));
 
+  //
+  // Fail the outstanding nonblocking commands. They are moved off the task
+  // list, since the session may be reinstated before their events are signaled
+  // and then reuse their initiator task tags, and their connection is destroyed.
+  //
+  NET_LIST_FOR_EACH_SAFE (Entry, NextEntry, &Session->TcbList) {
+    Tcb = NET_LIST_USER_STRUCT (Entry, ISCSI_TCB, Link);
+    if (Tcb->Event != NULL) {
+      Tcb->Packet->HostAdapterStatus = EFI_EXT_SCSI_STATUS_HOST_ADAPTER_OTHER;
+      Tcb->StatusXferd               = TRUE;
+      Tcb->Conn                      = NULL;
+
+      RemoveEntryList (&Tcb->Link);
+      InsertTailList (&Session->CompletedTcbList, &Tcb->Link);
+    }
+  }
+
   while (!IsListEmpty (&Session->Conns)) {
     Conn = NET_LIST_USER_STRUCT_S (
              Session->Conns.ForwardLink,
@@ -3204,5 +3625,12 @@ IScsiSessionAbort (
 
   Session->State = SESSION_STATE_FAILED;
 
+  //
+  // Inside the pass thru function, the events are signaled on its return.
+  //
+  if (!Session->Private->InPassThru) {
+    IScsiSignalScsiCommands (Session);
+  }
+
   return;
 }
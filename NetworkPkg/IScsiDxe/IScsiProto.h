@@ -31,6 +31,12 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 #define MAX_RECV_DATA_SEG_LEN_IN_FFP   65536
 #define DEFAULT_MAX_OUTSTANDING_R2T    1
 
+//
+// Interval to poll the connection for the completion of the nonblocking
+// SCSI commands, in the unit of 100ns.
+//
+#define ISCSI_POLL_INTERVAL  (10 * TICKS_PER_MS)
+
 #define ISCSI_VERSION_MAX  0x00
 #define ISCSI_VERSION_MIN  0x00
 
@@ -595,22 +601,31 @@ typedef struct _ISCSI_IN_BUFFER_CONTEXT {
 } ISCSI_IN_BUFFER_CONTEXT;
 
 typedef struct _ISCSI_TCB {
-  LIST_ENTRY            Link;
-
-  BOOLEAN               SoFarInOrder;
-  UINT32                ExpDataSN;
-  BOOLEAN               FbitReceived;
-  BOOLEAN               StatusXferd;
-  UINT32                ActiveR2Ts;
-  UINT32                Response;
-  CHAR8                 *Reason;
-  UINT32                InitiatorTaskTag;
-  UINT32                CmdSN;
-  UINT32                SNACKTag;
-
-  ISCSI_XFER_CONTEXT    XferContext;
-
-  ISCSI_CONNECTION      *Conn;
+  LIST_ENTRY                                    Link;
+
+  BOOLEAN                                       SoFarInOrder;
+  UINT32                                        ExpDataSN;
+  BOOLEAN                                       FbitReceived;
+  BOOLEAN                                       StatusXferd;
+  UINT32                                        ActiveR2Ts;
+  UINT32                                        Response;
+  CHAR8                                         *Reason;
+  UINT32                                        InitiatorTaskTag;
+  UINT32                                        CmdSN;
+  UINT32                                        SNACKTag;
+
+  ISCSI_XFER_CONTEXT                            XferContext;
+
+  ISCSI_CONNECTION                              *Conn;
+
+  //
+  // The SCSI request this task is executing. Event is signaled when a
+  // nonblocking request completes and is NULL for a blocking request.
+  //
+  EFI_EXT_SCSI_PASS_THRU_SCSI_REQUEST_PACKET    *Packet;
+  UINT64                                        Lun;
+  EFI_EVENT                                     Event;
+  ISCSI_IN_BUFFER_CONTEXT                       InBufferContext;
 } ISCSI_TCB;
 
 typedef struct _ISCSI_KEY_VALUE_PAIR {
@@ -845,6 +860,8 @@ IScsiFreeNbufList (
   @param[out] Pdu          The received iSCSI pdu.
   @param[in]  Context      The context used to describe information on the caller provided
                            buffer to receive data segment of the iSCSI pdu, it's optional.
+                           If it is NULL, the data segment of an iSCSI SCSI Data In pdu is
+                           received into the buffer of the task the pdu belongs to.
   @param[in]  HeaderDigest Whether there will be header digest received.
   @param[in]  DataDigest   Whether there will be data digest.
   @param[in]  TimeoutEvent The timeout event, it's optional.
@@ -865,6 +882,21 @@ IScsiReceivePdu (
   IN EFI_EVENT                TimeoutEvent OPTIONAL
   );
 
+/**
+  Find the task control block of the outstanding SCSI command by its initiator task tag.
+
+  @param[in]  Session          The iSCSI session.
+  @param[in]  InitiatorTaskTag The initiator task tag in host byte order.
+
+  @return The task control block, or NULL if no such task is outstanding.
+
+**/
+ISCSI_TCB *
+IScsiFindTcb (
+  IN ISCSI_SESSION  *Session,
+  IN UINT32         InitiatorTaskTag
+  );
+
 /**
   Check and get the result of the parameter negotiation.
 
@@ -977,9 +1009,12 @@ IScsiNormalizeName (
   @param[in]       Lun       The LUN.
   @param[in, out]  Packet    The request packet containing IO request, SCSI command
                              buffer and buffers to read/write.
+  @param[in]       Event     If it is not NULL, the command is sent without waiting for
+                             its response, and Event is signaled by IScsiSignalScsiCommands()
+                             when the command completes.
 
   @retval EFI_SUCCESS          The SCSI command is executed and the result is updated to
-                               the Packet.
+                               the Packet, or the nonblocking SCSI command is sent.
   @retval EFI_DEVICE_ERROR     Session state was not as required.
   @retval EFI_OUT_OF_RESOURCES Failed to allocate memory.
   @retval EFI_NOT_READY        The target can not accept new commands.
@@ -991,7 +1026,35 @@ IScsiExecuteScsiCommand (
   IN EFI_EXT_SCSI_PASS_THRU_PROTOCOL                 *PassThru,
   IN UINT8                                           *Target,
   IN UINT64                                          Lun,
-  IN OUT EFI_EXT_SCSI_PASS_THRU_SCSI_REQUEST_PACKET  *Packet
+  IN OUT EFI_EXT_SCSI_PASS_THRU_SCSI_REQUEST_PACKET  *Packet,
+  IN EFI_EVENT                                       Event     OPTIONAL
+  );
+
+/**
+  Signal the events of the nonblocking SCSI commands that have completed, and
+  destroy their task control blocks.
+
+  @param[in]  Session  The iSCSI session.
+
+**/
+VOID
+IScsiSignalScsiCommands (
+  IN ISCSI_SESSION  *Session
+  );
+
+/**
+  The timer callback to poll the connection for the completion of the nonblocking
+  SCSI commands sent on it.
+
+  @param[in]  Event    The timer event.
+  @param[in]  Context  The iSCSI connection.
+
+**/
+VOID
+EFIAPI
+IScsiOnPollTimer (
+  IN EFI_EVENT  Event,
+  IN VOID       *Context
   );
 
 /**
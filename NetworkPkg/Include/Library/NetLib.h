@@ -1556,6 +1556,13 @@ NetLibIp6ToStr (
 #define  NET_BUF_HEAD          1    // Trim or allocate space from head
 #define  NET_BUF_TAIL          0    // Trim or allocate space from tail
 #define  NET_VECTOR_OWN_FIRST  0x01 // We allocated the 1st block in the vector
+#define  NET_VECTOR_POOLED     0x02 // The 1st block is from the NET_BUF pool
+
+//
+// Size of the pooled data blocks, large enough for a MTU sized
+// packet with its link and protocol headers.
+//
+#define  NET_BUF_POOL_BLOCK_SIZE  2048
 
 #define NET_CHECK_SIGNATURE(PData, SIGNATURE) \
   ASSERT (((PData) != NULL) && ((PData)->Signature == (SIGNATURE)))
@@ -1580,7 +1587,7 @@ typedef struct {
   INTN                   RefCnt; // Reference count to share NET_VECTOR.
   NET_VECTOR_EXT_FREE    Free;   // external function to free NET_VECTOR
   VOID                   *Arg;   // opaque argument to Free
-  UINT32                 Flag;   // Flags, NET_VECTOR_OWN_FIRST
+  UINT32                 Flag;   // Flags, NET_VECTOR_OWN_FIRST or NET_VECTOR_POOLED
   UINT32                 Len;    // Total length of the associated BLOCKs
 
   UINT32                 BlockNum;
@@ -1676,6 +1683,27 @@ typedef struct {
   UINT8     *Bulk;
 } NET_FRAGMENT;
 
+//
+// The classes of memory kept by the NET_BUF pool.
+//
+typedef enum {
+  NetbufPoolHead,                         // NET_BUF with a single NET_BLOCK_OP
+  NetbufPoolVector,                       // NET_VECTOR with a single NET_BLOCK
+  NetbufPoolBlock,                        // Data block of NET_BUF_POOL_BLOCK_SIZE
+  NetbufPoolTypeMax
+} NET_BUF_POOL_TYPE;
+
+//
+// Allocation counters of a NET_BUF pool class.
+//
+typedef struct {
+  UINT64    Hits;                         // Allocations served from the pool
+  UINT64    Misses;                       // Allocations served by AllocatePool
+  UINT64    Recycles;                     // Frees that kept the memory in the pool
+  UINT64    Releases;                     // Frees that returned the memory by FreePool
+  UINT32    FreeCount;                    // Number of free entries in the pool
+} NET_BUF_POOL_STATISTICS;
+
 #define NET_GET_REF(PData)           ((PData)->RefCnt++)
 #define NET_PUT_REF(PData)           ((PData)->RefCnt--)
 #define NETBUF_FROM_PROTODATA(Info)  BASE_CR((Info), NET_BUF, ProtoData)
@@ -1729,6 +1757,28 @@ NetbufFree (
   IN NET_BUF  *Nbuf
   );
 
+/**
+  Get the allocation counters of a NET_BUF pool class.
+
+  Net buffers, single block net vectors and data blocks of up to
+  NET_BUF_POOL_BLOCK_SIZE bytes are kept in per-module free lists when they
+  are freed, and reused by later allocations. The counters are those of the
+  calling module.
+
+  @param[in]   Type          The class of the pool.
+  @param[out]  Statistics    The pointer to receive the counters.
+
+  @retval EFI_SUCCESS            The counters are returned.
+  @retval EFI_INVALID_PARAMETER  Type is invalid or Statistics is NULL.
+
+**/
+EFI_STATUS
+EFIAPI
+NetbufGetPoolStatistics (
+  IN  NET_BUF_POOL_TYPE        Type,
+  OUT NET_BUF_POOL_STATISTICS  *Statistics
+  );
+
 /**
   Get the index of NET_BLOCK_OP that contains the byte at Offset in the net
   buffer.
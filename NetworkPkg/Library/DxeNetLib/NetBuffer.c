@@ -14,6 +14,220 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 #include <Library/UefiBootServicesTableLib.h>
 #include <Library/MemoryAllocationLib.h>
 
+//
+// A free entry of the NET_BUF pool, stored in the freed memory itself.
+//
+typedef struct _NET_BUF_POOL_ENTRY NET_BUF_POOL_ENTRY;
+
+struct _NET_BUF_POOL_ENTRY {
+  NET_BUF_POOL_ENTRY    *Next;
+};
+
+typedef struct {
+  UINTN                      Size;
+  NET_BUF_POOL_ENTRY         *FreeList;
+  NET_BUF_POOL_STATISTICS    Statistics;
+} NET_BUF_POOL;
+
+//
+// Each entry is allocated separately from the system pool, so a net buffer
+// allocated by one module can be freed by any other, either into that
+// module's pool or by FreePool.
+//
+STATIC NET_BUF_POOL  mNetbufPool[NetbufPoolTypeMax] = {
+  { NET_BUF_SIZE (1),        NULL, { 0 } },
+  { NET_VECTOR_SIZE (1),     NULL, { 0 } },
+  { NET_BUF_POOL_BLOCK_SIZE, NULL, { 0 } }
+};
+
+/**
+  Allocate memory of a NET_BUF pool class, reusing a free entry if there is one.
+
+  @param[in]  Type             The class of the pool.
+
+  @return                      Pointer to the allocated memory, or NULL if the
+                               allocation failed due to resource limit.
+
+**/
+VOID *
+NetbufPoolAllocate (
+  IN NET_BUF_POOL_TYPE  Type
+  )
+{
+  NET_BUF_POOL        *Pool;
+  NET_BUF_POOL_ENTRY  *Entry;
+  EFI_TPL             OldTpl;
+
+  ASSERT (Type < NetbufPoolTypeMax);
+  Pool = &mNetbufPool[Type];
+
+  OldTpl = gBS->RaiseTPL (TPL_NOTIFY);
+  Entry  = Pool->FreeList;
+  if (Entry != NULL) {
+    Pool->FreeList = Entry->Next;
+    Pool->Statistics.FreeCount--;
+    Pool->Statistics.Hits++;
+  } else {
+    Pool->Statistics.Misses++;
+  }
+
+  gBS->RestoreTPL (OldTpl);
+
+  if (Entry == NULL) {
+    Entry = AllocatePool (Pool->Size);
+  }
+
+  return Entry;
+}
+
+/**
+  Free memory of a NET_BUF pool class. The memory is kept in the pool for
+  reuse unless the pool already holds PcdNetBufPoolDepth free entries.
+
+  @param[in]  Type             The class of the pool.
+  @param[in]  Buffer           Pointer to the memory to free.
+
+**/
+VOID
+NetbufPoolFree (
+  IN NET_BUF_POOL_TYPE  Type,
+  IN VOID               *Buffer
+  )
+{
+  NET_BUF_POOL        *Pool;
+  NET_BUF_POOL_ENTRY  *Entry;
+  EFI_TPL             OldTpl;
+
+  ASSERT (Type < NetbufPoolTypeMax);
+  ASSERT (Buffer != NULL);
+  Pool  = &mNetbufPool[Type];
+  Entry = (NET_BUF_POOL_ENTRY *)Buffer;
+
+  OldTpl = gBS->RaiseTPL (TPL_NOTIFY);
+  if (Pool->Statistics.FreeCount < FixedPcdGet32 (PcdNetBufPoolDepth)) {
+    Entry->Next    = Pool->FreeList;
+    Pool->FreeList = Entry;
+    Pool->Statistics.FreeCount++;
+    Pool->Statistics.Recycles++;
+    Entry = NULL;
+  } else {
+    Pool->Statistics.Releases++;
+  }
+
+  gBS->RestoreTPL (OldTpl);
+
+  if (Entry != NULL) {
+    FreePool (Entry);
+  }
+}
+
+/**
+  Free the memory of a NET_BUF, keeping it in the pool if it has a single
+  NET_BLOCK_OP.
+
+  @param[in]  Nbuf             Pointer to the NET_BUF memory to free.
+
+**/
+VOID
+NetbufFreeStruct (
+  IN NET_BUF  *Nbuf
+  )
+{
+  if (Nbuf->BlockOpNum == 1) {
+    NetbufPoolFree (NetbufPoolHead, Nbuf);
+  } else {
+    FreePool (Nbuf);
+  }
+}
+
+/**
+  Free the memory of a NET_VECTOR, keeping it in the pool if it has a single
+  NET_BLOCK.
+
+  @param[in]  Vector           Pointer to the NET_VECTOR memory to free.
+
+**/
+VOID
+NetbufFreeVectorStruct (
+  IN NET_VECTOR  *Vector
+  )
+{
+  if (Vector->BlockNum == 1) {
+    NetbufPoolFree (NetbufPoolVector, Vector);
+  } else {
+    FreePool (Vector);
+  }
+}
+
+/**
+  Get the allocation counters of a NET_BUF pool class.
+
+  Net buffers, single block net vectors and data blocks of up to
+  NET_BUF_POOL_BLOCK_SIZE bytes are kept in per-module free lists when they
+  are freed, and reused by later allocations. The counters are those of the
+  calling module.
+
+  @param[in]   Type          The class of the pool.
+  @param[out]  Statistics    The pointer to receive the counters.
+
+  @retval EFI_SUCCESS            The counters are returned.
+  @retval EFI_INVALID_PARAMETER  Type is invalid or Statistics is NULL.
+
+**/
+EFI_STATUS
+EFIAPI
+NetbufGetPoolStatistics (
+  IN  NET_BUF_POOL_TYPE        Type,
+  OUT NET_BUF_POOL_STATISTICS  *Statistics
+  )
+{
+  EFI_TPL  OldTpl;
+
+  if ((Type >= NetbufPoolTypeMax) || (Statistics == NULL)) {
+    return EFI_INVALID_PARAMETER;
+  }
+
+  OldTpl = gBS->RaiseTPL (TPL_NOTIFY);
+  CopyMem (Statistics, &mNetbufPool[Type].Statistics, sizeof (NET_BUF_POOL_STATISTICS));
+  gBS->RestoreTPL (OldTpl);
+
+  return EFI_SUCCESS;
+}
+
+/**
+  Release the free entries of the NET_BUF pool when the module is unloaded.
+
+  @param[in]  ImageHandle      The firmware allocated handle for the EFI image.
+  @param[in]  SystemTable      A pointer to the EFI System Table.
+
+  @retval EFI_SUCCESS          The destructor always returns EFI_SUCCESS.
+
+**/
+EFI_STATUS
+EFIAPI
+NetLibDestructor (
+  IN EFI_HANDLE        ImageHandle,
+  IN EFI_SYSTEM_TABLE  *SystemTable
+  )
+{
+  NET_BUF_POOL        *Pool;
+  NET_BUF_POOL_ENTRY  *Entry;
+  UINTN               Index;
+
+  for (Index = 0; Index < NetbufPoolTypeMax; Index++) {
+    Pool = &mNetbufPool[Index];
+    while (Pool->FreeList != NULL) {
+      Entry          = Pool->FreeList;
+      Pool->FreeList = Entry->Next;
+      FreePool (Entry);
+    }
+
+    Pool->Statistics.FreeCount = 0;
+  }
+
+  return EFI_SUCCESS;
+}
+
 /**
   Allocate and build up the sketch for a NET_BUF.
 
@@ -40,9 +254,16 @@ NetbufAllocStruct (
   ASSERT (BlockOpNum >= 1);
 
   //
-  // Allocate three memory blocks.
+  // Allocate three memory blocks. The single block ones come from the pool.
   //
-  Nbuf = AllocateZeroPool (NET_BUF_SIZE (BlockOpNum));
+  if (BlockOpNum == 1) {
+    Nbuf = NetbufPoolAllocate (NetbufPoolHead);
+    if (Nbuf != NULL) {
+      ZeroMem (Nbuf, NET_BUF_SIZE (1));
+    }
+  } else {
+    Nbuf = AllocateZeroPool (NET_BUF_SIZE (BlockOpNum));
+  }
 
   if (Nbuf == NULL) {
     return NULL;
@@ -54,7 +275,14 @@ NetbufAllocStruct (
   InitializeListHead (&Nbuf->List);
 
   if (BlockNum != 0) {
-    Vector = AllocateZeroPool (NET_VECTOR_SIZE (BlockNum));
+    if (BlockNum == 1) {
+      Vector = NetbufPoolAllocate (NetbufPoolVector);
+      if (Vector != NULL) {
+        ZeroMem (Vector, NET_VECTOR_SIZE (1));
+      }
+    } else {
+      Vector = AllocateZeroPool (NET_VECTOR_SIZE (BlockNum));
+    }
 
     if (Vector == NULL) {
       goto FreeNbuf;
@@ -70,7 +298,7 @@ NetbufAllocStruct (
 
 FreeNbuf:
 
-  FreePool (Nbuf);
+  NetbufFreeStruct (Nbuf);
   return NULL;
 }
 
@@ -102,13 +330,19 @@ NetbufAlloc (
     return NULL;
   }
 
-  Bulk = AllocatePool (Len);
+  Vector = Nbuf->Vector;
+
+  if (Len <= NET_BUF_POOL_BLOCK_SIZE) {
+    Bulk         = NetbufPoolAllocate (NetbufPoolBlock);
+    Vector->Flag = NET_VECTOR_POOLED;
+  } else {
+    Bulk = AllocatePool (Len);
+  }
 
   if (Bulk == NULL) {
     goto FreeNBuf;
   }
 
-  Vector      = Nbuf->Vector;
   Vector->Len = Len;
 
   Vector->Block[0].Bulk = Bulk;
@@ -124,7 +358,8 @@ NetbufAlloc (
   return Nbuf;
 
 FreeNBuf:
-  FreePool (Nbuf);
+  NetbufFreeVectorStruct (Vector);
+  NetbufFreeStruct (Nbuf);
   return NULL;
 }
 
@@ -171,11 +406,15 @@ NetbufFreeVector (
     // Free each memory block associated with the Vector
     //
     for (Index = 0; Index < Vector->BlockNum; Index++) {
-      gBS->FreePool (Vector->Block[Index].Bulk);
+      if ((Index == 0) && ((Vector->Flag & NET_VECTOR_POOLED) != 0)) {
+        NetbufPoolFree (NetbufPoolBlock, Vector->Block[0].Bulk);
+      } else {
+        gBS->FreePool (Vector->Block[Index].Bulk);
+      }
     }
   }
 
-  FreePool (Vector);
+  NetbufFreeVectorStruct (Vector);
 }
 
 /**
@@ -208,7 +447,7 @@ NetbufFree (
     // all the sharing of Nbuf increse Vector's RefCnt by one
     //
     NetbufFreeVector (Nbuf->Vector);
-    FreePool (Nbuf);
+    NetbufFreeStruct (Nbuf);
   }
 }
 
@@ -234,7 +473,11 @@ NetbufClone (
 
   NET_CHECK_SIGNATURE (Nbuf, NET_BUF_SIGNATURE);
 
-  Clone = AllocatePool (NET_BUF_SIZE (Nbuf->BlockOpNum));
+  if (Nbuf->BlockOpNum == 1) {
+    Clone = NetbufPoolAllocate (NetbufPoolHead);
+  } else {
+    Clone = AllocatePool (NET_BUF_SIZE (Nbuf->BlockOpNum));
+  }
 
   if (Clone == NULL) {
     return NULL;
@@ -662,7 +905,8 @@ NetbufGetFragment (
 
 FreeChild:
 
-  FreePool (Child);
+  NetbufFreeVectorStruct (Child->Vector);
+  NetbufFreeStruct (Child);
   return NULL;
 }
 
@@ -1601,9 +1845,22 @@ NetbufQueFlush (
   NbufQue->BufSize = 0;
 }
 
+//
+// Add Word to the 64-bit ones' complement Sum, adding the carry out of
+// bit 63 back in.
+//
+#define NET_CHECKSUM_ADD(Sum, Word) \
+  do { \
+    (Sum) += (Word); \
+    (Sum) += ((Sum) < (Word)) ? 1 : 0; \
+  } while (FALSE)
+
 /**
   Compute the checksum for a bulk of data.
 
+  The data is summed 64 bits at a time, four 16-bit words per load, which is
+  equivalent to summing the 16-bit words in ones' complement arithmetic.
+
   @param[in]   Bulk                  Pointer to the data.
   @param[in]   Len                   Length of the data, in bytes.
 
@@ -1617,28 +1874,74 @@ NetblockChecksum (
   IN UINT32  Len
   )
 {
-  register UINT32  Sum;
+  UINT64   Sum;
+  UINT64   *Words;
+  BOOLEAN  Odd;
 
   Sum = 0;
 
   //
-  // Add left-over byte, if any
+  // If the data starts on an odd address, sum the bytes with their order in
+  // each 16-bit word swapped, starting from the next even address, and swap
+  // the result back.
   //
-  if (Len % 2 != 0) {
-    Sum += *(Bulk + Len - 1);
+  Odd = (BOOLEAN)(((UINTN)Bulk & 0x01) != 0);
+  if (Odd && (Len > 0)) {
+    Sum = (UINT64)*Bulk << 8;
+    Bulk++;
+    Len--;
   }
 
-  while (Len > 1) {
+  //
+  // Align the data to 64 bits.
+  //
+  while ((((UINTN)Bulk & 0x07) != 0) && (Len > 1)) {
     Sum  += *(UINT16 *)Bulk;
     Bulk += 2;
     Len  -= 2;
   }
 
+  Words = (UINT64 *)Bulk;
+  while (Len >= 32) {
+    NET_CHECKSUM_ADD (Sum, Words[0]);
+    NET_CHECKSUM_ADD (Sum, Words[1]);
+    NET_CHECKSUM_ADD (Sum, Words[2]);
+    NET_CHECKSUM_ADD (Sum, Words[3]);
+    Words += 4;
+    Len   -= 32;
+  }
+
+  while (Len >= 8) {
+    NET_CHECKSUM_ADD (Sum, Words[0]);
+    Words++;
+    Len -= 8;
+  }
+
+  Bulk = (UINT8 *)Words;
+  while (Len > 1) {
+    NET_CHECKSUM_ADD (Sum, *(UINT16 *)Bulk);
+    Bulk += 2;
+    Len  -= 2;
+  }
+
   //
-  // Fold 32-bit sum to 16 bits
+  // Add left-over byte, if any
   //
-  while ((Sum >> 16) != 0) {
-    Sum = (Sum & 0xffff) + (Sum >> 16);
+  if (Len != 0) {
+    NET_CHECKSUM_ADD (Sum, *Bulk);
+  }
+
+  //
+  // Fold 64-bit sum to 16 bits
+  //
+  Sum = (Sum & 0xffffffff) + (Sum >> 32);
+  Sum = (Sum & 0xffffffff) + (Sum >> 32);
+  Sum = (Sum & 0xffff) + (Sum >> 16);
+  Sum = (Sum & 0xffff) + (Sum >> 16);
+  Sum = (Sum & 0xffff) + (Sum >> 16);
+
+  if (Odd) {
+    Sum = SwapBytes16 ((UINT16)Sum);
   }
 
   return (UINT16)Sum;
@@ -1840,7 +2143,7 @@ NetIpSecNetbufFree (
       FreePool (Nbuf->Vector->Block[0].Bulk);
     }
 
-    FreePool (Nbuf->Vector);
-    FreePool (Nbuf);
+    NetbufFreeVectorStruct (Nbuf->Vector);
+    NetbufFreeStruct (Nbuf);
   }
 }
@@ -67,8 +67,16 @@ typedef struct {
   NET_BUF_QUEUE                  FreeNbufQue;
   INTN                           NbufCnt;
 
+  //
+  // List of MNP_RXDATA_WRAP recycled by the consumers
+  //
+  LIST_ENTRY                     FreeRxDataWrapList;
+  UINT32                         FreeRxDataWrapCount;
+
   EFI_EVENT                      PollTimer;
   BOOLEAN                        EnableSystemPoll;
+  UINT64                         PollInterval;
+  UINT32                         PollIdleCount;
 
   EFI_EVENT                      TimeoutCheckTimer;
   EFI_EVENT                      MediaDetectTimer;
@@ -14,6 +14,9 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 #define NET_ETHER_FCS_SIZE  4
 
 #define MNP_SYS_POLL_INTERVAL        (10 * TICKS_PER_MS)    // 10 milliseconds
+#define MNP_SYS_POLL_ACTIVE_INTERVAL (1 * TICKS_PER_MS)     // 1 millisecond
+#define MNP_SYS_POLL_IDLE_THRESHOLD  20                     // Idle polls before backing off
+#define MNP_SYS_POLL_RX_BUDGET       64                     // Max packets received per system poll
 #define MNP_TIMEOUT_CHECK_INTERVAL   (50 * TICKS_PER_MS)    // 50 milliseconds
 #define MNP_MEDIA_DETECT_INTERVAL    (500 * TICKS_PER_MS)   // 500 milliseconds
 #define MNP_TX_TIMEOUT_TIME          (500 * TICKS_PER_MS)   // 500 milliseconds
@@ -25,6 +28,12 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 
 #define MNP_MAX_RCVD_PACKET_QUE_SIZE  256
 
+//
+// Max number of recycled MNP_RXDATA_WRAPs kept for reuse, together with
+// their recycle events.
+//
+#define MNP_MAX_FREE_RXDATA_WRAP_NUM  64
+
 #define MNP_RECEIVE_UNICAST    0x01
 #define MNP_RECEIVE_BROADCAST  0x02
 
@@ -532,6 +541,23 @@ MnpSystemPoll (
   IN VOID       *Context
   );
 
+/**
+  Adjust the period of the system poll timer to the network activity.
+
+  The system poll runs every MNP_SYS_POLL_ACTIVE_INTERVAL while packets are
+  sent or received, and backs off to MNP_SYS_POLL_INTERVAL after
+  MNP_SYS_POLL_IDLE_THRESHOLD polls without receiving any packet.
+
+  @param[in, out]  MnpDeviceData     Pointer to the mnp device context data.
+  @param[in]       Active            TRUE if a packet was just sent or received.
+
+**/
+VOID
+MnpUpdatePollInterval (
+  IN OUT MNP_DEVICE_DATA  *MnpDeviceData,
+  IN     BOOLEAN          Active
+  );
+
 /**
   Returns the operational parameters for the current MNP child driver. May also
   support returning the underlying SNP driver mode data.
@@ -277,6 +277,11 @@ MnpSyncSendPacket (
 
   if (EFI_ERROR (Status)) {
     Token->Status = EFI_DEVICE_ERROR;
+  } else {
+    //
+    // A response is likely to follow, poll faster for it.
+    //
+    MnpUpdatePollInterval (MnpDeviceData, TRUE);
   }
 
 SIGNAL_TOKEN:
@@ -428,6 +433,7 @@ MnpRecycleRxData (
 {
   MNP_RXDATA_WRAP  *RxDataWrap;
   MNP_DEVICE_DATA  *MnpDeviceData;
+  EFI_TPL          OldTpl;
 
   ASSERT (Context != NULL);
 
@@ -446,16 +452,27 @@ MnpRecycleRxData (
   RxDataWrap->Nbuf = NULL;
 
   //
-  // Close the recycle event.
+  // Remove this Wrap entry from the list.
   //
-  gBS->CloseEvent (RxDataWrap->RxData.RecycleEvent);
+  RemoveEntryList (&RxDataWrap->WrapEntry);
 
   //
-  // Remove this Wrap entry from the list.
+  // Keep the Wrap and its recycle event for the next received packet if
+  // there is room in the cache, otherwise close the event and free it.
   //
-  RemoveEntryList (&RxDataWrap->WrapEntry);
+  OldTpl = gBS->RaiseTPL (TPL_NOTIFY);
+  if (MnpDeviceData->FreeRxDataWrapCount < MNP_MAX_FREE_RXDATA_WRAP_NUM) {
+    InsertTailList (&MnpDeviceData->FreeRxDataWrapList, &RxDataWrap->WrapEntry);
+    MnpDeviceData->FreeRxDataWrapCount++;
+    RxDataWrap = NULL;
+  }
+
+  gBS->RestoreTPL (OldTpl);
 
-  FreePool (RxDataWrap);
+  if (RxDataWrap != NULL) {
+    gBS->CloseEvent (RxDataWrap->RxData.RecycleEvent);
+    FreePool (RxDataWrap);
+  }
 }
 
 /**
@@ -690,6 +707,9 @@ MnpAnalysePacket (
 /**
   Wrap the RxData.
 
+  A Wrap recycled by a previous packet is reused if there is one, so that no
+  memory allocation or event creation is needed per received packet.
+
   @param[in]  Instance           Pointer to the mnp instance context data.
   @param[in]  RxData             Pointer to the receive data to wrap.
 
@@ -704,6 +724,33 @@ MnpWrapRxData (
 {
   EFI_STATUS       Status;
   MNP_RXDATA_WRAP  *RxDataWrap;
+  MNP_DEVICE_DATA  *MnpDeviceData;
+  EFI_EVENT        RecycleEvent;
+  EFI_TPL          OldTpl;
+
+  MnpDeviceData = Instance->MnpServiceData->MnpDeviceData;
+
+  //
+  // Try to reuse a recycled Wrap together with its recycle event.
+  //
+  RxDataWrap = NULL;
+  OldTpl     = gBS->RaiseTPL (TPL_NOTIFY);
+  if (!IsListEmpty (&MnpDeviceData->FreeRxDataWrapList)) {
+    RxDataWrap = NET_LIST_HEAD (&MnpDeviceData->FreeRxDataWrapList, MNP_RXDATA_WRAP, WrapEntry);
+    RemoveEntryList (&RxDataWrap->WrapEntry);
+    MnpDeviceData->FreeRxDataWrapCount--;
+  }
+
+  gBS->RestoreTPL (OldTpl);
+
+  if (RxDataWrap != NULL) {
+    RecycleEvent         = RxDataWrap->RxData.RecycleEvent;
+    RxDataWrap->Instance = Instance;
+    CopyMem (&RxDataWrap->RxData, RxData, sizeof (RxDataWrap->RxData));
+    RxDataWrap->RxData.RecycleEvent = RecycleEvent;
+
+    return RxDataWrap;
+  }
 
   //
   // Allocate memory.
@@ -1099,17 +1146,76 @@ MnpSystemPoll (
   )
 {
   MNP_DEVICE_DATA  *MnpDeviceData;
+  UINTN            Count;
 
   MnpDeviceData = (MNP_DEVICE_DATA *)Context;
   NET_CHECK_SIGNATURE (MnpDeviceData, MNP_DEVICE_DATA_SIGNATURE);
 
   //
-  // Try to receive packets from Snp.
+  // Try to receive packets from Snp, keep receiving while the packets are
+  // available, up to MNP_SYS_POLL_RX_BUDGET packets in one poll.
   //
-  MnpReceivePacket (MnpDeviceData);
+  for (Count = 0; Count < MNP_SYS_POLL_RX_BUDGET; Count++) {
+    if (EFI_ERROR (MnpReceivePacket (MnpDeviceData))) {
+      break;
+    }
+
+    //
+    // Dispatch the DPC queued by the NotifyFunction of rx token's events.
+    //
+    DispatchDpc ();
+  }
 
   //
-  // Dispatch the DPC queued by the NotifyFunction of rx token's events.
+  // Still dispatch the DPCs queued by others if no packet is received.
   //
-  DispatchDpc ();
+  if (Count == 0) {
+    DispatchDpc ();
+  }
+
+  MnpUpdatePollInterval (MnpDeviceData, (BOOLEAN)(Count != 0));
+}
+
+/**
+  Adjust the period of the system poll timer to the network activity.
+
+  The system poll runs every MNP_SYS_POLL_ACTIVE_INTERVAL while packets are
+  sent or received, and backs off to MNP_SYS_POLL_INTERVAL after
+  MNP_SYS_POLL_IDLE_THRESHOLD polls without receiving any packet.
+
+  @param[in, out]  MnpDeviceData     Pointer to the mnp device context data.
+  @param[in]       Active            TRUE if a packet was just sent or received.
+
+**/
+VOID
+MnpUpdatePollInterval (
+  IN OUT MNP_DEVICE_DATA  *MnpDeviceData,
+  IN     BOOLEAN          Active
+  )
+{
+  UINT64      Interval;
+  EFI_STATUS  Status;
+
+  if (!MnpDeviceData->EnableSystemPoll) {
+    return;
+  }
+
+  if (Active) {
+    MnpDeviceData->PollIdleCount = 0;
+    Interval                     = MNP_SYS_POLL_ACTIVE_INTERVAL;
+  } else if (MnpDeviceData->PollIdleCount < MNP_SYS_POLL_IDLE_THRESHOLD) {
+    MnpDeviceData->PollIdleCount++;
+    return;
+  } else {
+    Interval = MNP_SYS_POLL_INTERVAL;
+  }
+
+  if (Interval == MnpDeviceData->PollInterval) {
+    return;
+  }
+
+  Status = gBS->SetTimer (MnpDeviceData->PollTimer, TimerPeriodic, Interval);
+  if (!EFI_ERROR (Status)) {
+    MnpDeviceData->PollInterval = Interval;
+  }
 }
@@ -0,0 +1,871 @@
+/** @file
+  Tests for the SACK support in TcpOption.c and TcpSack.c, and for the loss
+  recovery of TcpInput.c and TcpOutput.c over a simulated path.
+
+  Copyright (c) 2026, agent. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+**/
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <iostream>
+#include <map>
+#include <set>
+#include <vector>
+
+extern "C" {
+  #include <Uefi.h>
+  #include <Library/BaseLib.h>
+  #include <Library/DebugLib.h>
+  #include <Library/BaseMemoryLib.h>
+  #include <Library/MemoryAllocationLib.h>
+  #include <Library/UefiBootServicesTableLib.h>
+  #include "../TcpMain.h"
+}
+
+////////////////////////////////////////////////////////////////////////
+// Defines
+////////////////////////////////////////////////////////////////////////
+
+#define TEST_ISS       10000
+#define TEST_MSS       1000
+
+////////////////////////////////////////////////////////////////////////
+// Helpers
+////////////////////////////////////////////////////////////////////////
+
+//
+// NetLib raises the TPL and frees the pool through the boot services.
+//
+static EFI_BOOT_SERVICES  mFakeBs;
+static EFI_BOOT_SERVICES  *mSavedBs;
+
+static EFI_TPL
+EFIAPI
+FakeRaiseTpl (
+  IN EFI_TPL  NewTpl
+  )
+{
+  return TPL_APPLICATION;
+}
+
+static VOID
+EFIAPI
+FakeRestoreTpl (
+  IN EFI_TPL  OldTpl
+  )
+{
+}
+
+static EFI_STATUS
+EFIAPI
+FakeFreePool (
+  IN VOID  *Buffer
+  )
+{
+  FreePool (Buffer);
+  return EFI_SUCCESS;
+}
+
+static VOID
+UseFakeBootServices (
+  VOID
+  )
+{
+  ZeroMem (&mFakeBs, sizeof (mFakeBs));
+  mFakeBs.RaiseTPL   = FakeRaiseTpl;
+  mFakeBs.RestoreTPL = FakeRestoreTpl;
+  mFakeBs.FreePool   = FakeFreePool;
+
+  mSavedBs = gBS;
+  gBS      = &mFakeBs;
+}
+
+static VOID
+RestoreBootServices (
+  VOID
+  )
+{
+  gBS = mSavedBs;
+}
+
+//
+// Queue a segment of [Seq, End) on the RcvQue, the queue is kept sorted.
+//
+static VOID
+QueueSegment (
+  IN TCP_CB     *Tcb,
+  IN TCP_SEQNO  Seq,
+  IN TCP_SEQNO  End
+  )
+{
+  NET_BUF     *Nbuf;
+  LIST_ENTRY  *Entry;
+
+  Nbuf = NetbufAlloc (1);
+  ASSERT_NE (Nbuf, nullptr);
+
+  TCPSEG_NETBUF (Nbuf)->Seq = Seq;
+  TCPSEG_NETBUF (Nbuf)->End = End;
+
+  for (Entry = Tcb->RcvQue.ForwardLink; Entry != &Tcb->RcvQue; Entry = Entry->ForwardLink) {
+    if (TCP_SEQ_LT (Seq, TCPSEG_NETBUF (NET_LIST_USER_STRUCT (Entry, NET_BUF, List))->Seq)) {
+      break;
+    }
+  }
+
+  InsertTailList (Entry, &Nbuf->List);
+  Tcb->RcvSackSeq = Seq;
+}
+
+//
+// Parse the options built in Nbuf with TcpParseOption.
+//
+static INTN
+ParseBuiltOption (
+  IN  NET_BUF     *Nbuf,
+  IN  UINT16      Len,
+  OUT TCP_OPTION  *Option
+  )
+{
+  UINT8     Buffer[sizeof (TCP_HEAD) + TCP_OPTION_MAX_LEN];
+  TCP_HEAD  *Head;
+
+  ZeroMem (Buffer, sizeof (Buffer));
+  Head          = (TCP_HEAD *)Buffer;
+  Head->HeadLen = (UINT8)((sizeof (TCP_HEAD) + Len) >> 2);
+  NetbufCopy (Nbuf, 0, Len, Buffer + sizeof (TCP_HEAD));
+
+  return TcpParseOption (Head, Option);
+}
+
+////////////////////////////////////////////////////////////////////////
+// TcpSackOption Tests
+////////////////////////////////////////////////////////////////////////
+
+class TcpSackOptionTest : public ::testing::Test {
+protected:
+  TCP_CB Tcb;
+  NET_BUF *Nbuf;
+
+  virtual void
+  SetUp (
+    )
+  {
+    UseFakeBootServices ();
+
+    ZeroMem (&Tcb, sizeof (Tcb));
+    InitializeListHead (&Tcb.SndQue);
+    InitializeListHead (&Tcb.RcvQue);
+    Tcb.RcvNxt = TEST_ISS;
+    Tcb.SndMss = TEST_MSS;
+
+    Nbuf = NetbufAlloc (TCP_MAX_HEAD + TEST_MSS);
+    ASSERT_NE (Nbuf, nullptr);
+    NetbufReserve (Nbuf, TCP_MAX_HEAD);
+    TCPSEG_NETBUF (Nbuf)->Flag = TCP_FLG_ACK;
+  }
+
+  virtual void
+  TearDown (
+    )
+  {
+    NetbufFree (Nbuf);
+    NetbufFreeList (&Tcb.RcvQue);
+    RestoreBootServices ();
+  }
+};
+
+// Test Description:
+// The SYN carries SACK permitted option unless SACK is disabled.
+TEST_F (TcpSackOptionTest, SynCarriesSackPermitted) {
+  TCP_OPTION  Option;
+  UINT16      Len;
+
+  TCP_SET_FLG (Tcb.CtrlFlag, TCP_CTRL_NO_TS | TCP_CTRL_NO_WS);
+  TCPSEG_NETBUF (Nbuf)->Flag = TCP_FLG_SYN;
+
+  Len = TcpSynBuildOption (&Tcb, Nbuf);
+  ASSERT_EQ (Len, TCP_OPTION_SACK_PERM_ALIGNED_LEN + TCP_OPTION_MSS_LEN);
+  ASSERT_EQ (ParseBuiltOption (Nbuf, Len, &Option), 0);
+  EXPECT_TRUE (TCP_FLG_ON (Option.Flag, TCP_OPTION_RCVD_SACK_PERM));
+}
+
+// Test Description:
+// The SYN/ACK carries SACK permitted option only if the SYN does.
+TEST_F (TcpSackOptionTest, SynAckWithoutSackPermitted) {
+  TCP_OPTION  Option;
+  UINT16      Len;
+
+  TCP_SET_FLG (Tcb.CtrlFlag, TCP_CTRL_NO_TS | TCP_CTRL_NO_WS);
+  TCPSEG_NETBUF (Nbuf)->Flag = TCP_FLG_SYN | TCP_FLG_ACK;
+
+  Len = TcpSynBuildOption (&Tcb, Nbuf);
+  ASSERT_EQ (Len, TCP_OPTION_MSS_LEN);
+  ASSERT_EQ (ParseBuiltOption (Nbuf, Len, &Option), 0);
+  EXPECT_FALSE (TCP_FLG_ON (Option.Flag, TCP_OPTION_RCVD_SACK_PERM));
+}
+
+// Test Description:
+// The ACK reports the latest block first, then the others in order,
+// and fits into the option space left by the timestamp option.
+TEST_F (TcpSackOptionTest, AckReportsLatestBlockFirst) {
+  TCP_OPTION  Option;
+  UINT16      Len;
+
+  TCP_SET_FLG (Tcb.CtrlFlag, TCP_CTRL_RCVD_SACK | TCP_CTRL_SND_TS);
+
+  QueueSegment (&Tcb, TEST_ISS + 1000, TEST_ISS + 2000);
+  QueueSegment (&Tcb, TEST_ISS + 2000, TEST_ISS + 3000);
+  QueueSegment (&Tcb, TEST_ISS + 7000, TEST_ISS + 8000);
+  QueueSegment (&Tcb, TEST_ISS + 9000, TEST_ISS + 10000);
+  QueueSegment (&Tcb, TEST_ISS + 4000, TEST_ISS + 5000);
+
+  Len = TcpBuildOption (&Tcb, Nbuf);
+  ASSERT_EQ (Len, TCP_OPTION_MAX_LEN);
+  ASSERT_EQ (ParseBuiltOption (Nbuf, Len, &Option), 0);
+  ASSERT_TRUE (TCP_FLG_ON (Option.Flag, TCP_OPTION_RCVD_TS));
+  ASSERT_TRUE (TCP_FLG_ON (Option.Flag, TCP_OPTION_RCVD_SACK));
+  ASSERT_EQ (Option.SackCount, 3);
+
+  EXPECT_EQ (Option.Sack[0].Left, (TCP_SEQNO)TEST_ISS + 4000);
+  EXPECT_EQ (Option.Sack[0].Right, (TCP_SEQNO)TEST_ISS + 5000);
+  EXPECT_EQ (Option.Sack[1].Left, (TCP_SEQNO)TEST_ISS + 1000);
+  EXPECT_EQ (Option.Sack[1].Right, (TCP_SEQNO)TEST_ISS + 3000);
+  EXPECT_EQ (Option.Sack[2].Left, (TCP_SEQNO)TEST_ISS + 7000);
+  EXPECT_EQ (Option.Sack[2].Right, (TCP_SEQNO)TEST_ISS + 8000);
+}
+
+// Test Description:
+// A full sized data segment has no room for the SACK option.
+TEST_F (TcpSackOptionTest, NoSackOptionInFullSegment) {
+  UINT16  Len;
+
+  TCP_SET_FLG (Tcb.CtrlFlag, TCP_CTRL_RCVD_SACK);
+  QueueSegment (&Tcb, TEST_ISS + 1000, TEST_ISS + 2000);
+
+  ASSERT_NE (NetbufAllocSpace (Nbuf, TEST_MSS - 8, NET_BUF_TAIL), nullptr);
+  Len = TcpBuildOption (&Tcb, Nbuf);
+  EXPECT_EQ (Len, 0);
+}
+
+// Test Description:
+// SACK option with a length not multiple of a block is malformed.
+TEST_F (TcpSackOptionTest, MalformedSackOption) {
+  UINT8       Buffer[sizeof (TCP_HEAD) + 12];
+  TCP_HEAD    *Head;
+  TCP_OPTION  Option;
+
+  ZeroMem (Buffer, sizeof (Buffer));
+  Head          = (TCP_HEAD *)Buffer;
+  Head->HeadLen = sizeof (Buffer) >> 2;
+  Buffer[sizeof (TCP_HEAD) + 0] = TCP_OPTION_NOP;
+  Buffer[sizeof (TCP_HEAD) + 1] = TCP_OPTION_NOP;
+  Buffer[sizeof (TCP_HEAD) + 2] = TCP_OPTION_SACK;
+  Buffer[sizeof (TCP_HEAD) + 3] = 6;
+
+  EXPECT_EQ (TcpParseOption (Head, &Option), -1);
+}
+
+////////////////////////////////////////////////////////////////////////
+// TcpSackScoreboard Tests
+////////////////////////////////////////////////////////////////////////
+
+class TcpSackScoreboardTest : public ::testing::Test {
+protected:
+  TCP_CB Tcb;
+  TCP_OPTION Option;
+
+  virtual void
+  SetUp (
+    )
+  {
+    ZeroMem (&Tcb, sizeof (Tcb));
+    ZeroMem (&Option, sizeof (Option));
+    Tcb.SndUna = TEST_ISS;
+    Tcb.SndNxt = TEST_ISS + 100 * TEST_MSS;
+    Tcb.SndMss = TEST_MSS;
+    TCP_SET_FLG (Option.Flag, TCP_OPTION_RCVD_SACK);
+  }
+
+  VOID
+  Sack (
+    IN UINT32  Left,
+    IN UINT32  Right
+    )
+  {
+    Option.SackCount     = 1;
+    Option.Sack[0].Left  = TEST_ISS + Left;
+    Option.Sack[0].Right = TEST_ISS + Right;
+    TcpSackUpdate (&Tcb, Tcb.SndUna, &Option);
+  }
+};
+
+// Test Description:
+// Overlapping and adjacent ranges are merged.
+TEST_F (TcpSackScoreboardTest, MergeRanges) {
+  Sack (5000, 6000);
+  Sack (1000, 2000);
+  Sack (2000, 3000);
+  Sack (5500, 7000);
+  Sack (3000, 5000);
+
+  ASSERT_EQ (Tcb.SackBlockCount, 1);
+  EXPECT_EQ (Tcb.SackBlock[0].Left, (TCP_SEQNO)TEST_ISS + 1000);
+  EXPECT_EQ (Tcb.SackBlock[0].Right, (TCP_SEQNO)TEST_ISS + 7000);
+}
+
+// Test Description:
+// Invalid blocks are ignored, and ranges below the ACK are removed.
+TEST_F (TcpSackScoreboardTest, TrimByAck) {
+  Sack (1000, 2000);
+  Sack (3000, 4000);
+  Sack (4000, 3500);
+  Sack (200 * TEST_MSS, 201 * TEST_MSS);
+
+  ASSERT_EQ (Tcb.SackBlockCount, 2);
+
+  Option.SackCount = 0;
+  TcpSackUpdate (&Tcb, TEST_ISS + 3500, &Option);
+
+  ASSERT_EQ (Tcb.SackBlockCount, 1);
+  EXPECT_EQ (Tcb.SackBlock[0].Left, (TCP_SEQNO)TEST_ISS + 3500);
+  EXPECT_EQ (Tcb.SackBlock[0].Right, (TCP_SEQNO)TEST_ISS + 4000);
+}
+
+// Test Description:
+// When the scoreboard is full, the highest range is dropped.
+TEST_F (TcpSackScoreboardTest, FullScoreboard) {
+  UINT32  Index;
+
+  for (Index = 0; Index <= TCP_SACK_SCOREBOARD; Index++) {
+    Sack ((2 * Index + 2) * TEST_MSS, (2 * Index + 3) * TEST_MSS);
+  }
+
+  ASSERT_EQ (Tcb.SackBlockCount, TCP_SACK_SCOREBOARD);
+  Sack (TEST_MSS, 2 * TEST_MSS);
+
+  ASSERT_EQ (Tcb.SackBlockCount, TCP_SACK_SCOREBOARD);
+  EXPECT_EQ (Tcb.SackBlock[0].Left, (TCP_SEQNO)TEST_ISS + TEST_MSS);
+  EXPECT_EQ (Tcb.SackBlock[0].Right, (TCP_SEQNO)TEST_ISS + 3 * TEST_MSS);
+  EXPECT_EQ (Tcb.SackBlock[TCP_SACK_SCOREBOARD - 1].Right, (TCP_SEQNO)TEST_ISS + (2 * TCP_SACK_SCOREBOARD + 1) * TEST_MSS);
+}
+
+// Test Description:
+// A hole is lost only after more than (DupThresh - 1) * SMSS above it is SACKed.
+TEST_F (TcpSackScoreboardTest, LossDetection) {
+  TCP_SEQNO  Seq;
+  TCP_SEQNO  End;
+
+  Sack (TEST_MSS, 3 * TEST_MSS);
+  EXPECT_FALSE (TcpSackIsLost (&Tcb, Tcb.SndUna));
+  EXPECT_FALSE (TcpSackNextHole (&Tcb, FALSE, &Seq, &End));
+
+  Sack (4 * TEST_MSS, 4 * TEST_MSS + 1);
+  EXPECT_TRUE (TcpSackIsLost (&Tcb, Tcb.SndUna));
+  ASSERT_TRUE (TcpSackNextHole (&Tcb, FALSE, &Seq, &End));
+  EXPECT_EQ (Seq, Tcb.SndUna);
+  EXPECT_EQ (End, Tcb.SndUna + TEST_MSS);
+
+  Tcb.HighRxt = End;
+  EXPECT_FALSE (TcpSackNextHole (&Tcb, FALSE, &Seq, &End));
+  ASSERT_TRUE (TcpSackNextHole (&Tcb, TRUE, &Seq, &End));
+  EXPECT_EQ (Seq, (TCP_SEQNO)TEST_ISS + 3 * TEST_MSS);
+  EXPECT_EQ (End, (TCP_SEQNO)TEST_ISS + 4 * TEST_MSS);
+}
+
+////////////////////////////////////////////////////////////////////////
+// TcpSackTransfer Tests
+//
+// Two connected TCBs run a bulk transfer through the real TcpInput,
+// TcpFastRecover and TcpOutput paths. The IP layer is a simulated path
+// with a bottleneck link, that drops the scripted segments the first
+// time they are sent. The clock is in microseconds, and the TCP heart
+// beat runs on it, so the retransmission timer works as it does on the
+// wire.
+////////////////////////////////////////////////////////////////////////
+
+//
+// 5 ms one way, and 100 Mbit/s.
+//
+#define TEST_DELAY             5000
+#define TEST_RTT               (2 * TEST_DELAY)
+#define TEST_LINK_BITS_PER_US  100
+
+#define TEST_TICK_US      (1000000 / TCP_TICK_HZ)
+#define TEST_TIME_LIMIT   (60ULL * 1000000)
+#define TEST_RCV_WINDOW   (64 * TEST_MSS)
+#define TEST_INIT_CWND    (4 * TEST_MSS)
+#define TEST_TRANSFER     (200 * TEST_MSS)
+
+//
+// One end of the connection, with its socket. The socket buffers are only
+// used for their sizes, the data is a stream of bytes computed from the
+// offset in the stream.
+//
+typedef struct {
+  SOCKET           Sock;
+  NET_BUF_QUEUE    SndData;
+  NET_BUF_QUEUE    RcvData;
+  IP_IO_IP_INFO    IpInfo;
+  TCP_CB           *Tcb;
+  UINT32           Sent;
+  UINT32           Received;
+  BOOLEAN          Corrupted;
+} TEST_PEER;
+
+typedef struct {
+  TEST_PEER             *From;
+  TEST_PEER             *To;
+  std::vector<UINT8>    Data;
+} TEST_PACKET;
+
+static UINT64                              mNow;
+static UINT64                              mLinkFree;
+static std::multimap<UINT64, TEST_PACKET>  mWire;
+static TEST_PEER                           mSender;
+static TEST_PEER                           mReceiver;
+static std::vector<UINT32>                 mLost;
+static std::set<TCP_SEQNO>                 mSentSeq;
+static std::vector<TCP_SEQNO>              mResent;
+static std::vector<UINT64>                 mResentTime;
+
+static UINT8
+StreamByte (
+  IN UINT32  Offset
+  )
+{
+  return (UINT8)(Offset ^ (Offset >> 8) ^ (Offset >> 16));
+}
+
+static TEST_PEER *
+PeerOfSock (
+  IN SOCKET  *Sock
+  )
+{
+  return (Sock == &mSender.Sock) ? &mSender : &mReceiver;
+}
+
+//
+// The socket layer, as seen from TCP.
+//
+SOCKET *
+SockClone (
+  IN SOCKET  *Sock
+  )
+{
+  return NULL;
+}
+
+VOID
+SockConnEstablished (
+  IN OUT SOCKET  *Sock
+  )
+{
+}
+
+VOID
+SockConnClosed (
+  IN OUT SOCKET  *Sock
+  )
+{
+}
+
+VOID
+SockNoMoreData (
+  IN OUT SOCKET  *Sock
+  )
+{
+}
+
+UINT32
+SockGetFreeSpace (
+  IN SOCKET  *Sock,
+  IN UINT32  Which
+  )
+{
+  if (Which == SOCK_SND_BUF) {
+    return GET_SND_BUFFSIZE (Sock) - GET_SND_DATASIZE (Sock);
+  }
+
+  return GET_RCV_BUFFSIZE (Sock) - GET_RCV_DATASIZE (Sock);
+}
+
+UINT32
+SockGetDataToSend (
+  IN  SOCKET  *Sock,
+  IN  UINT32  Offset,
+  IN  UINT32  Len,
+  OUT UINT8   *Dest
+  )
+{
+  TEST_PEER  *Peer;
+  UINT32     Index;
+
+  Peer = PeerOfSock (Sock);
+  if (Offset >= GET_SND_DATASIZE (Sock)) {
+    return 0;
+  }
+
+  Len = MIN (Len, GET_SND_DATASIZE (Sock) - Offset);
+  for (Index = 0; Index < Len; Index++) {
+    Dest[Index] = StreamByte (Peer->Sent + Offset + Index);
+  }
+
+  return Len;
+}
+
+VOID
+SockDataSent (
+  IN OUT SOCKET  *Sock,
+  IN     UINT32  Count
+  )
+{
+  PeerOfSock (Sock)->Sent            += Count;
+  Sock->SndBuffer.DataQueue->BufSize -= Count;
+}
+
+VOID
+SockDataRcvd (
+  IN OUT SOCKET   *Sock,
+  IN OUT NET_BUF  *NetBuffer,
+  IN     UINT32   UrgLen
+  )
+{
+  TEST_PEER           *Peer;
+  std::vector<UINT8>  Data;
+  UINT32              Index;
+
+  Peer = PeerOfSock (Sock);
+  Data.resize (NetBuffer->TotalSize);
+  NetbufCopy (NetBuffer, 0, NetBuffer->TotalSize, Data.data ());
+
+  for (Index = 0; Index < Data.size (); Index++) {
+    if (Data[Index] != StreamByte (Peer->Received + Index)) {
+      Peer->Corrupted = TRUE;
+    }
+  }
+
+  Peer->Received += NetBuffer->TotalSize;
+}
+
+//
+// The IP layer: the segment is queued on the wire to arrive at the peer,
+// or dropped.
+//
+INTN
+TcpSendIpPacket (
+  IN TCP_CB          *Tcb,
+  IN NET_BUF         *Nbuf,
+  IN EFI_IP_ADDRESS  *Src,
+  IN EFI_IP_ADDRESS  *Dest,
+  IN UINT8           Version
+  )
+{
+  TEST_PACKET  Packet;
+  TCP_HEAD     *Head;
+  TCP_SEQNO    Seq;
+  UINT32       Len;
+  UINT32       Index;
+  UINT64       Arrival;
+
+  if ((Tcb != mSender.Tcb) && (Tcb != mReceiver.Tcb)) {
+    ADD_FAILURE () << "Unexpected segment without a connection";
+    return -1;
+  }
+
+  Packet.From = (Tcb == mSender.Tcb) ? &mSender : &mReceiver;
+  Packet.To   = (Tcb == mSender.Tcb) ? &mReceiver : &mSender;
+  Packet.Data.resize (Nbuf->TotalSize);
+  NetbufCopy (Nbuf, 0, Nbuf->TotalSize, Packet.Data.data ());
+
+  Head = (TCP_HEAD *)Packet.Data.data ();
+  Seq  = NTOHL (Head->Seq);
+  Len  = Nbuf->TotalSize - (Head->HeadLen << 2);
+
+  if (Len == 0) {
+    Arrival = mNow + TEST_DELAY;
+  } else {
+    Index = TCP_SUB_SEQ (Seq, Tcb->Iss + 1) / TEST_MSS;
+    if (!mSentSeq.insert (Seq).second) {
+      mResent.push_back (Seq);
+      mResentTime.push_back (mNow);
+    } else if (std::find (mLost.begin (), mLost.end (), Index) != mLost.end ()) {
+      return 0;
+    }
+
+    mLinkFree = MAX (mNow, mLinkFree) + Nbuf->TotalSize * 8 / TEST_LINK_BITS_PER_US;
+    Arrival   = mLinkFree + TEST_DELAY;
+  }
+
+  mWire.insert (std::make_pair (Arrival, Packet));
+  return 0;
+}
+
+EFI_STATUS
+Tcp6RefreshNeighbor (
+  IN TCP_CB          *Tcb,
+  IN EFI_IP_ADDRESS  *Neighbor,
+  IN UINT32          Timeout
+  )
+{
+  return EFI_SUCCESS;
+}
+
+EFI_STATUS
+EFIAPI
+IpIoGetIcmpErrStatus (
+  IN  UINT8    IcmpError,
+  IN  UINT8    IpVersion,
+  OUT BOOLEAN  *IsHard  OPTIONAL,
+  OUT BOOLEAN  *Notify  OPTIONAL
+  )
+{
+  return EFI_UNSUPPORTED;
+}
+
+EFI_STATUS
+EFIAPI
+QueueDpc (
+  IN EFI_TPL            DpcTpl,
+  IN EFI_DPC_PROCEDURE  DpcProcedure,
+  IN VOID               *DpcContext    OPTIONAL
+  )
+{
+  DpcProcedure (DpcContext);
+  return EFI_SUCCESS;
+}
+
+class TcpSackTransferTest : public ::testing::TestWithParam<std::vector<UINT32> > {
+protected:
+  void
+  SetUp (
+    ) override
+  {
+    UseFakeBootServices ();
+  }
+
+  void
+  TearDown (
+    ) override
+  {
+    Disconnect ();
+    RestoreBootServices ();
+  }
+
+  //
+  // Set up one end in ESTABLISHED state, as it is after the handshake.
+  //
+  VOID
+  InitPeer (
+    IN TEST_PEER  *Peer,
+    IN TEST_PEER  *Remote,
+    IN UINT32     Host,
+    IN BOOLEAN    Sack
+    )
+  {
+    TCP_CB  *Tcb;
+
+    ZeroMem (Peer, sizeof (TEST_PEER));
+    Peer->Sock.IpVersion           = IP_VERSION_4;
+    Peer->Sock.SndBuffer.DataQueue = &Peer->SndData;
+    Peer->Sock.RcvBuffer.DataQueue = &Peer->RcvData;
+    Peer->Sock.SndBuffer.HighWater = TEST_TRANSFER;
+    Peer->Sock.RcvBuffer.HighWater = TEST_RCV_WINDOW;
+    Peer->IpInfo.IpVersion         = IP_VERSION_4;
+
+    Tcb = (TCP_CB *)AllocateZeroPool (sizeof (TCP_CB));
+    ASSERT_NE (Tcb, nullptr);
+    InitializeListHead (&Tcb->List);
+    InitializeListHead (&Tcb->SndQue);
+    InitializeListHead (&Tcb->RcvQue);
+
+    Tcb->Sk                   = &Peer->Sock;
+    Tcb->IpInfo               = &Peer->IpInfo;
+    Tcb->LocalEnd.Ip.Addr[0]  = HTONL (0x0A000000 + Host);
+    Tcb->LocalEnd.Port        = HTONS ((UINT16)(1000 + Host));
+    Tcb->RemoteEnd.Ip.Addr[0] = HTONL (0x0A000000 + 3 - Host);
+    Tcb->RemoteEnd.Port       = HTONS ((UINT16)(1000 + 3 - Host));
+    Tcb->HeadSum              = NetPseudoHeadChecksum (Tcb->LocalEnd.Ip.Addr[0], Tcb->RemoteEnd.Ip.Addr[0], 0x06, 0);
+
+    Tcb->Iss       = TEST_ISS * Host;
+    Tcb->SndUna    = Tcb->Iss + 1;
+    Tcb->SndNxt    = Tcb->SndUna;
+    Tcb->SndWl2    = Tcb->SndUna;
+    Tcb->SndWnd    = TEST_RCV_WINDOW;
+    Tcb->SndWndMax = TEST_RCV_WINDOW;
+    Tcb->SndMss    = TEST_MSS;
+
+    Tcb->Irs    = TEST_ISS * (3 - Host);
+    Tcb->RcvNxt = Tcb->Irs + 1;
+    Tcb->RcvWl2 = Tcb->RcvNxt;
+    Tcb->SndWl1 = Tcb->RcvNxt;
+    Tcb->RcvWnd = TEST_RCV_WINDOW;
+    Tcb->RcvMss = TEST_MSS;
+
+    Tcb->CWnd         = TEST_INIT_CWND;
+    Tcb->Ssthresh     = 0xffffffff;
+    Tcb->Rto          = 3 * TCP_TICK_HZ;
+    Tcb->CongestState = TCP_CONGEST_OPEN;
+    Tcb->MaxRexmit    = TCP_MAX_LOSS;
+
+    TCP_SET_FLG (Tcb->CtrlFlag, TCP_CTRL_NO_TS | TCP_CTRL_NO_WS | TCP_CTRL_NO_KEEPALIVE);
+    TCP_SET_FLG (Tcb->CtrlFlag, Sack ? TCP_CTRL_RCVD_SACK : TCP_CTRL_NO_SACK);
+
+    Tcb->State = TCP_CLOSED;
+    ASSERT_EQ (TcpInsertTcb (Tcb), 0);
+    Tcb->State = TCP_ESTABLISHED;
+
+    Peer->Tcb = Tcb;
+  }
+
+  VOID
+  Disconnect (
+    )
+  {
+    TEST_PEER  *Peer[] = { &mSender, &mReceiver };
+    UINT32     Index;
+
+    for (Index = 0; Index < ARRAY_SIZE (Peer); Index++) {
+      if (Peer[Index]->Tcb != NULL) {
+        RemoveEntryList (&Peer[Index]->Tcb->List);
+        NetbufFreeList (&Peer[Index]->Tcb->SndQue);
+        NetbufFreeList (&Peer[Index]->Tcb->RcvQue);
+        FreePool (Peer[Index]->Tcb);
+        Peer[Index]->Tcb = NULL;
+      }
+    }
+
+    mWire.clear ();
+  }
+
+  //
+  // Send TEST_TRANSFER bytes from the sender through the lossy path, and
+  // return the time taken for the receiver to get all of them.
+  //
+  UINT64
+  Transfer (
+    IN BOOLEAN                    Sack,
+    IN const std::vector<UINT32>  &Lost
+    )
+  {
+    TEST_PACKET     Packet;
+    NET_BUF         *Nbuf;
+    UINT8           *Data;
+    EFI_IP_ADDRESS  Src;
+    EFI_IP_ADDRESS  Dst;
+    UINT64          NextTick;
+
+    Disconnect ();
+    InitPeer (&mSender, &mReceiver, 1, Sack);
+    InitPeer (&mReceiver, &mSender, 2, Sack);
+
+    mNow      = 0;
+    mLinkFree = 0;
+    mLost     = Lost;
+    mSentSeq.clear ();
+    mResent.clear ();
+    mResentTime.clear ();
+
+    mSender.SndData.BufSize = TEST_TRANSFER;
+    TcpToSendData (mSender.Tcb, 0);
+
+    NextTick = TEST_TICK_US;
+    while (mReceiver.Received < TEST_TRANSFER) {
+      if (mNow > TEST_TIME_LIMIT) {
+        ADD_FAILURE () << "The transfer doesn't complete";
+        break;
+      }
+
+      if (mWire.empty () || (mWire.begin ()->first > NextTick)) {
+        mNow      = NextTick;
+        NextTick += TEST_TICK_US;
+        TcpTicking (NULL, NULL);
+        continue;
+      }
+
+      mNow   = mWire.begin ()->first;
+      Packet = mWire.begin ()->second;
+      mWire.erase (mWire.begin ());
+
+      Nbuf = NetbufAlloc ((UINT32)Packet.Data.size ());
+      EXPECT_NE (Nbuf, nullptr);
+      Data = NetbufAllocSpace (Nbuf, (UINT32)Packet.Data.size (), NET_BUF_TAIL);
+      CopyMem (Data, Packet.Data.data (), Packet.Data.size ());
+
+      CopyMem (&Src, &Packet.From->Tcb->LocalEnd.Ip, sizeof (Src));
+      CopyMem (&Dst, &Packet.To->Tcb->LocalEnd.Ip, sizeof (Dst));
+      TcpInput (Nbuf, &Src, &Dst, IP_VERSION_4);
+    }
+
+    EXPECT_EQ (mReceiver.Received, (UINT32)TEST_TRANSFER);
+    EXPECT_FALSE (mReceiver.Corrupted);
+    return mNow;
+  }
+};
+
+//
+// Goodput in Mbit/s of the transfer that took Time us.
+//
+static double
+Goodput (
+  IN UINT64  Time
+  )
+{
+  return (double)TEST_TRANSFER * 8 / (double)Time;
+}
+
+// Test Description:
+// With SACK, every lost segment is retransmitted exactly once, and all of
+// them within one round trip, without waiting for the retransmission timer.
+TEST_P (TcpSackTransferTest, RepairInOneRoundTrip) {
+  const std::vector<UINT32>  &Lost = GetParam ();
+  std::vector<TCP_SEQNO>     Expected;
+  UINT32                     Index;
+
+  for (Index = 0; Index < Lost.size (); Index++) {
+    Expected.push_back (TEST_ISS + 1 + Lost[Index] * TEST_MSS);
+  }
+
+  Transfer (TRUE, Lost);
+
+  EXPECT_EQ (mResent, Expected);
+  ASSERT_FALSE (mResentTime.empty ());
+  EXPECT_LT (mResentTime.back () - mResentTime.front (), (UINT64)TEST_RTT);
+  EXPECT_EQ (mSender.Tcb->LossTimes, 0);
+}
+
+// Test Description:
+// Compare the goodput of the transfer with SACK and with NewReno alone.
+// With several losses in a window, NewReno takes a round trip per hole.
+TEST_P (TcpSackTransferTest, GoodputAgainstNewReno) {
+  const std::vector<UINT32>  &Lost = GetParam ();
+  UINT64                     NewReno;
+  UINT64                     Sack;
+  size_t                     NewRenoResent;
+
+  NewReno       = Transfer (FALSE, Lost);
+  NewRenoResent = mResent.size ();
+  Sack          = Transfer (TRUE, Lost);
+
+  std::cout << "[          ] " << Lost.size () << " lost, goodput " << Goodput (NewReno) << " Mbit/s with NewReno ("
+            << NewRenoResent << " resent), " << Goodput (Sack) << " Mbit/s with SACK (" << mResent.size () << " resent)" << std::endl;
+
+  EXPECT_LE (mResent.size (), NewRenoResent);
+  if (Lost.size () > 1) {
+    EXPECT_LT (Sack, NewReno);
+  } else {
+    EXPECT_LE (Sack, NewReno);
+  }
+}
+
+INSTANTIATE_TEST_SUITE_P (
+  LossPatterns,
+  TcpSackTransferTest,
+  ::testing::Values (
+               std::vector<UINT32>{ 40 },
+               std::vector<UINT32>{ 40, 43, 47 },
+               std::vector<UINT32>{ 40, 41, 42, 43 },
+               std::vector<UINT32>{ 40, 42, 44, 46, 48, 50 },
+               std::vector<UINT32>{ 40, 41, 42, 43, 44, 45, 46, 47 }
+               )
+  );
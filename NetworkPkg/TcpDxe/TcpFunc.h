@@ -493,6 +493,99 @@ TcpInput (
   IN UINT8           Version
   );
 
+//
+// Functions in TcpSack.c
+//
+
+/**
+  Collect the blocks of data queued out of order to build the SACK option.
+
+  The first block contains the segment received most recently, as required by
+  RFC2018. The other blocks follow in sequence order.
+
+  @param[in]   Tcb        Pointer to the TCP_CB of this TCP instance.
+  @param[out]  Block      Pointer to the buffer to store the blocks.
+  @param[in]   MaxBlock   The maximum number of blocks to store.
+
+  @return The number of blocks stored in Block.
+
+**/
+UINT8
+TcpSackBuildBlocks (
+  IN  TCP_CB          *Tcb,
+  OUT TCP_SACK_BLOCK  *Block,
+  IN  UINT8           MaxBlock
+  );
+
+/**
+  Update the scoreboard of the sender with the received ACK and SACK option.
+
+  @param[in, out]  Tcb      Pointer to the TCP_CB of this TCP instance.
+  @param[in]       Ack      The acknowledge sequence number of the received segment.
+  @param[in]       Option   Pointer to the options parsed from the received segment.
+
+**/
+VOID
+TcpSackUpdate (
+  IN OUT TCP_CB      *Tcb,
+  IN     TCP_SEQNO   Ack,
+  IN     TCP_OPTION  *Option
+  );
+
+/**
+  Check whether the data at sequence Seq is considered lost, that is,
+  more than (DupThresh - 1) * SndMss bytes above it have been SACKed.
+
+  @param[in]  Tcb      Pointer to the TCP_CB of this TCP instance.
+  @param[in]  Seq      The sequence number to check.
+
+  @retval TRUE         The data at Seq is lost.
+  @retval FALSE        The data at Seq is not lost.
+
+**/
+BOOLEAN
+TcpSackIsLost (
+  IN TCP_CB     *Tcb,
+  IN TCP_SEQNO  Seq
+  );
+
+/**
+  Find the next hole in the sequence space to retransmit during the recovery.
+
+  @param[in]   Tcb      Pointer to the TCP_CB of this TCP instance.
+  @param[in]   Force    If TRUE, return the hole even if it isn't considered lost.
+  @param[out]  Seq      The first sequence number of the hole.
+  @param[out]  End      The sequence number immediately following the hole.
+
+  @retval TRUE          A hole is found.
+  @retval FALSE         There is no hole to retransmit.
+
+**/
+BOOLEAN
+TcpSackNextHole (
+  IN  TCP_CB     *Tcb,
+  IN  BOOLEAN    Force,
+  OUT TCP_SEQNO  *Seq,
+  OUT TCP_SEQNO  *End
+  );
+
+/**
+  Retransmit the next hole during the SACK based recovery, and advance HighRxt.
+
+  @param[in, out]  Tcb      Pointer to the TCP_CB of this TCP instance.
+  @param[in]       Force    If TRUE, retransmit the next hole even if it isn't
+                            considered lost.
+
+  @retval TRUE              A hole is retransmitted.
+  @retval FALSE             There is no hole to retransmit, or the retransmission failed.
+
+**/
+BOOLEAN
+TcpSackRetransmit (
+  IN OUT TCP_CB   *Tcb,
+  IN     BOOLEAN  Force
+  );
+
 //
 // Functions in TcpTimer.c
 //
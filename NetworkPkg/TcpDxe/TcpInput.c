@@ -32,6 +32,10 @@ TcpSeqAcceptable (
 /**
   NewReno fast recovery defined in RFC3782.
 
+  If SACK is in use, the retransmissions follow the scoreboard as
+  RFC6675 suggests. The holes considered lost are retransmitted as
+  the duplicated ACKs arrive, instead of one per round trip.
+
   @param[in, out]  Tcb      Pointer to the TCP_CB of this TCP instance.
   @param[in]       Seg      Segment that triggers the fast recovery.
 
@@ -63,7 +67,13 @@ TcpFastRecover (
     //
     // Step 2: Entering fast retransmission
     //
-    TcpRetransmit (Tcb, Tcb->SndUna);
+    if (TCP_FLG_ON (Tcb->CtrlFlag, TCP_CTRL_RCVD_SACK)) {
+      Tcb->HighRxt = Tcb->SndUna;
+      TcpSackRetransmit (Tcb, TRUE);
+    } else {
+      TcpRetransmit (Tcb, Tcb->SndUna);
+    }
+
     Tcb->CWnd = Tcb->Ssthresh + 3 * Tcb->SndMss;
 
     DEBUG (
@@ -87,7 +97,12 @@ TcpFastRecover (
     // Step 4 is skipped here only to be executed later
     // by TcpToSendData
     //
-    Tcb->CWnd += Tcb->SndMss;
+    // If SACK is in use and another hole is lost, retransmit
+    // it in place of the segment that has left the network.
+    //
+    if (!TCP_FLG_ON (Tcb->CtrlFlag, TCP_CTRL_RCVD_SACK) || !TcpSackRetransmit (Tcb, FALSE)) {
+      Tcb->CWnd += Tcb->SndMss;
+    }
     DEBUG (
       (DEBUG_NET,
        "TcpFastRecover: received another duplicated ACK (%d) for TCB %p\n",
@@ -121,7 +136,19 @@ TcpFastRecover (
       // fast retransmit the first unacknowledge field
       // , then deflate the CWnd
       //
-      TcpRetransmit (Tcb, Seg->Ack);
+      // If SACK is in use and the first unacknowledged
+      // data has been retransmitted, retransmit the next
+      // lost hole instead.
+      //
+      if (!TCP_FLG_ON (Tcb->CtrlFlag, TCP_CTRL_RCVD_SACK)) {
+        TcpRetransmit (Tcb, Seg->Ack);
+      } else if (TCP_SEQ_LEQ (Tcb->HighRxt, Seg->Ack)) {
+        Tcb->HighRxt = Seg->Ack;
+        TcpSackRetransmit (Tcb, TRUE);
+      } else {
+        TcpSackRetransmit (Tcb, FALSE);
+      }
+
       Acked = TCP_SUB_SEQ (Seg->Ack, Tcb->SndUna);
 
       //
@@ -569,6 +596,7 @@ TcpQueueData (
   //
   if (IsListEmpty (Head)) {
     InsertTailList (Head, &Nbuf->List);
+    Tcb->RcvSackSeq = Seg->Seq;
     return 1;
   }
 
@@ -605,6 +633,7 @@ TcpQueueData (
   }
 
   InsertHeadList (Prev, &Nbuf->List);
+  Tcb->RcvSackSeq = Seg->Seq;
 
   TCP_SET_FLG (Tcb->CtrlFlag, TCP_CTRL_ACK_NOW);
 
@@ -1207,6 +1236,13 @@ TcpInput (
     TCP_CLEAR_FLG (Tcb->CtrlFlag, TCP_CTRL_RTT_ON);
   }
 
+  //
+  // Update the SACK scoreboard before the fast recovery uses it.
+  //
+  if (TCP_FLG_ON (Tcb->CtrlFlag, TCP_CTRL_RCVD_SACK)) {
+    TcpSackUpdate (Tcb, Seg->Ack, &Option);
+  }
+
   if (Seg->Ack == Tcb->SndNxt) {
     TcpClearTimer (Tcb, TCP_TIMER_REXMIT);
   } else {
@@ -160,6 +160,28 @@ TcpSynBuildOption (
     TcpPutUint32 (Data, TCP_OPTION_WS_FAST | TcpComputeScale (Tcb));
   }
 
+  //
+  // Build SACK permitted option, only when configured
+  // to use SACK, and either we are doing active open
+  // or we have received SACK permitted option from peer.
+  //
+  if (!TCP_FLG_ON (Tcb->CtrlFlag, TCP_CTRL_NO_SACK) &&
+      (!TCP_FLG_ON (TCPSEG_NETBUF (Nbuf)->Flag, TCP_FLG_ACK) ||
+       TCP_FLG_ON (Tcb->CtrlFlag, TCP_CTRL_RCVD_SACK))
+      )
+  {
+    Data = NetbufAllocSpace (
+             Nbuf,
+             TCP_OPTION_SACK_PERM_ALIGNED_LEN,
+             NET_BUF_HEAD
+             );
+
+    ASSERT (Data != NULL);
+
+    Len += TCP_OPTION_SACK_PERM_ALIGNED_LEN;
+    TcpPutUint32 (Data, TCP_OPTION_SACK_PERM_FAST);
+  }
+
   //
   // Build the MSS option.
   //
@@ -187,11 +209,17 @@ TcpBuildOption (
   IN NET_BUF  *Nbuf
   )
 {
-  UINT8   *Data;
-  UINT16  Len;
+  UINT8           *Data;
+  UINT16          Len;
+  UINT32          DataLen;
+  UINT32          Space;
+  UINT8           BlockCount;
+  UINT8           Index;
+  TCP_SACK_BLOCK  Block[TCP_SACK_MAX_BLOCK];
 
   ASSERT ((Tcb != NULL) && (Nbuf != NULL) && (Nbuf->Tcp == NULL));
-  Len = 0;
+  Len     = 0;
+  DataLen = Nbuf->TotalSize;
 
   //
   // Build the Timestamp option.
@@ -214,6 +242,51 @@ TcpBuildOption (
     TcpPutUint32 (Data + 8, Tcb->TsRecent);
   }
 
+  //
+  // Build the SACK option to report the data queued out of
+  // order. SndMss has already excluded the timestamp option,
+  // the data and the SACK option together must not exceed it.
+  //
+  if (TCP_FLG_ON (Tcb->CtrlFlag, TCP_CTRL_RCVD_SACK) &&
+      !IsListEmpty (&Tcb->RcvQue) &&
+      !TCP_FLG_ON (TCPSEG_NETBUF (Nbuf)->Flag, TCP_FLG_RST)
+      )
+  {
+    Space = TCP_OPTION_MAX_LEN - Len;
+    if (DataLen + Space > Tcb->SndMss) {
+      Space = (Tcb->SndMss > DataLen) ? (Tcb->SndMss - DataLen) : 0;
+    }
+
+    BlockCount = 0;
+    if (Space >= TCP_OPTION_SACK_HEAD_ALIGNED_LEN + TCP_OPTION_SACK_BLOCK_LEN) {
+      BlockCount = TcpSackBuildBlocks (
+                     Tcb,
+                     Block,
+                     (UINT8)MIN ((Space - TCP_OPTION_SACK_HEAD_ALIGNED_LEN) / TCP_OPTION_SACK_BLOCK_LEN, TCP_SACK_MAX_BLOCK)
+                     );
+    }
+
+    if (BlockCount != 0) {
+      Data = NetbufAllocSpace (
+               Nbuf,
+               TCP_OPTION_SACK_HEAD_ALIGNED_LEN + BlockCount * TCP_OPTION_SACK_BLOCK_LEN,
+               NET_BUF_HEAD
+               );
+
+      ASSERT (Data != NULL);
+      Len = (UINT16)(Len + TCP_OPTION_SACK_HEAD_ALIGNED_LEN + BlockCount * TCP_OPTION_SACK_BLOCK_LEN);
+
+      TcpPutUint32 (Data, TCP_OPTION_SACK_FAST | (2 + BlockCount * TCP_OPTION_SACK_BLOCK_LEN));
+      Data += TCP_OPTION_SACK_HEAD_ALIGNED_LEN;
+
+      for (Index = 0; Index < BlockCount; Index++) {
+        TcpPutUint32 (Data, Block[Index].Left);
+        TcpPutUint32 (Data + 4, Block[Index].Right);
+        Data += TCP_OPTION_SACK_BLOCK_LEN;
+      }
+    }
+  }
+
   return Len;
 }
 
@@ -239,10 +312,12 @@ TcpParseOption (
   UINT8  Cur;
   UINT8  Type;
   UINT8  Len;
+  UINT8  Index;
 
   ASSERT ((Tcp != NULL) && (Option != NULL));
 
-  Option->Flag = 0;
+  Option->Flag      = 0;
+  Option->SackCount = 0;
 
   TotalLen = (UINT8)((Tcp->HeadLen << 2) - sizeof (TCP_HEAD));
   if (TotalLen <= 0) {
@@ -311,6 +386,42 @@ TcpParseOption (
         Cur += TCP_OPTION_TS_LEN;
         break;
 
+      case TCP_OPTION_SACK_PERM:
+        Len = Head[Cur + 1];
+
+        if ((Len != TCP_OPTION_SACK_PERM_LEN) || (TotalLen - Cur < TCP_OPTION_SACK_PERM_LEN)) {
+          return -1;
+        }
+
+        TCP_SET_FLG (Option->Flag, TCP_OPTION_RCVD_SACK_PERM);
+
+        Cur += TCP_OPTION_SACK_PERM_LEN;
+        break;
+
+      case TCP_OPTION_SACK:
+        Len = Head[Cur + 1];
+
+        if ((Len < 2 + TCP_OPTION_SACK_BLOCK_LEN) ||
+            ((Len - 2) % TCP_OPTION_SACK_BLOCK_LEN != 0) ||
+            (TotalLen - Cur < Len))
+        {
+          return -1;
+        }
+
+        //
+        // Keep the first blocks only, they carry the latest information.
+        //
+        Option->SackCount = (UINT8)MIN ((Len - 2) / TCP_OPTION_SACK_BLOCK_LEN, TCP_SACK_MAX_BLOCK);
+        for (Index = 0; Index < Option->SackCount; Index++) {
+          Option->Sack[Index].Left  = TcpGetUint32 (&Head[Cur + 2 + Index * TCP_OPTION_SACK_BLOCK_LEN]);
+          Option->Sack[Index].Right = TcpGetUint32 (&Head[Cur + 6 + Index * TCP_OPTION_SACK_BLOCK_LEN]);
+        }
+
+        TCP_SET_FLG (Option->Flag, TCP_OPTION_RCVD_SACK);
+
+        Cur = (UINT8)(Cur + Len);
+        break;
+
       case TCP_OPTION_NOP:
         Cur++;
         break;
@@ -70,6 +70,8 @@
 #define TCP_CTRL_TIMER_ON      0x1000   ///< At least one of the timer is on.
 #define TCP_CTRL_RTT_ON        0x2000   ///< The RTT measurement is on.
 #define TCP_CTRL_ACK_NOW       0x4000   ///< Send the ACK now, don't delay.
+#define TCP_CTRL_NO_SACK       0x8000   ///< Disable SACK option.
+#define TCP_CTRL_RCVD_SACK     0x10000  ///< Received a SACK-permitted option in syn.
 
 //
 // Timer related values
@@ -123,6 +125,13 @@
 #define TCP_FIN_WAIT2_TIME_MAX    (4 * TCP_TICK_HZ)
 #define TCP_TIME_WAIT_TIME_MAX    (60 * TCP_TICK_HZ)
 
+//
+// SACK related values
+//
+#define TCP_SACK_MAX_BLOCK   4        ///< Max number of blocks in a SACK option.
+#define TCP_SACK_SCOREBOARD  8        ///< Max number of SACKed ranges kept by the sender.
+#define TCP_DUP_THRESH       3        ///< DupThresh defined in RFC6675.
+
 ///
 /// TCP_CONNECTED: both ends have synchronized their ISN.
 ///
@@ -224,6 +233,14 @@ typedef struct _TCP_PEER {
   TCP_PORTNO        Port; ///< Port number, in network byte order.
 } TCP_PEER;
 
+///
+/// A block of sequence space, used by SACK.
+///
+typedef struct _TCP_SACK_BLOCK {
+  TCP_SEQNO    Left;  ///< The first sequence number of the block.
+  TCP_SEQNO    Right; ///< The sequence number immediately following the last one of the block.
+} TCP_SACK_BLOCK;
+
 typedef struct _TCP_CONTROL_BLOCK TCP_CB;
 
 ///
@@ -312,6 +329,15 @@ struct _TCP_CONTROL_BLOCK {
   //
   TCP_SEQNO           RetxmitSeqMax;     ///< Max Seq number in previous retransmission.
 
+  //
+  // RFC2018 and RFC6675 variables.
+  // Selective acknowledgment + SACK based loss recovery.
+  //
+  TCP_SACK_BLOCK      SackBlock[TCP_SACK_SCOREBOARD]; ///< Ranges SACKed by the peer, sorted, above SndUna.
+  UINT8               SackBlockCount;                 ///< Number of ranges in SackBlock.
+  TCP_SEQNO           HighRxt;                        ///< Highest sequence retransmitted during recovery.
+  TCP_SEQNO           RcvSackSeq;                     ///< Seq of the latest segment put on the RcvQue.
+
   //
   // configuration parameters, for EFI_TCP4_PROTOCOL specification
   //
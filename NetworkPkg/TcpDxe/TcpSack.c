@@ -0,0 +1,395 @@
+/** @file
+  Selective acknowledgment routines, as defined in RFC2018, and the
+  SACK based loss recovery, as defined in RFC6675.
+
+  Copyright (c) 2026, agent. All rights reserved.<BR>
+
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#include "TcpMain.h"
+
+/**
+  Collect the blocks of data queued out of order to build the SACK option.
+
+  The first block contains the segment received most recently, as required by
+  RFC2018. The other blocks follow in sequence order.
+
+  @param[in]   Tcb        Pointer to the TCP_CB of this TCP instance.
+  @param[out]  Block      Pointer to the buffer to store the blocks.
+  @param[in]   MaxBlock   The maximum number of blocks to store.
+
+  @return The number of blocks stored in Block.
+
+**/
+UINT8
+TcpSackBuildBlocks (
+  IN  TCP_CB          *Tcb,
+  OUT TCP_SACK_BLOCK  *Block,
+  IN  UINT8           MaxBlock
+  )
+{
+  LIST_ENTRY      *Entry;
+  NET_BUF         *Nbuf;
+  TCP_SEG         *Seg;
+  TCP_SACK_BLOCK  Current;
+  BOOLEAN         Valid;
+  BOOLEAN         Found;
+  UINT8           Count;
+
+  ASSERT ((Tcb != NULL) && (Block != NULL));
+
+  if ((MaxBlock == 0) || IsListEmpty (&Tcb->RcvQue)) {
+    return 0;
+  }
+
+  //
+  // Block[0] is reserved for the block of the latest segment.
+  //
+  Count = 1;
+  Found = FALSE;
+  Valid = FALSE;
+
+  Entry = Tcb->RcvQue.ForwardLink;
+  while (TRUE) {
+    Seg = NULL;
+    if (Entry != &Tcb->RcvQue) {
+      Nbuf  = NET_LIST_USER_STRUCT (Entry, NET_BUF, List);
+      Seg   = TCPSEG_NETBUF (Nbuf);
+      Entry = Entry->ForwardLink;
+
+      if (!TCP_SEQ_GT (Seg->Seq, Tcb->RcvNxt)) {
+        continue;
+      }
+
+      //
+      // Merge the adjacent segments into one block.
+      //
+      if (Valid && TCP_SEQ_LEQ (Seg->Seq, Current.Right)) {
+        if (TCP_SEQ_GT (Seg->End, Current.Right)) {
+          Current.Right = Seg->End;
+        }
+
+        continue;
+      }
+    }
+
+    if (Valid) {
+      if (!Found && TCP_SEQ_LEQ (Current.Left, Tcb->RcvSackSeq) && TCP_SEQ_LT (Tcb->RcvSackSeq, Current.Right)) {
+        CopyMem (&Block[0], &Current, sizeof (TCP_SACK_BLOCK));
+        Found = TRUE;
+      } else if (Count < MaxBlock) {
+        CopyMem (&Block[Count], &Current, sizeof (TCP_SACK_BLOCK));
+        Count++;
+      }
+    }
+
+    if (Seg == NULL) {
+      break;
+    }
+
+    Current.Left  = Seg->Seq;
+    Current.Right = Seg->End;
+    Valid         = TRUE;
+  }
+
+  if (!Found) {
+    Count--;
+    CopyMem (&Block[0], &Block[1], Count * sizeof (TCP_SACK_BLOCK));
+  }
+
+  return Count;
+}
+
+/**
+  Record a SACKed range in the scoreboard of the sender.
+
+  The scoreboard keeps the ranges sorted and merges the overlapping or adjacent
+  ones. If it is full, the range with the highest sequence is dropped, since the
+  ranges close to SndUna are the ones that decide what to retransmit.
+
+  @param[in, out]  Tcb      Pointer to the TCP_CB of this TCP instance.
+  @param[in]       Left     The first sequence number of the range.
+  @param[in]       Right    The sequence number immediately following the range.
+
+**/
+STATIC
+VOID
+TcpSackInsert (
+  IN OUT TCP_CB     *Tcb,
+  IN     TCP_SEQNO  Left,
+  IN     TCP_SEQNO  Right
+  )
+{
+  TCP_SACK_BLOCK  *Block;
+  UINT8           Index;
+  UINT8           Last;
+
+  Block = Tcb->SackBlock;
+
+  //
+  // Find the first range that ends at or after Left, then merge
+  // all the ranges that start at or before Right into it.
+  //
+  for (Index = 0; Index < Tcb->SackBlockCount; Index++) {
+    if (TCP_SEQ_GEQ (Block[Index].Right, Left)) {
+      break;
+    }
+  }
+
+  for (Last = Index; Last < Tcb->SackBlockCount; Last++) {
+    if (TCP_SEQ_GT (Block[Last].Left, Right)) {
+      break;
+    }
+
+    if (TCP_SEQ_LT (Block[Last].Left, Left)) {
+      Left = Block[Last].Left;
+    }
+
+    if (TCP_SEQ_GT (Block[Last].Right, Right)) {
+      Right = Block[Last].Right;
+    }
+  }
+
+  if (Last == Index) {
+    //
+    // Nothing to merge, insert a new range.
+    //
+    if (Tcb->SackBlockCount == TCP_SACK_SCOREBOARD) {
+      if (Index == TCP_SACK_SCOREBOARD) {
+        return;
+      }
+
+      Tcb->SackBlockCount--;
+    }
+
+    CopyMem (&Block[Index + 1], &Block[Index], (Tcb->SackBlockCount - Index) * sizeof (TCP_SACK_BLOCK));
+    Tcb->SackBlockCount++;
+  } else if (Last > Index + 1) {
+    CopyMem (&Block[Index + 1], &Block[Last], (Tcb->SackBlockCount - Last) * sizeof (TCP_SACK_BLOCK));
+    Tcb->SackBlockCount = (UINT8)(Tcb->SackBlockCount - (Last - Index - 1));
+  }
+
+  Block[Index].Left  = Left;
+  Block[Index].Right = Right;
+}
+
+/**
+  Update the scoreboard of the sender with the received ACK and SACK option.
+
+  @param[in, out]  Tcb      Pointer to the TCP_CB of this TCP instance.
+  @param[in]       Ack      The acknowledge sequence number of the received segment.
+  @param[in]       Option   Pointer to the options parsed from the received segment.
+
+**/
+VOID
+TcpSackUpdate (
+  IN OUT TCP_CB      *Tcb,
+  IN     TCP_SEQNO   Ack,
+  IN     TCP_OPTION  *Option
+  )
+{
+  TCP_SACK_BLOCK  *Block;
+  TCP_SEQNO       Left;
+  TCP_SEQNO       Right;
+  UINT8           Index;
+
+  Block = Tcb->SackBlock;
+
+  //
+  // Remove the ranges that are cumulatively acknowledged.
+  //
+  for (Index = 0; Index < Tcb->SackBlockCount; Index++) {
+    if (TCP_SEQ_GT (Block[Index].Right, Ack)) {
+      break;
+    }
+  }
+
+  if (Index != 0) {
+    Tcb->SackBlockCount = (UINT8)(Tcb->SackBlockCount - Index);
+    CopyMem (&Block[0], &Block[Index], Tcb->SackBlockCount * sizeof (TCP_SACK_BLOCK));
+  }
+
+  if ((Tcb->SackBlockCount != 0) && TCP_SEQ_LT (Block[0].Left, Ack)) {
+    Block[0].Left = Ack;
+  }
+
+  if (!TCP_FLG_ON (Option->Flag, TCP_OPTION_RCVD_SACK)) {
+    return;
+  }
+
+  for (Index = 0; Index < Option->SackCount; Index++) {
+    Left  = Option->Sack[Index].Left;
+    Right = Option->Sack[Index].Right;
+
+    //
+    // Ignore the invalid blocks and the blocks below Ack, such as
+    // those of D-SACK defined in RFC2883.
+    //
+    if (!TCP_SEQ_LT (Left, Right) || !TCP_SEQ_GT (Right, Ack) || TCP_SEQ_GT (Right, Tcb->SndNxt)) {
+      continue;
+    }
+
+    if (TCP_SEQ_LT (Left, Ack)) {
+      Left = Ack;
+    }
+
+    TcpSackInsert (Tcb, Left, Right);
+  }
+}
+
+/**
+  Check whether the data at sequence Seq is considered lost, that is,
+  more than (DupThresh - 1) * SndMss bytes above it have been SACKed.
+
+  @param[in]  Tcb      Pointer to the TCP_CB of this TCP instance.
+  @param[in]  Seq      The sequence number to check.
+
+  @retval TRUE         The data at Seq is lost.
+  @retval FALSE        The data at Seq is not lost.
+
+**/
+BOOLEAN
+TcpSackIsLost (
+  IN TCP_CB     *Tcb,
+  IN TCP_SEQNO  Seq
+  )
+{
+  UINT32  Sacked;
+  UINT8   Index;
+
+  Sacked = 0;
+
+  for (Index = Tcb->SackBlockCount; Index > 0; Index--) {
+    if (TCP_SEQ_LEQ (Tcb->SackBlock[Index - 1].Right, Seq)) {
+      break;
+    }
+
+    if (TCP_SEQ_LT (Tcb->SackBlock[Index - 1].Left, Seq)) {
+      Sacked += TCP_SUB_SEQ (Tcb->SackBlock[Index - 1].Right, Seq);
+    } else {
+      Sacked += TCP_SUB_SEQ (Tcb->SackBlock[Index - 1].Right, Tcb->SackBlock[Index - 1].Left);
+    }
+
+    if (Sacked > (TCP_DUP_THRESH - 1) * (UINT32)Tcb->SndMss) {
+      return TRUE;
+    }
+  }
+
+  return FALSE;
+}
+
+/**
+  Find the next hole in the sequence space to retransmit during the recovery.
+
+  The search starts from the greater of SndUna and HighRxt, and skips the
+  ranges in the scoreboard. The hole found is limited to SndMss.
+
+  @param[in]   Tcb      Pointer to the TCP_CB of this TCP instance.
+  @param[in]   Force    If TRUE, return the hole even if it isn't considered lost.
+  @param[out]  Seq      The first sequence number of the hole.
+  @param[out]  End      The sequence number immediately following the hole.
+
+  @retval TRUE          A hole is found.
+  @retval FALSE         There is no hole to retransmit.
+
+**/
+BOOLEAN
+TcpSackNextHole (
+  IN  TCP_CB     *Tcb,
+  IN  BOOLEAN    Force,
+  OUT TCP_SEQNO  *Seq,
+  OUT TCP_SEQNO  *End
+  )
+{
+  TCP_SEQNO  Start;
+  UINT8      Index;
+
+  Start = Tcb->SndUna;
+  if (TCP_SEQ_GT (Tcb->HighRxt, Start)) {
+    Start = Tcb->HighRxt;
+  }
+
+  for (Index = 0; Index < Tcb->SackBlockCount; Index++) {
+    if (TCP_SEQ_LEQ (Tcb->SackBlock[Index].Right, Start)) {
+      continue;
+    }
+
+    if (TCP_SEQ_LEQ (Tcb->SackBlock[Index].Left, Start)) {
+      Start = Tcb->SackBlock[Index].Right;
+      continue;
+    }
+
+    break;
+  }
+
+  if (Index < Tcb->SackBlockCount) {
+    if (!Force && !TcpSackIsLost (Tcb, Start)) {
+      return FALSE;
+    }
+
+    *End = Tcb->SackBlock[Index].Left;
+  } else {
+    //
+    // Nothing above Start has been SACKed. Only the first
+    // retransmission of the recovery is sent for such data.
+    //
+    if (!Force || !TCP_SEQ_LT (Start, Tcb->SndNxt)) {
+      return FALSE;
+    }
+
+    *End = Tcb->SndNxt;
+  }
+
+  if (TCP_SUB_SEQ (*End, Start) > Tcb->SndMss) {
+    *End = Start + Tcb->SndMss;
+  }
+
+  *Seq = Start;
+  return TRUE;
+}
+
+/**
+  Retransmit the next hole during the SACK based recovery, and advance HighRxt.
+
+  TcpRetransmit resends up to SndMss bytes from the start of the hole, which
+  may run into the SACKed range above a short hole. HighRxt is advanced past
+  all the data resent, so that the next hole starts above it.
+
+  @param[in, out]  Tcb      Pointer to the TCP_CB of this TCP instance.
+  @param[in]       Force    If TRUE, retransmit the next hole even if it isn't
+                            considered lost.
+
+  @retval TRUE              A hole is retransmitted.
+  @retval FALSE             There is no hole to retransmit, or the retransmission failed.
+
+**/
+BOOLEAN
+TcpSackRetransmit (
+  IN OUT TCP_CB   *Tcb,
+  IN     BOOLEAN  Force
+  )
+{
+  TCP_SEQNO  Seq;
+  TCP_SEQNO  End;
+
+  if (!TcpSackNextHole (Tcb, Force, &Seq, &End)) {
+    return FALSE;
+  }
+
+  DEBUG (
+    (DEBUG_NET,
+     "TcpSackRetransmit: retransmit the hole [%d, %d) for TCB %p\n",
+     Seq,
+     End,
+     Tcb)
+    );
+
+  if (TcpRetransmit (Tcb, Seq) != 0) {
+    return FALSE;
+  }
+
+  Tcb->HighRxt = Seq + MIN ((UINT32)Tcb->SndMss, TCP_SUB_SEQ (Tcb->SndNxt, Seq));
+  return TRUE;
+}
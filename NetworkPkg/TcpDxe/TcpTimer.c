@@ -199,6 +199,12 @@ TcpRexmitTimeout (
   Tcb->CWnd        = Tcb->SndMss;
   Tcb->LossRecover = Tcb->SndNxt;
 
+  //
+  // The peer may discard the data it has SACKed (RFC2018 section 8),
+  // forget the scoreboard and retransmit from SndUna.
+  //
+  Tcb->SackBlockCount = 0;
+
   Tcb->LossTimes++;
   if ((Tcb->LossTimes > Tcb->MaxRexmit) && !TCP_TIMER_ON (Tcb->EnabledTimer, TCP_TIMER_CONNECT)) {
     DEBUG (
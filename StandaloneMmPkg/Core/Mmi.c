@@ -25,6 +25,7 @@ typedef struct {
 
   EFI_GUID      HandlerType; // Type of interrupt
   LIST_ENTRY    MmiHandlers; // All handlers
+  LIST_ENTRY    HashLink;    // Link on the hash table bucket of HandlerType
 } MMI_ENTRY;
 
 #define MMI_HANDLER_SIGNATURE  SIGNATURE_32('m','m','i','h')
@@ -45,6 +46,47 @@ UINTN  mMmiManageCallingDepth = 0;
 LIST_ENTRY  mRootMmiHandlerList = INITIALIZE_LIST_HEAD_VARIABLE (mRootMmiHandlerList);
 LIST_ENTRY  mMmiEntryList       = INITIALIZE_LIST_HEAD_VARIABLE (mMmiEntryList);
 
+//
+// Non-root MMI entries are also hashed by HandlerType, so that MmiManage() does
+// not walk all entries for every MMI. The size must be a power of 2.
+//
+#define MMI_ENTRY_HASH_TABLE_SIZE  32
+
+LIST_ENTRY  mMmiEntryHashTable[MMI_ENTRY_HASH_TABLE_SIZE];
+
+/**
+  Return the bucket of mMmiEntryHashTable that holds the MMI entries of a handler type.
+
+  SmmCoreGetSmiEntryBucket() in MdeModulePkg/Core/PiSmmCore/Smi.c is the same function
+  for SMI entries. Keep the two in sync.
+
+  @param  HandlerType            The type of the interrupt
+
+  @return The list head of the bucket.
+
+**/
+STATIC
+LIST_ENTRY *
+MmCoreGetMmiEntryBucket (
+  IN CONST EFI_GUID  *HandlerType
+  )
+{
+  UINT32      Hash;
+  LIST_ENTRY  *Bucket;
+
+  Hash  = HandlerType->Data1 ^ (((UINT32)HandlerType->Data2 << 16) | HandlerType->Data3);
+  Hash ^= ReadUnaligned32 ((CONST UINT32 *)&HandlerType->Data4[0]) ^ ReadUnaligned32 ((CONST UINT32 *)&HandlerType->Data4[4]);
+  Hash ^= Hash >> 16;
+  Hash ^= Hash >> 8;
+
+  Bucket = &mMmiEntryHashTable[Hash & (MMI_ENTRY_HASH_TABLE_SIZE - 1)];
+  if (Bucket->ForwardLink == NULL) {
+    InitializeListHead (Bucket);
+  }
+
+  return Bucket;
+}
+
 /**
   Remove MmiHandler and free the memory it used.
   If MmiEntry is empty, remove MmiEntry and free the memory it used.
@@ -71,6 +113,7 @@ RemoveMmiHandler (
   if (MmiEntry != NULL) {
     if (IsListEmpty (&MmiEntry->MmiHandlers)) {
       RemoveEntryList (&MmiEntry->AllEntries);
+      RemoveEntryList (&MmiEntry->HashLink);
       FreePool (MmiEntry);
       return TRUE;
     }
@@ -95,19 +138,21 @@ MmCoreFindMmiEntry (
   IN BOOLEAN   Create
   )
 {
+  LIST_ENTRY  *Bucket;
   LIST_ENTRY  *Link;
   MMI_ENTRY   *Item;
   MMI_ENTRY   *MmiEntry;
 
   //
-  // Search the MMI entry list for the matching GUID
+  // Search the MMI entry hash table bucket for the matching GUID
   //
   MmiEntry = NULL;
-  for (Link = mMmiEntryList.ForwardLink;
-       Link != &mMmiEntryList;
+  Bucket   = MmCoreGetMmiEntryBucket (HandlerType);
+  for (Link = Bucket->ForwardLink;
+       Link != Bucket;
        Link = Link->ForwardLink)
   {
-    Item = CR (Link, MMI_ENTRY, AllEntries, MMI_ENTRY_SIGNATURE);
+    Item = CR (Link, MMI_ENTRY, HashLink, MMI_ENTRY_SIGNATURE);
     if (CompareGuid (&Item->HandlerType, HandlerType)) {
       //
       // This is the MMI entry
@@ -135,6 +180,7 @@ MmCoreFindMmiEntry (
       // Add it to MMI entry list
       //
       InsertTailList (&mMmiEntryList, &MmiEntry->AllEntries);
+      InsertTailList (Bucket, &MmiEntry->HashLink);
     }
   }
 
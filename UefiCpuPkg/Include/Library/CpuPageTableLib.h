@@ -117,6 +117,57 @@ typedef struct {
   IA32_MAP_ATTRIBUTE    Attribute;
 } IA32_MAP_ENTRY;
 
+typedef struct {
+  UINT64                LinearAddress;
+  UINT64                Length;
+  IA32_MAP_ATTRIBUTE    Attribute;
+  IA32_MAP_ATTRIBUTE    Mask;
+} IA32_MAP_REQUEST;
+
+/**
+  Create or update page table to map multiple linear address ranges with specified attributes.
+
+  The requests are applied in array order, so a later request overrides an earlier overlapping one.
+  Consecutive requests that are contiguous in both linear and physical address space and that have
+  the same attribute and mask are coalesced and mapped as one range, so that ranges supplied in small
+  pieces are still mapped with 2M/1G pages when alignment permits.
+
+  @param[in, out] PageTable      The pointer to the page table to update, or pointer to NULL if a new page table is to be created.
+                                 If not pointer to NULL, the value it points to won't be changed in this function.
+  @param[in]      PagingMode     The paging mode.
+  @param[in]      Buffer         The free buffer to be used for page table creation/updating.
+  @param[in, out] BufferSize     The buffer size.
+                                 On return, the remaining buffer size.
+                                 The free buffer is used from the end so caller can supply the same Buffer pointer with an updated
+                                 BufferSize in the second call to this API.
+                                 The required size is the sum of the sizes each coalesced range requires against the input page
+                                 table, which may exceed the size actually consumed when the ranges share new intermediate tables.
+  @param[in]      Requests       Array of map requests. Each LinearAddress and Length must be multiple of 4KB.
+  @param[in]      RequestCount   Number of entries in Requests.
+  @param[out]     IsModified     TRUE means page table is modified by software or hardware. FALSE means page table is not modified by software.
+
+  @retval RETURN_UNSUPPORTED        PagingMode is not supported.
+  @retval RETURN_INVALID_PARAMETER  PageTable or BufferSize is NULL, or Requests is NULL while RequestCount is not 0.
+  @retval RETURN_INVALID_PARAMETER  One of the requests is rejected by PageTableMap().
+  @retval RETURN_BUFFER_TOO_SMALL   The buffer is too small for page table creation/updating.
+                                    BufferSize is updated to indicate the expected buffer size.
+                                    Caller may still get RETURN_BUFFER_TOO_SMALL with the new BufferSize when the requests
+                                    overlap. In that case the requests before the failing one have been applied, and calling
+                                    again with the same requests gives the same final page table.
+  @retval RETURN_SUCCESS            PageTable is created/updated successfully or RequestCount is 0.
+**/
+RETURN_STATUS
+EFIAPI
+PageTableMapRequests (
+  IN OUT UINTN             *PageTable  OPTIONAL,
+  IN     PAGING_MODE       PagingMode,
+  IN     VOID              *Buffer,
+  IN OUT UINTN             *BufferSize,
+  IN     IA32_MAP_REQUEST  *Requests,
+  IN     UINTN             RequestCount,
+  OUT    BOOLEAN           *IsModified   OPTIONAL
+  );
+
 /**
   Parse page table.
 
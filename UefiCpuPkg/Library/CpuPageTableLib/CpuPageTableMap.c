@@ -648,42 +648,14 @@ PageTableLibMapInLevel (
 }
 
 /**
-  Create or update page table to map [LinearAddress, LinearAddress + Length) with specified attribute.
-
-  @param[in, out] PageTable      The pointer to the page table to update, or pointer to NULL if a new page table is to be created.
-                                 If not pointer to NULL, the value it points to won't be changed in this function.
-  @param[in]      PagingMode     The paging mode.
-  @param[in]      Buffer         The free buffer to be used for page table creation/updating.
-  @param[in, out] BufferSize     The buffer size.
-                                 On return, the remaining buffer size.
-                                 The free buffer is used from the end so caller can supply the same Buffer pointer with an updated
-                                 BufferSize in the second call to this API.
-  @param[in]      LinearAddress  The start of the linear address range.
-  @param[in]      Length         The length of the linear address range.
-  @param[in]      Attribute      The attribute of the linear address range.
-                                 All non-reserved fields in IA32_MAP_ATTRIBUTE are supported to set in the page table.
-                                 Page table entries that map the linear address range are reset to 0 before set to the new attribute
-                                 when a new physical base address is set.
-  @param[in]      Mask           The mask used for attribute. The corresponding field in Attribute is ignored if that in Mask is 0.
-  @param[out]     IsModified     TRUE means page table is modified by software or hardware. FALSE means page table is not modified by software.
-                                 If the output IsModified is FALSE, there is possibility that the page table is changed by hardware. It is ok
-                                 because page table can be changed by hardware anytime, and caller don't need to Flush TLB.
+  Worker of PageTableMap(); see PageTableMap() for the other parameters and the return values.
 
-  @retval RETURN_UNSUPPORTED        PagingMode is not supported.
-  @retval RETURN_INVALID_PARAMETER  PageTable, BufferSize, Attribute or Mask is NULL.
-  @retval RETURN_INVALID_PARAMETER  For non-present range, Mask->Bits.Present is 0 but some other attributes are provided.
-  @retval RETURN_INVALID_PARAMETER  For non-present range, Mask->Bits.Present is 1, Attribute->Bits.Present is 1 but some other attributes are not provided.
-  @retval RETURN_INVALID_PARAMETER  For non-present range, Mask->Bits.Present is 1, Attribute->Bits.Present is 0 but some other attributes are provided.
-  @retval RETURN_INVALID_PARAMETER  For present range, Mask->Bits.Present is 1, Attribute->Bits.Present is 0 but some other attributes are provided.
-  @retval RETURN_INVALID_PARAMETER  *BufferSize is not multiple of 4KB.
-  @retval RETURN_BUFFER_TOO_SMALL   The buffer is too small for page table creation/updating.
-                                    BufferSize is updated to indicate the expected buffer size.
-                                    Caller may still get RETURN_BUFFER_TOO_SMALL with the new BufferSize.
-  @retval RETURN_SUCCESS            PageTable is created/updated successfully or the input Length is 0.
+  @param[in]      QueryOnly      TRUE to only return the required buffer size in BufferSize, with RETURN_SUCCESS,
+                                 without modifying the page table.
 **/
+STATIC
 RETURN_STATUS
-EFIAPI
-PageTableMap (
+PageTableLibMap (
   IN OUT UINTN               *PageTable  OPTIONAL,
   IN     PAGING_MODE         PagingMode,
   IN     VOID                *Buffer,
@@ -692,7 +664,8 @@ PageTableMap (
   IN     UINT64              Length,
   IN     IA32_MAP_ATTRIBUTE  *Attribute,
   IN     IA32_MAP_ATTRIBUTE  *Mask,
-  OUT    BOOLEAN             *IsModified   OPTIONAL
+  OUT    BOOLEAN             *IsModified   OPTIONAL,
+  IN     BOOLEAN             QueryOnly
   )
 {
   RETURN_STATUS       Status;
@@ -821,6 +794,11 @@ PageTableMap (
 
   RequiredSize = -RequiredSize;
 
+  if (QueryOnly) {
+    *BufferSize = RequiredSize;
+    return RETURN_SUCCESS;
+  }
+
   if ((UINTN)RequiredSize > *BufferSize) {
     *BufferSize = RequiredSize;
     return RETURN_BUFFER_TOO_SMALL;
@@ -881,3 +859,241 @@ PageTableMap (
 
   return Status;
 }
+
+/**
+  Create or update page table to map [LinearAddress, LinearAddress + Length) with specified attribute.
+
+  @param[in, out] PageTable      The pointer to the page table to update, or pointer to NULL if a new page table is to be created.
+                                 If not pointer to NULL, the value it points to won't be changed in this function.
+  @param[in]      PagingMode     The paging mode.
+  @param[in]      Buffer         The free buffer to be used for page table creation/updating.
+  @param[in, out] BufferSize     The buffer size.
+                                 On return, the remaining buffer size.
+                                 The free buffer is used from the end so caller can supply the same Buffer pointer with an updated
+                                 BufferSize in the second call to this API.
+  @param[in]      LinearAddress  The start of the linear address range.
+  @param[in]      Length         The length of the linear address range.
+  @param[in]      Attribute      The attribute of the linear address range.
+                                 All non-reserved fields in IA32_MAP_ATTRIBUTE are supported to set in the page table.
+                                 Page table entries that map the linear address range are reset to 0 before set to the new attribute
+                                 when a new physical base address is set.
+  @param[in]      Mask           The mask used for attribute. The corresponding field in Attribute is ignored if that in Mask is 0.
+  @param[out]     IsModified     TRUE means page table is modified by software or hardware. FALSE means page table is not modified by software.
+                                 If the output IsModified is FALSE, there is possibility that the page table is changed by hardware. It is ok
+                                 because page table can be changed by hardware anytime, and caller don't need to Flush TLB.
+
+  @retval RETURN_UNSUPPORTED        PagingMode is not supported.
+  @retval RETURN_INVALID_PARAMETER  PageTable, BufferSize, Attribute or Mask is NULL.
+  @retval RETURN_INVALID_PARAMETER  For non-present range, Mask->Bits.Present is 0 but some other attributes are provided.
+  @retval RETURN_INVALID_PARAMETER  For non-present range, Mask->Bits.Present is 1, Attribute->Bits.Present is 1 but some other attributes are not provided.
+  @retval RETURN_INVALID_PARAMETER  For non-present range, Mask->Bits.Present is 1, Attribute->Bits.Present is 0 but some other attributes are provided.
+  @retval RETURN_INVALID_PARAMETER  For present range, Mask->Bits.Present is 1, Attribute->Bits.Present is 0 but some other attributes are provided.
+  @retval RETURN_INVALID_PARAMETER  *BufferSize is not multiple of 4KB.
+  @retval RETURN_BUFFER_TOO_SMALL   The buffer is too small for page table creation/updating.
+                                    BufferSize is updated to indicate the expected buffer size.
+                                    Caller may still get RETURN_BUFFER_TOO_SMALL with the new BufferSize.
+  @retval RETURN_SUCCESS            PageTable is created/updated successfully or the input Length is 0.
+**/
+RETURN_STATUS
+EFIAPI
+PageTableMap (
+  IN OUT UINTN               *PageTable  OPTIONAL,
+  IN     PAGING_MODE         PagingMode,
+  IN     VOID                *Buffer,
+  IN OUT UINTN               *BufferSize,
+  IN     UINT64              LinearAddress,
+  IN     UINT64              Length,
+  IN     IA32_MAP_ATTRIBUTE  *Attribute,
+  IN     IA32_MAP_ATTRIBUTE  *Mask,
+  OUT    BOOLEAN             *IsModified   OPTIONAL
+  )
+{
+  return PageTableLibMap (
+           PageTable,
+           PagingMode,
+           Buffer,
+           BufferSize,
+           LinearAddress,
+           Length,
+           Attribute,
+           Mask,
+           IsModified,
+           FALSE
+           );
+}
+
+/**
+  Coalesce the requests starting from Requests[*Index] into one range.
+
+  Consecutive requests are coalesced when they are contiguous in linear address space, have the
+  same mask and the same masked attributes, and, if the mask covers the physical address, are
+  contiguous in physical address space as well.
+
+  @param[in]      Requests      Array of map requests.
+  @param[in]      RequestCount  Number of entries in Requests.
+  @param[in, out] Index         On input, the index of the first request to coalesce.
+                                On output, the index of the first request not coalesced.
+  @param[out]     Range         Return the coalesced range.
+**/
+STATIC
+VOID
+PageTableLibCoalesceRequests (
+  IN     IA32_MAP_REQUEST  *Requests,
+  IN     UINTN             RequestCount,
+  IN OUT UINTN             *Index,
+  OUT    IA32_MAP_REQUEST  *Range
+  )
+{
+  IA32_MAP_REQUEST  *Next;
+  BOOLEAN           MapAddress;
+
+  CopyMem (Range, &Requests[*Index], sizeof (IA32_MAP_REQUEST));
+  MapAddress = (BOOLEAN)((Range->Mask.Bits.PageTableBaseAddressLow != 0) || (Range->Mask.Bits.PageTableBaseAddressHigh != 0));
+
+  for (*Index = *Index + 1; *Index < RequestCount; *Index = *Index + 1) {
+    Next = &Requests[*Index];
+    if ((Range->Length > MAX_UINT64 - Range->LinearAddress) ||
+        (Next->LinearAddress != Range->LinearAddress + Range->Length) ||
+        (Next->Length > MAX_UINT64 - Next->LinearAddress) ||
+        (Next->Mask.Uint64 != Range->Mask.Uint64))
+    {
+      break;
+    }
+
+    if (((IA32_MAP_ATTRIBUTE_ATTRIBUTES (&Next->Attribute) ^ IA32_MAP_ATTRIBUTE_ATTRIBUTES (&Range->Attribute)) &
+         IA32_MAP_ATTRIBUTE_ATTRIBUTES (&Range->Mask)) != 0)
+    {
+      break;
+    }
+
+    if (MapAddress &&
+        (IA32_MAP_ATTRIBUTE_PAGE_TABLE_BASE_ADDRESS (&Next->Attribute) !=
+         IA32_MAP_ATTRIBUTE_PAGE_TABLE_BASE_ADDRESS (&Range->Attribute) + Range->Length))
+    {
+      break;
+    }
+
+    Range->Length += Next->Length;
+  }
+}
+
+/**
+  Create or update page table to map multiple linear address ranges with specified attributes.
+
+  The requests are applied in array order, so a later request overrides an earlier overlapping one.
+  Consecutive requests that are contiguous in both linear and physical address space and that have
+  the same attribute and mask are coalesced and mapped as one range, so that ranges supplied in small
+  pieces are still mapped with 2M/1G pages when alignment permits.
+
+  @param[in, out] PageTable      The pointer to the page table to update, or pointer to NULL if a new page table is to be created.
+                                 If not pointer to NULL, the value it points to won't be changed in this function.
+  @param[in]      PagingMode     The paging mode.
+  @param[in]      Buffer         The free buffer to be used for page table creation/updating.
+  @param[in, out] BufferSize     The buffer size.
+                                 On return, the remaining buffer size.
+                                 The free buffer is used from the end so caller can supply the same Buffer pointer with an updated
+                                 BufferSize in the second call to this API.
+                                 The required size is the sum of the sizes each coalesced range requires against the input page
+                                 table, which may exceed the size actually consumed when the ranges share new intermediate tables.
+  @param[in]      Requests       Array of map requests. Each LinearAddress and Length must be multiple of 4KB.
+  @param[in]      RequestCount   Number of entries in Requests.
+  @param[out]     IsModified     TRUE means page table is modified by software or hardware. FALSE means page table is not modified by software.
+
+  @retval RETURN_UNSUPPORTED        PagingMode is not supported.
+  @retval RETURN_INVALID_PARAMETER  PageTable or BufferSize is NULL, or Requests is NULL while RequestCount is not 0.
+  @retval RETURN_INVALID_PARAMETER  One of the requests is rejected by PageTableMap().
+  @retval RETURN_BUFFER_TOO_SMALL   The buffer is too small for page table creation/updating.
+                                    BufferSize is updated to indicate the expected buffer size.
+                                    Caller may still get RETURN_BUFFER_TOO_SMALL with the new BufferSize when the requests
+                                    overlap. In that case the requests before the failing one have been applied, and calling
+                                    again with the same requests gives the same final page table.
+  @retval RETURN_SUCCESS            PageTable is created/updated successfully or RequestCount is 0.
+**/
+RETURN_STATUS
+EFIAPI
+PageTableMapRequests (
+  IN OUT UINTN             *PageTable  OPTIONAL,
+  IN     PAGING_MODE       PagingMode,
+  IN     VOID              *Buffer,
+  IN OUT UINTN             *BufferSize,
+  IN     IA32_MAP_REQUEST  *Requests,
+  IN     UINTN             RequestCount,
+  OUT    BOOLEAN           *IsModified   OPTIONAL
+  )
+{
+  RETURN_STATUS     Status;
+  IA32_MAP_REQUEST  Range;
+  UINTN             Index;
+  UINTN             RangeSize;
+  UINTN             RequiredSize;
+  BOOLEAN           RangeModified;
+  BOOLEAN           LocalIsModified;
+
+  if ((PageTable == NULL) || (BufferSize == NULL) || ((Requests == NULL) && (RequestCount != 0))) {
+    return RETURN_INVALID_PARAMETER;
+  }
+
+  if (IsModified == NULL) {
+    IsModified = &LocalIsModified;
+  }
+
+  *IsModified = FALSE;
+
+  //
+  // Query the required buffer size of all ranges without modifying the page table,
+  // so that the page table is left untouched when the buffer is too small.
+  //
+  RequiredSize = 0;
+  for (Index = 0; Index < RequestCount;) {
+    PageTableLibCoalesceRequests (Requests, RequestCount, &Index, &Range);
+    RangeSize = 0;
+    Status    = PageTableLibMap (
+                  PageTable,
+                  PagingMode,
+                  NULL,
+                  &RangeSize,
+                  Range.LinearAddress,
+                  Range.Length,
+                  &Range.Attribute,
+                  &Range.Mask,
+                  NULL,
+                  TRUE
+                  );
+    if (RETURN_ERROR (Status)) {
+      return Status;
+    }
+
+    RequiredSize += RangeSize;
+  }
+
+  if (RequiredSize > *BufferSize) {
+    *BufferSize = RequiredSize;
+    return RETURN_BUFFER_TOO_SMALL;
+  }
+
+  //
+  // Update the page table range by range when the supplied buffer is sufficient.
+  //
+  for (Index = 0; Index < RequestCount;) {
+    PageTableLibCoalesceRequests (Requests, RequestCount, &Index, &Range);
+    RangeModified = FALSE;
+    Status        = PageTableLibMap (
+                      PageTable,
+                      PagingMode,
+                      Buffer,
+                      BufferSize,
+                      Range.LinearAddress,
+                      Range.Length,
+                      &Range.Attribute,
+                      &Range.Mask,
+                      &RangeModified,
+                      FALSE
+                      );
+    *IsModified = (BOOLEAN)(*IsModified || RangeModified);
+    if (RETURN_ERROR (Status)) {
+      return Status;
+    }
+  }
+
+  return RETURN_SUCCESS;
+}
@@ -821,6 +821,131 @@ TestCaseToCheckMapMaskAndAttr (
   return UNIT_TEST_PASSED;
 }
 
+/**
+  Check that PageTableMapRequests() coalesces contiguous requests into large pages,
+  and applies overlapping requests in array order.
+
+  @param[in]  Context    [Optional] An optional parameter that enables:
+                         1) test-case reuse with varied parameters and
+                         2) test-case re-entry for Target tests that need a
+                         reboot.  This parameter is a VOID* and it is the
+                         responsibility of the test author to ensure that the
+                         contents are well understood by all test cases that may
+                         consume it.
+
+  @retval  UNIT_TEST_PASSED             The Unit test has completed and the test
+                                        case was successful.
+  @retval  UNIT_TEST_ERROR_TEST_FAILED  A test case assertion has failed.
+**/
+UNIT_TEST_STATUS
+EFIAPI
+TestCaseManualMapRequests (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  UINTN               PageTable;
+  PAGING_MODE         PagingMode;
+  VOID                *Buffer;
+  UINTN               BufferPages;
+  VOID                *SplitBuffer;
+  UINTN               SplitBufferPages;
+  UINTN               PageTableBufferSize;
+  IA32_MAP_REQUEST    *Requests;
+  UINTN               RequestCount;
+  IA32_MAP_ATTRIBUTE  ExpectedMapAttribute;
+  RETURN_STATUS       Status;
+  IA32_MAP_ENTRY      *Map;
+  UINTN               MapCount;
+  UINTN               Index;
+  BOOLEAN             IsModified;
+
+  PagingMode          = Paging4Level;
+  PageTableBufferSize = 0;
+  PageTable           = 0;
+  Buffer              = NULL;
+
+  //
+  // Describe [0, 4M] as 1024 one-to-one 4K requests with ReadWrite = 1.
+  //
+  RequestCount = SIZE_4MB / SIZE_4KB;
+  Requests     = AllocatePages (EFI_SIZE_TO_PAGES (RequestCount * sizeof (IA32_MAP_REQUEST)));
+  UT_ASSERT_NOT_EQUAL (Requests, NULL);
+  for (Index = 0; Index < RequestCount; Index++) {
+    Requests[Index].LinearAddress            = Index * SIZE_4KB;
+    Requests[Index].Length                   = SIZE_4KB;
+    Requests[Index].Attribute.Uint64         = Index * SIZE_4KB;
+    Requests[Index].Attribute.Bits.Present   = 1;
+    Requests[Index].Attribute.Bits.ReadWrite = 1;
+    Requests[Index].Mask.Uint64              = MAX_UINT64;
+  }
+
+  //
+  // The requests are coalesced to one range mapped by two 2M pages,
+  // so only PML4, PDPT and PD are needed.
+  //
+  Status = PageTableMapRequests (&PageTable, PagingMode, Buffer, &PageTableBufferSize, Requests, RequestCount, NULL);
+  UT_ASSERT_EQUAL (Status, RETURN_BUFFER_TOO_SMALL);
+  UT_ASSERT_EQUAL (PageTableBufferSize, 3 * SIZE_4KB);
+  BufferPages = EFI_SIZE_TO_PAGES (PageTableBufferSize);
+  Buffer      = AllocatePages (BufferPages);
+  Status = PageTableMapRequests (&PageTable, PagingMode, Buffer, &PageTableBufferSize, Requests, RequestCount, &IsModified);
+  UT_ASSERT_EQUAL (Status, RETURN_SUCCESS);
+  UT_ASSERT_EQUAL (PageTableBufferSize, 0);
+  UT_ASSERT_EQUAL (IsModified, TRUE);
+  IsPageTableValid (PageTable, PagingMode);
+
+  //
+  // Set [2M, 2M + 4K] to ReadWrite = 0 and then back to ReadWrite = 1.
+  // The later request wins, so the map is unchanged.
+  //
+  Requests[0].LinearAddress            = SIZE_2MB;
+  Requests[0].Length                   = SIZE_4KB;
+  Requests[0].Attribute.Uint64         = SIZE_2MB;
+  Requests[0].Attribute.Bits.Present   = 1;
+  Requests[0].Attribute.Bits.ReadWrite = 0;
+  Requests[0].Mask.Uint64              = 0;
+  Requests[0].Mask.Bits.ReadWrite      = 1;
+  CopyMem (&Requests[1], &Requests[0], sizeof (IA32_MAP_REQUEST));
+  Requests[1].Attribute.Bits.ReadWrite = 1;
+
+  PageTableBufferSize = 0;
+  Status              = PageTableMapRequests (&PageTable, PagingMode, NULL, &PageTableBufferSize, Requests, 2, NULL);
+  UT_ASSERT_EQUAL (Status, RETURN_BUFFER_TOO_SMALL);
+  SplitBufferPages = EFI_SIZE_TO_PAGES (PageTableBufferSize);
+  SplitBuffer      = AllocatePages (SplitBufferPages);
+  Status           = PageTableMapRequests (&PageTable, PagingMode, SplitBuffer, &PageTableBufferSize, Requests, 2, NULL);
+  UT_ASSERT_EQUAL (Status, RETURN_SUCCESS);
+  IsPageTableValid (PageTable, PagingMode);
+
+  MapCount = 0;
+  Status   = PageTableParse (PageTable, PagingMode, NULL, &MapCount);
+  UT_ASSERT_EQUAL (Status, RETURN_BUFFER_TOO_SMALL);
+  Map    = AllocatePages (EFI_SIZE_TO_PAGES (MapCount * sizeof (IA32_MAP_ENTRY)));
+  Status = PageTableParse (PageTable, PagingMode, Map, &MapCount);
+  UT_ASSERT_EQUAL (Status, RETURN_SUCCESS);
+  UT_ASSERT_EQUAL (MapCount, 1);
+  UT_ASSERT_EQUAL (Map[0].LinearAddress, 0);
+  UT_ASSERT_EQUAL (Map[0].Length, SIZE_4MB);
+  ExpectedMapAttribute.Uint64         = 0;
+  ExpectedMapAttribute.Bits.Present   = 1;
+  ExpectedMapAttribute.Bits.ReadWrite = 1;
+  UT_ASSERT_EQUAL (Map[0].Attribute.Uint64, ExpectedMapAttribute.Uint64);
+
+  //
+  // A zero request count doesn't touch the page table.
+  //
+  PageTableBufferSize = 0;
+  Status              = PageTableMapRequests (&PageTable, PagingMode, NULL, &PageTableBufferSize, NULL, 0, &IsModified);
+  UT_ASSERT_EQUAL (Status, RETURN_SUCCESS);
+  UT_ASSERT_EQUAL (IsModified, FALSE);
+
+  FreePages (Map, EFI_SIZE_TO_PAGES (MapCount * sizeof (IA32_MAP_ENTRY)));
+  FreePages (Requests, EFI_SIZE_TO_PAGES (RequestCount * sizeof (IA32_MAP_REQUEST)));
+  FreePages (SplitBuffer, SplitBufferPages);
+  FreePages (Buffer, BufferPages);
+  return UNIT_TEST_PASSED;
+}
+
 /**
   Initialize the unit test framework, suite, and unit tests for the
   sample unit tests and run the unit tests.
@@ -872,6 +997,7 @@ UefiTestMain (
   AddTestCase (ManualTestCase, "Check if the parent entry has different Nx attribute", "Manual Test Case6", TestCaseManualChangeNx, NULL, NULL, NULL);
   AddTestCase (ManualTestCase, "Check if the needed size is expected", "Manual Test Case7", TestCaseManualSizeNotMatch, NULL, NULL, NULL);
   AddTestCase (ManualTestCase, "Check MapMask when creating new page table or mapping not-present range", "Manual Test Case8", TestCaseToCheckMapMaskAndAttr, NULL, NULL, NULL);
+  AddTestCase (ManualTestCase, "Check PageTableMapRequests coalesces and orders requests", "Manual Test Case9", TestCaseManualMapRequests, NULL, NULL, NULL);
   //
   // Populate the Random Test Cases.
   //
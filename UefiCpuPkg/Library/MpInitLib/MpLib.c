@@ -484,6 +484,8 @@ GetProcessorNumber (
 {
   UINTN            TotalProcessorNumber;
   UINTN            Index;
+  UINTN            Low;
+  UINTN            High;
   CPU_INFO_IN_HOB  *CpuInfoInHob;
   UINT32           CurrentApicId;
 
@@ -491,6 +493,32 @@ GetProcessorNumber (
 
   TotalProcessorNumber = CpuMpData->CpuCount;
   CurrentApicId        = GetApicId ();
+
+  //
+  // SortApicId() leaves CpuInfoInHob in ascending APIC ID order, so try a
+  // binary search first. Every AP calls this on each wakeup, and a linear
+  // search makes the total cost quadratic in the processor count.
+  //
+  Low  = 0;
+  High = TotalProcessorNumber;
+  while (Low < High) {
+    Index = Low + (High - Low) / 2;
+    if (CpuInfoInHob[Index].ApicId == CurrentApicId) {
+      *ProcessorNumber = Index;
+      return EFI_SUCCESS;
+    }
+
+    if (CpuInfoInHob[Index].ApicId < CurrentApicId) {
+      Low = Index + 1;
+    } else {
+      High = Index;
+    }
+  }
+
+  //
+  // APIC IDs may be re-read after sorting (e.g. after an APIC mode change),
+  // so fall back to a linear search when the binary search misses.
+  //
   for (Index = 0; Index < TotalProcessorNumber; Index++) {
     if (CpuInfoInHob[Index].ApicId == CurrentApicId) {
       *ProcessorNumber = Index;
@@ -2268,7 +2296,9 @@ MpInitLibInitialize (
       //
       // Wakeup all APs and calculate the processor count in system
       //
+      PERF_INMODULE_BEGIN ("MpInitCollectProcessorCount");
       CollectProcessorCount (CpuMpData);
+      PERF_INMODULE_END ("MpInitCollectProcessorCount");
 
       //
       // Enable X2APIC if needed.
@@ -2280,7 +2310,9 @@ MpInitLibInitialize (
       //
       // Sort BSP/Aps by CPU APIC ID in ascending order
       //
+      PERF_INMODULE_BEGIN ("MpInitSortApicId");
       SortApicId (CpuMpData);
+      PERF_INMODULE_END ("MpInitSortApicId");
 
       DEBUG ((DEBUG_INFO, "MpInitLib: Find %d processors in system.\n", CpuMpData->CpuCount));
     }
@@ -2389,7 +2421,9 @@ MpInitLibInitialize (
   //
   // Detect and apply Microcode on BSP
   //
+  PERF_INMODULE_BEGIN ("MpInitBspMicrocode");
   MicrocodeDetect (CpuMpData, CpuMpData->BspNumber);
+  PERF_INMODULE_END ("MpInitBspMicrocode");
   //
   // Store BSP's MTRR setting
   //
@@ -2399,6 +2433,7 @@ MpInitLibInitialize (
   // Wakeup APs to do some AP initialize sync (Microcode & MTRR)
   //
   if (CpuMpData->CpuCount > 1) {
+    PERF_INMODULE_BEGIN ("MpInitApInitializeSync");
     WakeUpAP (CpuMpData, TRUE, 0, ApInitializeSync, CpuMpData, TRUE);
     //
     // Wait for all APs finished initialization
@@ -2407,6 +2442,8 @@ MpInitLibInitialize (
       CpuPause ();
     }
 
+    PERF_INMODULE_END ("MpInitApInitializeSync");
+
     for (Index = 0; Index < CpuMpData->CpuCount; Index++) {
       SetApState (&CpuMpData->CpuData[Index], CpuStateIdle);
     }
@@ -1181,12 +1181,29 @@ MtrrLibGetNumberOfTypes (
   )
 {
   UINTN  Index;
+  UINTN  Low;
+  UINTN  High;
   UINT8  TypeCount;
   UINT8  LocalTypes;
 
+  //
+  // Ranges are sorted and don't overlap, so binary search the first range that ends above BaseAddress.
+  // It avoids scanning all preceding ranges because this function is called for every vertex pair.
+  //
+  Low  = 0;
+  High = RangeCount;
+  while (Low < High) {
+    Index = Low + (High - Low) / 2;
+    if (Ranges[Index].BaseAddress + Ranges[Index].Length <= BaseAddress) {
+      Low = Index + 1;
+    } else {
+      High = Index;
+    }
+  }
+
   TypeCount  = 0;
   LocalTypes = 0;
-  for (Index = 0; Index < RangeCount; Index++) {
+  for (Index = Low; Index < RangeCount; Index++) {
     if ((Ranges[Index].BaseAddress <= BaseAddress) &&
         (BaseAddress < Ranges[Index].BaseAddress + Ranges[Index].Length)
         )
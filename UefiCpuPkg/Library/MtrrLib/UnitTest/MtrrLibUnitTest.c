@@ -1202,6 +1202,123 @@ RestorePcdValue (
   PatchPcdSet32 (PcdCpuNumberOfReservedVariableMtrrs, LocalContext->NumberOfReservedVariableMtrrs);
 }
 
+/**
+  Measure the time per call of MtrrSetMemoryAttributesInMtrrSettings() and
+  MtrrSetMemoryAttributeInMtrrSettings() using the same random memory layouts
+  as the unit tests.
+
+  For each system parameter, the whole layout is applied to empty MTRR settings
+  with one MtrrSetMemoryAttributesInMtrrSettings() call, and then range by range
+  with MtrrSetMemoryAttributeInMtrrSettings() calls.
+
+  @param Iteration  Number of random memory layouts per system parameter.
+**/
+STATIC
+VOID
+BenchmarkMtrrSetMemoryAttributesInMtrrSettings (
+  UINTN  Iteration
+  )
+{
+  UINTN              SystemIndex;
+  UINTN              Index;
+  UINTN              RangeIndex;
+  RETURN_STATUS      Status;
+  UINT32             UcCount;
+  UINT32             WtCount;
+  UINT32             WbCount;
+  UINT32             WpCount;
+  UINT32             WcCount;
+  UINT8              Scratch[SCRATCH_BUFFER_SIZE];
+  UINTN              ScratchSize;
+  MTRR_SETTINGS      LocalMtrrs;
+  MTRR_MEMORY_RANGE  RawMtrrRange[MTRR_NUMBER_OF_VARIABLE_MTRR];
+  MTRR_MEMORY_RANGE  ExpectedMemoryRanges[MTRR_NUMBER_OF_FIXED_MTRR * sizeof (UINT64) + 2 * MTRR_NUMBER_OF_VARIABLE_MTRR + 1];
+  UINTN              ExpectedMemoryRangesCount;
+  UINTN              BatchCalls;
+  UINTN              SingleCalls;
+  clock_t            Start;
+  clock_t            BatchTicks;
+  clock_t            SingleTicks;
+
+  MTRR_LIB_SYSTEM_PARAMETER  *SystemParameter;
+
+  for (SystemIndex = 0; SystemIndex < ARRAY_SIZE (mSystemParameters); SystemIndex++) {
+    SystemParameter = &mSystemParameters[SystemIndex];
+    InitializeMtrrRegs (SystemParameter);
+
+    BatchCalls  = 0;
+    SingleCalls = 0;
+    BatchTicks  = 0;
+    SingleTicks = 0;
+    for (Index = 0; Index < Iteration; Index++) {
+      GenerateRandomMemoryTypeCombination (
+        SystemParameter->VariableMtrrCount - PatchPcdGet32 (PcdCpuNumberOfReservedVariableMtrrs),
+        &UcCount,
+        &WtCount,
+        &WbCount,
+        &WpCount,
+        &WcCount
+        );
+      GenerateValidAndConfigurableMtrrPairs (
+        SystemParameter->PhysicalAddressBits - SystemParameter->MkTmeKeyidBits,
+        RawMtrrRange,
+        UcCount,
+        WtCount,
+        WbCount,
+        WpCount,
+        WcCount
+        );
+      ExpectedMemoryRangesCount = ARRAY_SIZE (ExpectedMemoryRanges);
+      GetEffectiveMemoryRanges (
+        SystemParameter->DefaultCacheType,
+        SystemParameter->PhysicalAddressBits - SystemParameter->MkTmeKeyidBits,
+        RawMtrrRange,
+        UcCount + WtCount + WbCount + WpCount + WcCount,
+        ExpectedMemoryRanges,
+        &ExpectedMemoryRangesCount
+        );
+
+      ZeroMem (&LocalMtrrs, sizeof (LocalMtrrs));
+      LocalMtrrs.MtrrDefType = MtrrGetDefaultMemoryType ();
+      ScratchSize            = sizeof (Scratch);
+      Start                  = clock ();
+      Status                 = MtrrSetMemoryAttributesInMtrrSettings (&LocalMtrrs, Scratch, &ScratchSize, ExpectedMemoryRanges, ExpectedMemoryRangesCount);
+      BatchTicks            += clock () - Start;
+      BatchCalls++;
+      if (RETURN_ERROR (Status)) {
+        DEBUG ((DEBUG_ERROR, "MtrrSetMemoryAttributesInMtrrSettings() returns %r\n", Status));
+      }
+
+      ZeroMem (&LocalMtrrs, sizeof (LocalMtrrs));
+      LocalMtrrs.MtrrDefType = MtrrGetDefaultMemoryType ();
+      for (RangeIndex = 0; RangeIndex < ExpectedMemoryRangesCount; RangeIndex++) {
+        Start        = clock ();
+        Status       = MtrrSetMemoryAttributeInMtrrSettings (
+                         &LocalMtrrs,
+                         ExpectedMemoryRanges[RangeIndex].BaseAddress,
+                         ExpectedMemoryRanges[RangeIndex].Length,
+                         ExpectedMemoryRanges[RangeIndex].Type
+                         );
+        SingleTicks += clock () - Start;
+        SingleCalls++;
+      }
+    }
+
+    DEBUG ((
+      DEBUG_INFO,
+      "System[%02d] AddressBits=%d VariableMtrr=%d DefaultType=%d: Batch %d calls, %d us/call; Single %d calls, %d us/call\n",
+      SystemIndex,
+      SystemParameter->PhysicalAddressBits,
+      SystemParameter->VariableMtrrCount,
+      SystemParameter->DefaultCacheType,
+      BatchCalls,
+      (BatchCalls == 0) ? 0 : (UINTN)(((UINT64)BatchTicks * 1000000 / CLOCKS_PER_SEC) / BatchCalls),
+      SingleCalls,
+      (SingleCalls == 0) ? 0 : (UINTN)(((UINT64)SingleTicks * 1000000 / CLOCKS_PER_SEC) / SingleCalls)
+      ));
+  }
+}
+
 /**
   Initialize the unit test framework, suite, and unit tests for the
   ResetSystemLib and run the ResetSystemLib unit test.
@@ -1316,6 +1433,18 @@ main (
     return 0;
   }
 
+  //
+  // MtrrLibUnitTest benchmark <iterations> [fixed|random]
+  //   Measure the time per call on the random memory layouts instead of running the tests.
+  //
+  if (((Argc == 3) || (Argc == 4)) && (AsciiStriCmp ("benchmark", Argv[1]) == 0)) {
+    Count        = atoi (Argv[2]);
+    mRandomInput = (BOOLEAN)((Argc == 4) && (AsciiStriCmp ("random", Argv[3]) == 0));
+    DEBUG ((DEBUG_INFO, "Benchmark iterations = %d, input = %a\n", Count, mRandomInput ? "random" : "fixed"));
+    BenchmarkMtrrSetMemoryAttributesInMtrrSettings (Count);
+    return 0;
+  }
+
   //
   // MtrrLibUnitTest [<iterations>]
   //                 <iterations> [fixed|random]
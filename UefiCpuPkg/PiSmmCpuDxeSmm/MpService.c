@@ -626,6 +626,8 @@ BSPHandler (
       if (PresentCount > ApCount) {
         break;
       }
+
+      CpuPause ();
     }
   }
 
@@ -804,6 +806,10 @@ APHandler (
   BspIndex = mSmmMpSyncData->BspIndex;
   ASSERT (CpuIndex != BspIndex);
 
+  PERF_CODE (
+    MpPerfBegin (CpuIndex, SMM_MP_PERF_PROCEDURE_ID (ApHandler));
+    );
+
   //
   // Mark this processor's presence
   //
@@ -930,6 +936,14 @@ APHandler (
   //
   *(mSmmMpSyncData->CpuData[CpuIndex].Present) = FALSE;
 
+  //
+  // BSP migrates the SMM MP performance logging once all APs signal #11,
+  // so the end of this handler is recorded before it.
+  //
+  PERF_CODE (
+    MpPerfEnd (CpuIndex, SMM_MP_PERF_PROCEDURE_ID (ApHandler));
+    );
+
   //
   // Notify BSP the readiness of this AP to exit SMM
   //
@@ -17,6 +17,7 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
   _(InitializeSmm), \
   _(SmmRendezvousEntry), \
   _(PlatformValidSmi), \
+  _(ApHandler), \
   _(SmmRendezvousExit), \
   _(SmmMpProcedureMax) // Add new entries above this line
 